@@ -0,0 +1,231 @@
+/*!
+ * \file bench-build.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Benchmark of the bulk build of integer keyed heaps
+ *
+ * \details An array of N random 32 bit integers is turned into a heap with
+ *      min_heap_api_build, using a compare callback, a key specification
+ *      with the scalar code and a key specification whose bottom level is
+ *      vectorized with AVX2 (when the CPU supports it), and with the radix
+ *      sort of min_heap_api_build_radix.
+ *      The copy of the input is included in the measured time since it is
+ *      part of every build. The time of the following removals of the minimum
+ *      is reported as well, since a sorted heap makes them cheaper.
+ *
+ *      Usage: bench-build [-r repetitions] [-n max items] [-j output.json]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench-common.h"
+#include "bench-perf.h"
+#include "min-heap-api.h"
+
+/*! \brief Number of removals of the minimum timed after each build */
+#define BENCH_BUILD_POPS (65536U)
+
+/*! \brief Default maximum number of items */
+#define BENCH_BUILD_DEFAULT_MAX (16777216U)
+
+#define BENCH_ARRAY_LEN(A) (sizeof(A) / sizeof((A)[0]))
+
+/*! \brief Numbers of items tested */
+static const size_t bench_sizes[] = { 1024U, 65536U, 1048576U, 16777216U, 104857600U };
+
+int8_t bench_compare_int(void *a, void *b) {
+    int32_t f = *(int32_t *)a;
+    int32_t s = *(int32_t *)b;
+    if (f < s)
+        return -1;
+    return f == s ? 0 : 1;
+}
+
+static MinHeapReturnCode bench_callback_init(MinHeapHandler_t *heap, size_t capacity, ArenaAllocatorHandler_t *arena) {
+    return min_heap_api_init(heap, sizeof(int32_t), capacity, bench_compare_int, arena);
+}
+
+static MinHeapReturnCode bench_keyspec_init(MinHeapHandler_t *heap, size_t capacity, ArenaAllocatorHandler_t *arena) {
+    static const MinHeapKeyField_t key = { 0, MIN_HEAP_KEY_I32, MIN_HEAP_KEY_ASC };
+    return min_heap_api_init_keys(heap, sizeof(int32_t), capacity, &key, 1, arena);
+}
+
+static MinHeapReturnCode bench_scalar_init(MinHeapHandler_t *heap, size_t capacity, ArenaAllocatorHandler_t *arena) {
+    MinHeapReturnCode res = bench_keyspec_init(heap, capacity, arena);
+    if (res != MIN_HEAP_OK)
+        return res;
+    return min_heap_api_set_simd(heap, false);
+}
+
+/*! \brief Scratch buffer of the radix sort, allocated in the arena of the run */
+static void *bench_scratch = NULL;
+
+static MinHeapReturnCode bench_radix_init(MinHeapHandler_t *heap, size_t capacity, ArenaAllocatorHandler_t *arena) {
+    bench_scratch = arena_allocator_api_calloc(arena, sizeof(int32_t), capacity);
+    if (bench_scratch == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    // Touch the pages so that their first mapping is not measured
+    memset(bench_scratch, 0xFF, capacity * sizeof(int32_t));
+    return bench_keyspec_init(heap, capacity, arena);
+}
+
+static MinHeapReturnCode bench_radix_build(MinHeapHandler_t *heap, void *items, size_t count) {
+    return min_heap_api_build_radix(heap, items, count, bench_scratch);
+}
+
+/*!
+ * \brief Build strategy under test
+ */
+typedef struct {
+    const char *name;
+    MinHeapReturnCode (*init)(MinHeapHandler_t *heap, size_t capacity, ArenaAllocatorHandler_t *arena);
+    MinHeapReturnCode (*build)(MinHeapHandler_t *heap, void *items, size_t count);
+} BenchEngine_t;
+
+static const BenchEngine_t bench_engines[] = {
+    { "callback", bench_callback_init, min_heap_api_build },
+    { "keyspec-scalar", bench_scalar_init, min_heap_api_build },
+    { "keyspec-avx2", bench_keyspec_init, min_heap_api_build },
+    { "radix", bench_radix_init, bench_radix_build },
+};
+
+/*!
+ * \brief Run a single build followed by some removals of the minimum
+ *
+ * \param pop_ns Where to store the time per removal in ns
+ * \return double The time per item of the build in ns, or a negative value on error
+ */
+static double bench_build_run(const BenchEngine_t *engine,
+                              const int32_t *items,
+                              size_t n,
+                              BenchPerf_t *perf,
+                              double *counters,
+                              double *pop_ns) {
+    ArenaAllocatorHandler_t arena;
+    MinHeapHandler_t heap;
+    double elapsed = -1.0;
+
+    arena_allocator_api_init(&arena);
+    if (engine->init(&heap, n, &arena) != MIN_HEAP_OK)
+        goto cleanup;
+
+    bench_perf_start(perf);
+    uint64_t start = bench_now_ns();
+    MinHeapReturnCode res = engine->build(&heap, (void *)items, n);
+    uint64_t stop = bench_now_ns();
+    bench_perf_stop(perf);
+    if (res != MIN_HEAP_OK)
+        goto cleanup;
+
+    elapsed = (double)(stop - start) / n;
+    bench_perf_per_op(perf, n, counters);
+
+    size_t pops = n < BENCH_BUILD_POPS ? n : BENCH_BUILD_POPS;
+    start = bench_now_ns();
+    for (size_t i = 0; i < pops; ++i)
+        min_heap_api_remove(&heap, 0, NULL);
+    *pop_ns = (double)(bench_now_ns() - start) / pops;
+
+cleanup:
+    arena_allocator_api_free(&arena);
+    return elapsed;
+}
+
+int main(int argc, char **argv) {
+    size_t reps = 5U;
+    size_t max_items = BENCH_BUILD_DEFAULT_MAX;
+    const char *json_path = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "r:n:j:")) != -1) {
+        switch (opt) {
+            case 'r':
+                reps = strtoul(optarg, NULL, 10);
+                break;
+            case 'n':
+                max_items = strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                json_path = optarg;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-r repetitions] [-n max items] [-j output.json]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (reps == 0 || reps > BENCH_MAX_SAMPLES || max_items == 0) {
+        fprintf(stderr, "[ERROR]: Repetitions must be in [1, %u] and max items greater than 0\n", BENCH_MAX_SAMPLES);
+        return EXIT_FAILURE;
+    }
+
+    int32_t *items = malloc(max_items * sizeof(int32_t));
+    if (items == NULL) {
+        fprintf(stderr, "[ERROR]: Cannot allocate the items buffer\n");
+        return EXIT_FAILURE;
+    }
+    BenchRng_t rng;
+    bench_rng_seed(&rng, 0xC0FFEEULL);
+    for (size_t i = 0; i < max_items; ++i)
+        items[i] = (int32_t)(uint32_t)bench_rng_next(&rng);
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(MIN_HEAP_NO_SIMD)
+    if (!__builtin_cpu_supports("avx2"))
+        fprintf(stderr, "[WARNING]: The CPU does not support AVX2, keyspec-avx2 runs the scalar code\n");
+#else
+    fprintf(stderr, "[WARNING]: AVX2 is not compiled in, keyspec-avx2 runs the scalar code\n");
+#endif
+
+    BenchPerf_t perf;
+    if (bench_perf_open(&perf) == 0)
+        fprintf(stderr, "[WARNING]: Hardware counters are not available, only the time is measured\n");
+
+    BenchReport_t report;
+    if (!bench_report_open(&report, "build", json_path)) {
+        fprintf(stderr, "[ERROR]: Cannot open %s\n", json_path);
+        bench_perf_close(&perf);
+        free(items);
+        return EXIT_FAILURE;
+    }
+
+    for (size_t s = 0; s < BENCH_ARRAY_LEN(bench_sizes) && bench_sizes[s] <= max_items; ++s) {
+        for (size_t e = 0; e < BENCH_ARRAY_LEN(bench_engines); ++e) {
+            double samples[BENCH_MAX_SAMPLES];
+            double pop_samples[BENCH_MAX_SAMPLES];
+            double counters[BENCH_PERF_COUNT][BENCH_MAX_SAMPLES];
+            size_t counter_count[BENCH_PERF_COUNT] = { 0 };
+            size_t count = 0;
+            for (size_t r = 0; r < reps; ++r) {
+                double per_item[BENCH_PERF_COUNT];
+                double ns = bench_build_run(&bench_engines[e], items, bench_sizes[s], &perf, per_item, &pop_samples[count]);
+                if (ns < 0.0)
+                    continue;
+                for (size_t p = 0; p < BENCH_PERF_COUNT; ++p) {
+                    if (per_item[p] >= 0.0)
+                        counters[p][counter_count[p]++] = per_item[p];
+                }
+                samples[count++] = ns;
+            }
+
+            char name[128];
+            snprintf(name, sizeof(name), "%s/N=%zu", bench_engines[e].name, bench_sizes[s]);
+            if (count == 0)
+                fprintf(stderr, "[ERROR]: Cannot run %s\n", name);
+            bench_report_case(&report, name, "ns/item", samples, count);
+            bench_perf_report(&report, &perf, name, "ev/item", counters, counter_count, count);
+            snprintf(name, sizeof(name), "%s/pop/N=%zu", bench_engines[e].name, bench_sizes[s]);
+            bench_report_case(&report, name, "ns/op", pop_samples, count);
+        }
+    }
+
+    bench_report_close(&report);
+    bench_perf_close(&perf);
+    free(items);
+    return EXIT_SUCCESS;
+}
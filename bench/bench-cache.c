@@ -0,0 +1,368 @@
+/*!
+ * \file bench-cache.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Miss rate benchmark of the cache with cost-aware eviction against
+ *      an LRU baseline
+ *
+ * \details The keys are requested with a Zipf distribution (s = 0.9) over
+ *      BENCH_CACHE_KEYS keys, optionally mixed with scans of keys that are
+ *      requested only once. One key every ten is expensive (cost 100), the
+ *      others cost 1. On a miss the key is inserted in the cache. The miss rate,
+ *      the cost of the misses per request and the time per request are
+ *      reported for each policy and for caches of 1% and 10% of the keys.
+ *
+ *      Usage: bench-cache [-r repetitions] [-s requests] [-j output.json]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench-common.h"
+#include "min-heap-cache-api.h"
+
+/*! \brief Default number of requests of a single repetition */
+#define BENCH_CACHE_DEFAULT_REQUESTS (2000000U)
+
+/*! \brief Number of distinct keys of the Zipf distribution */
+#define BENCH_CACHE_KEYS (100000U)
+
+/*! \brief Exponent of the Zipf distribution */
+#define BENCH_CACHE_ZIPF (0.9)
+
+/*! \brief Length of a scan, started on average once every BENCH_CACHE_SCAN_PERIOD requests */
+#define BENCH_CACHE_SCAN_LENGTH (2000U)
+#define BENCH_CACHE_SCAN_PERIOD (20000U)
+
+/*! \brief Value of an empty bucket of the LRU hash map */
+#define BENCH_LRU_EMPTY (UINT32_MAX)
+
+#define BENCH_ARRAY_LEN(A) (sizeof(A) / sizeof((A)[0]))
+
+/*! \brief Policy of the LRU baseline, not a policy of the library */
+#define BENCH_CACHE_LRU (-1)
+
+static const struct {
+    const char *name;
+    int policy;
+} bench_policies[] = {
+    { "lru", BENCH_CACHE_LRU },
+    { "lfu", MIN_HEAP_CACHE_LFU },
+    { "gd", MIN_HEAP_CACHE_GREEDY_DUAL },
+    { "gdf", MIN_HEAP_CACHE_GREEDY_DUAL_FREQUENCY },
+};
+
+static const struct {
+    const char *name;
+    bool scans;
+} bench_workloads[] = {
+    { "zipf", false },
+    { "zipf+scan", true },
+};
+
+/*! \brief Capacities of the cache in per mille of the keys */
+static const size_t bench_capacities[] = { 10U, 100U };
+
+/*!
+ * \brief Least recently used cache, an intrusive doubly linked list plus a
+ *      hash map with linear probing (without deletion, a key is moved
+ *      between the buckets when its entry is reused)
+ */
+typedef struct {
+    uint64_t *keys;
+    uint32_t *prev;
+    uint32_t *next;
+    uint32_t *table;
+    size_t mask;
+    size_t capacity;
+    size_t size;
+    uint32_t head;  // Most recently used
+    uint32_t tail;  // Least recently used
+} BenchLru_t;
+
+static size_t bench_lru_hash(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return (size_t)key;
+}
+
+static size_t bench_lru_bucket(const BenchLru_t *lru, uint64_t key) {
+    size_t b = bench_lru_hash(key) & lru->mask;
+    while (lru->table[b] != BENCH_LRU_EMPTY && lru->keys[lru->table[b]] != key)
+        b = (b + 1) & lru->mask;
+    return b;
+}
+
+static void bench_lru_unlink_bucket(BenchLru_t *lru, size_t bucket) {
+    size_t hole = bucket;
+    size_t b = (bucket + 1) & lru->mask;
+    while (lru->table[b] != BENCH_LRU_EMPTY) {
+        size_t home = bench_lru_hash(lru->keys[lru->table[b]]) & lru->mask;
+        if (((b - home) & lru->mask) >= ((b - hole) & lru->mask)) {
+            lru->table[hole] = lru->table[b];
+            hole = b;
+        }
+        b = (b + 1) & lru->mask;
+    }
+    lru->table[hole] = BENCH_LRU_EMPTY;
+}
+
+static void bench_lru_detach(BenchLru_t *lru, uint32_t e) {
+    if (lru->prev[e] != BENCH_LRU_EMPTY)
+        lru->next[lru->prev[e]] = lru->next[e];
+    else
+        lru->head = lru->next[e];
+    if (lru->next[e] != BENCH_LRU_EMPTY)
+        lru->prev[lru->next[e]] = lru->prev[e];
+    else
+        lru->tail = lru->prev[e];
+}
+
+static void bench_lru_push_front(BenchLru_t *lru, uint32_t e) {
+    lru->prev[e] = BENCH_LRU_EMPTY;
+    lru->next[e] = lru->head;
+    if (lru->head != BENCH_LRU_EMPTY)
+        lru->prev[lru->head] = e;
+    lru->head = e;
+    if (lru->tail == BENCH_LRU_EMPTY)
+        lru->tail = e;
+}
+
+static bool bench_lru_init(BenchLru_t *lru, size_t capacity, ArenaAllocatorHandler_t *arena) {
+    size_t buckets = 1;
+    while (buckets < capacity * 2)
+        buckets <<= 1;
+    lru->keys = arena_allocator_api_calloc(arena, sizeof(uint64_t), capacity);
+    lru->prev = arena_allocator_api_calloc(arena, sizeof(uint32_t), capacity);
+    lru->next = arena_allocator_api_calloc(arena, sizeof(uint32_t), capacity);
+    lru->table = arena_allocator_api_calloc(arena, sizeof(uint32_t), buckets);
+    if (lru->keys == NULL || lru->prev == NULL || lru->next == NULL || lru->table == NULL)
+        return false;
+    for (size_t i = 0; i < buckets; ++i)
+        lru->table[i] = BENCH_LRU_EMPTY;
+    lru->mask = buckets - 1;
+    lru->capacity = capacity;
+    lru->size = 0;
+    lru->head = BENCH_LRU_EMPTY;
+    lru->tail = BENCH_LRU_EMPTY;
+    return true;
+}
+
+/*!
+ * \brief Request a key, insert it on a miss
+ *
+ * \return bool True on a hit
+ */
+static bool bench_lru_request(BenchLru_t *lru, uint64_t key) {
+    size_t bucket = bench_lru_bucket(lru, key);
+    uint32_t e = lru->table[bucket];
+    if (e != BENCH_LRU_EMPTY) {
+        bench_lru_detach(lru, e);
+        bench_lru_push_front(lru, e);
+        return true;
+    }
+    if (lru->size < lru->capacity) {
+        e = (uint32_t)lru->size++;
+    } else {
+        e = lru->tail;
+        bench_lru_detach(lru, e);
+        bench_lru_unlink_bucket(lru, bench_lru_bucket(lru, lru->keys[e]));
+        bucket = bench_lru_bucket(lru, key);
+    }
+    lru->keys[e] = key;
+    lru->table[bucket] = e;
+    bench_lru_push_front(lru, e);
+    return false;
+}
+
+/*!
+ * \brief Cost of a miss of a key, one key every ten is expensive
+ */
+static uint32_t bench_cost(uint64_t key) {
+    return (bench_lru_hash(key ^ 0x9e3779b97f4a7c15ULL) % 10U) == 0 ? 100U : 1U;
+}
+
+/*!
+ * \brief Draw a key from the cumulative distribution of the Zipf distribution
+ */
+static uint64_t bench_zipf(const double *cdf, BenchRng_t *rng) {
+    double u = bench_rng_uniform(rng);
+    size_t lo = 0, hi = BENCH_CACHE_KEYS - 1;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (cdf[mid] < u)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    // Scatter the popular keys over the key space
+    return bench_lru_hash(lo + 1);
+}
+
+/*!
+ * \brief Results of a single repetition
+ */
+typedef struct {
+    double miss_rate;
+    double miss_cost;
+    double ns;
+} BenchCacheResult_t;
+
+/*!
+ * \brief Run a single repetition
+ *
+ * \return bool False on error
+ */
+static bool bench_cache_run(int policy,
+                            bool scans,
+                            size_t capacity,
+                            const double *cdf,
+                            size_t requests,
+                            uint64_t seed,
+                            BenchCacheResult_t *result) {
+    ArenaAllocatorHandler_t arena;
+    MinHeapCacheHandler_t cache;
+    BenchLru_t lru;
+    BenchRng_t rng;
+    bool ok = false;
+
+    arena_allocator_api_init(&arena);
+    if (policy == BENCH_CACHE_LRU) {
+        if (!bench_lru_init(&lru, capacity, &arena))
+            goto cleanup;
+    } else if (min_heap_cache_api_init(&cache, (MinHeapCachePolicy)policy, capacity, 0, &arena) != MIN_HEAP_OK) {
+        goto cleanup;
+    }
+
+    bench_rng_seed(&rng, seed);
+    size_t misses = 0;
+    uint64_t miss_cost = 0;
+    uint64_t scan_key = (uint64_t)1 << 63;
+    size_t scan_left = 0;
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < requests; ++i) {
+        uint64_t key;
+        if (scan_left > 0) {
+            key = scan_key++;
+            --scan_left;
+        } else {
+            if (scans && bench_rng_next(&rng) % BENCH_CACHE_SCAN_PERIOD == 0)
+                scan_left = BENCH_CACHE_SCAN_LENGTH;
+            key = bench_zipf(cdf, &rng);
+        }
+
+        bool hit;
+        if (policy == BENCH_CACHE_LRU) {
+            hit = bench_lru_request(&lru, key);
+        } else {
+            hit = min_heap_cache_api_get(&cache, key) != NULL;
+            if (!hit)
+                min_heap_cache_api_put(&cache, key, bench_cost(key), NULL, NULL, NULL, NULL);
+        }
+        if (!hit) {
+            ++misses;
+            miss_cost += bench_cost(key);
+        }
+    }
+    uint64_t stop = bench_now_ns();
+
+    result->miss_rate = 100.0 * misses / requests;
+    result->miss_cost = (double)miss_cost / requests;
+    result->ns = (double)(stop - start) / requests;
+    ok = true;
+
+cleanup:
+    arena_allocator_api_free(&arena);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    size_t reps = 5U;
+    size_t requests = BENCH_CACHE_DEFAULT_REQUESTS;
+    const char *json_path = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "r:s:j:")) != -1) {
+        switch (opt) {
+            case 'r':
+                reps = strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                requests = strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                json_path = optarg;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-r repetitions] [-s requests] [-j output.json]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (reps == 0 || reps > BENCH_MAX_SAMPLES || requests == 0) {
+        fprintf(stderr, "[ERROR]: Repetitions must be in [1, %u] and requests greater than 0\n", BENCH_MAX_SAMPLES);
+        return EXIT_FAILURE;
+    }
+
+    double *cdf = malloc(BENCH_CACHE_KEYS * sizeof(double));
+    if (cdf == NULL) {
+        fprintf(stderr, "[ERROR]: Cannot allocate the distribution\n");
+        return EXIT_FAILURE;
+    }
+    double sum = 0.0;
+    for (size_t k = 0; k < BENCH_CACHE_KEYS; ++k) {
+        sum += 1.0 / pow((double)(k + 1), BENCH_CACHE_ZIPF);
+        cdf[k] = sum;
+    }
+    for (size_t k = 0; k < BENCH_CACHE_KEYS; ++k)
+        cdf[k] /= sum;
+
+    BenchReport_t report;
+    if (!bench_report_open(&report, "cache", json_path)) {
+        fprintf(stderr, "[ERROR]: Cannot open %s\n", json_path);
+        free(cdf);
+        return EXIT_FAILURE;
+    }
+
+    for (size_t w = 0; w < BENCH_ARRAY_LEN(bench_workloads); ++w) {
+        for (size_t c = 0; c < BENCH_ARRAY_LEN(bench_capacities); ++c) {
+            const size_t capacity = BENCH_CACHE_KEYS * bench_capacities[c] / 1000U;
+            for (size_t p = 0; p < BENCH_ARRAY_LEN(bench_policies); ++p) {
+                double miss_rate[BENCH_MAX_SAMPLES], miss_cost[BENCH_MAX_SAMPLES], ns[BENCH_MAX_SAMPLES];
+                size_t count = 0;
+                for (size_t r = 0; r < reps; ++r) {
+                    BenchCacheResult_t result;
+                    if (bench_cache_run(bench_policies[p].policy, bench_workloads[w].scans, capacity, cdf, requests, r + 1, &result)) {
+                        miss_rate[count] = result.miss_rate;
+                        miss_cost[count] = result.miss_cost;
+                        ns[count] = result.ns;
+                        ++count;
+                    }
+                }
+
+                char name[128];
+                snprintf(name, sizeof(name), "%s/%s/C=%zu", bench_policies[p].name, bench_workloads[w].name, capacity);
+                if (count == 0)
+                    fprintf(stderr, "[ERROR]: Cannot run %s\n", name);
+                char case_name[160];
+                // Every reported metric is lower-is-better, as bench-compare.py expects
+                snprintf(case_name, sizeof(case_name), "%s/miss-rate", name);
+                bench_report_case(&report, case_name, "%", miss_rate, count);
+                snprintf(case_name, sizeof(case_name), "%s/miss-cost", name);
+                bench_report_case(&report, case_name, "cost/request", miss_cost, count);
+                snprintf(case_name, sizeof(case_name), "%s/time", name);
+                bench_report_case(&report, case_name, "ns/request", ns, count);
+            }
+        }
+    }
+
+    bench_report_close(&report);
+    free(cdf);
+    return EXIT_SUCCESS;
+}
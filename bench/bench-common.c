@@ -0,0 +1,123 @@
+/*!
+ * \file bench-common.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Utilities shared by the benchmark programs
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "bench-common.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void bench_rng_seed(BenchRng_t *rng, uint64_t seed) {
+    // Expand the seed with splitmix64 so that the state is never all zeros
+    for (size_t i = 0; i < 2; ++i) {
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        rng->s[i] = z ^ (z >> 31);
+    }
+}
+
+uint64_t bench_rng_next(BenchRng_t *rng) {
+    uint64_t s1 = rng->s[0];
+    const uint64_t s0 = rng->s[1];
+    const uint64_t res = s0 + s1;
+    rng->s[0] = s0;
+    s1 ^= s1 << 23;
+    rng->s[1] = s1 ^ s0 ^ (s1 >> 18) ^ (s0 >> 5);
+    return res;
+}
+
+double bench_rng_uniform(BenchRng_t *rng) {
+    // Use the upper 53 bits to fill the mantissa
+    return (bench_rng_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static int bench_compare_double(const void *a, const void *b) {
+    double f = *(const double *)a;
+    double s = *(const double *)b;
+    if (f < s)
+        return -1;
+    return f == s ? 0 : 1;
+}
+
+bool bench_report_open(BenchReport_t *report, const char *benchmark, const char *json_path) {
+    report->json = NULL;
+    report->first = true;
+    if (json_path == NULL)
+        return true;
+    report->json = fopen(json_path, "w");
+    if (report->json == NULL)
+        return false;
+    fprintf(report->json, "{\n  \"benchmark\": \"%s\",\n  \"cases\": [", benchmark);
+    return true;
+}
+
+void bench_report_case(BenchReport_t *report,
+                       const char *name,
+                       const char *unit,
+                       const double *samples,
+                       size_t count) {
+    if (count == 0)
+        return;
+
+    double sorted[BENCH_MAX_SAMPLES];
+    if (count > BENCH_MAX_SAMPLES)
+        count = BENCH_MAX_SAMPLES;
+    memcpy(sorted, samples, count * sizeof(double));
+    qsort(sorted, count, sizeof(double), bench_compare_double);
+
+    double mean = 0.0;
+    for (size_t i = 0; i < count; ++i)
+        mean += sorted[i];
+    mean /= count;
+    double var = 0.0;
+    for (size_t i = 0; i < count; ++i)
+        var += (sorted[i] - mean) * (sorted[i] - mean);
+    var = count > 1 ? var / (count - 1) : 0.0;
+    double median = (count % 2) ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+    double rsd = mean != 0.0 ? 100.0 * sqrt(var) / mean : 0.0;
+
+    printf("%-56s %10.2f %-6s (mean %.2f, min %.2f, rsd %.1f%%, n=%zu)\n",
+           name,
+           median,
+           unit,
+           mean,
+           sorted[0],
+           rsd,
+           count);
+
+    if (report->json == NULL)
+        return;
+    fprintf(report->json,
+            "%s\n    { \"name\": \"%s\", \"unit\": \"%s\", \"samples\": [",
+            report->first ? "" : ",",
+            name,
+            unit);
+    for (size_t i = 0; i < count; ++i)
+        fprintf(report->json, "%s%.6g", i ? ", " : "", samples[i]);
+    fprintf(report->json, "] }");
+    report->first = false;
+}
+
+void bench_report_close(BenchReport_t *report) {
+    if (report->json == NULL)
+        return;
+    fprintf(report->json, "\n  ]\n}\n");
+    fclose(report->json);
+    report->json = NULL;
+}
@@ -0,0 +1,117 @@
+/*!
+ * \file bench-common.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Utilities shared by the benchmark programs
+ *
+ * \details The benchmarks are meant to be run on a host machine (not on the
+ *      target) and provide a monotonic timer, a small deterministic random
+ *      number generator and a reporter that prints a summary of each case
+ *      and optionally writes all the raw samples to a JSON file.
+ */
+
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/*! \brief Maximum number of repetitions of a single benchmark case */
+#define BENCH_MAX_SAMPLES (64U)
+
+/*!
+ * \struct BenchRng_t
+ * \brief State of the xorshift128+ pseudo-random number generator
+ *
+ * \var uint64_t s
+ *      The internal state, has to be seeded with bench_rng_seed
+ */
+typedef struct {
+    uint64_t s[2];
+} BenchRng_t;
+
+/*!
+ * \struct BenchReport_t
+ * \brief Reporter for the benchmark results
+ *
+ * \var FILE *json
+ *      The JSON output file, NULL if only the summary has to be printed
+ * \var bool first
+ *      True if no case has been written to the JSON file yet
+ */
+typedef struct {
+    FILE *json;
+    bool first;
+} BenchReport_t;
+
+/*!
+ * \brief Get the current time of a monotonic clock in nanoseconds
+ *
+ * \return uint64_t The current time in ns
+ */
+uint64_t bench_now_ns(void);
+
+/*!
+ * \brief Seed the random number generator
+ * \details The same seed always generates the same sequence
+ *
+ * \param rng The generator state
+ * \param seed Any 64 bit value
+ */
+void bench_rng_seed(BenchRng_t *rng, uint64_t seed);
+
+/*!
+ * \brief Get the next 64 bit pseudo-random number
+ *
+ * \param rng The generator state
+ * \return uint64_t The random number
+ */
+uint64_t bench_rng_next(BenchRng_t *rng);
+
+/*!
+ * \brief Get a pseudo-random number uniformly distributed in [0, 1)
+ *
+ * \param rng The generator state
+ * \return double The random number
+ */
+double bench_rng_uniform(BenchRng_t *rng);
+
+/*!
+ * \brief Open a benchmark report
+ *
+ * \param report The reporter handler
+ * \param benchmark The name of the benchmark program
+ * \param json_path The path of the JSON output file, can be NULL
+ * \return bool False if the JSON file cannot be opened, true otherwise
+ */
+bool bench_report_open(BenchReport_t *report, const char *benchmark, const char *json_path);
+
+/*!
+ * \brief Report the samples of a single benchmark case
+ * \details A summary (median, mean, min and relative standard deviation)
+ *      is printed on stdout, the raw samples are written to the JSON file
+ *
+ * \param report The reporter handler
+ * \param name The unique name of the case
+ * \param unit The unit of measure of the samples (e.g. "ns/op")
+ * \param samples The measured values, one for each repetition
+ * \param count The number of samples
+ */
+void bench_report_case(BenchReport_t *report,
+                       const char *name,
+                       const char *unit,
+                       const double *samples,
+                       size_t count);
+
+/*!
+ * \brief Close the report and the JSON output file
+ *
+ * \param report The reporter handler
+ */
+void bench_report_close(BenchReport_t *report);
+
+#endif
@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+"""
+\\file bench-compare.py
+\\date 2025-03-28
+\\authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+\\authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+
+\\brief Compare two benchmark result files and detect regressions
+
+\\details Both files are the JSON outputs of a benchmark program (option -j).
+    For every case present in both files the relative change of the mean is
+    computed together with its confidence interval (Welch's t-test over the
+    repetitions). All the units are "lower is better", a case is a regression
+    if the whole confidence interval lies above the threshold.
+
+    Usage: bench-compare.py [-t threshold%] [-c confidence] [-f filter] base.json new.json
+    Exit code: 0 if no regression is found, 1 otherwise, 2 on errors
+"""
+
+import argparse
+import json
+import math
+import sys
+
+
+def betacf(a, b, x):
+    """Continued fraction of the incomplete beta function (Lentz's method)"""
+    tiny = 1e-300
+    c, d = 1.0, 1.0 - (a + b) * x / (a + 1.0)
+    d = 1.0 / (d if abs(d) > tiny else tiny)
+    h = d
+    for m in range(1, 300):
+        m2 = 2 * m
+        aa = m * (b - m) * x / ((a + m2 - 1.0) * (a + m2))
+        d = 1.0 + aa * d
+        d = 1.0 / (d if abs(d) > tiny else tiny)
+        c = 1.0 + aa / c
+        c = c if abs(c) > tiny else tiny
+        h *= d * c
+        aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1.0))
+        d = 1.0 + aa * d
+        d = 1.0 / (d if abs(d) > tiny else tiny)
+        c = 1.0 + aa / c
+        c = c if abs(c) > tiny else tiny
+        delta = d * c
+        h *= delta
+        if abs(delta - 1.0) < 1e-12:
+            break
+    return h
+
+
+def betainc(a, b, x):
+    """Regularized incomplete beta function I_x(a, b)"""
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    lbeta = math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b)
+    front = math.exp(lbeta + a * math.log(x) + b * math.log(1.0 - x))
+    if x < (a + 1.0) / (a + b + 2.0):
+        return front * betacf(a, b, x) / a
+    return 1.0 - front * betacf(b, a, 1.0 - x) / b
+
+
+def t_cdf(t, df):
+    """Cumulative distribution function of the Student's t distribution"""
+    p = 0.5 * betainc(df / 2.0, 0.5, df / (df + t * t))
+    return 1.0 - p if t > 0 else p
+
+
+def t_quantile(p, df):
+    """Inverse of t_cdf computed by bisection"""
+    lo, hi = -1e3, 1e3
+    for _ in range(200):
+        mid = (lo + hi) / 2.0
+        if t_cdf(mid, df) < p:
+            lo = mid
+        else:
+            hi = mid
+    return (lo + hi) / 2.0
+
+
+def stats(samples):
+    n = len(samples)
+    mean = sum(samples) / n
+    var = sum((s - mean) ** 2 for s in samples) / (n - 1) if n > 1 else 0.0
+    return n, mean, var
+
+
+def compare(base, new, confidence):
+    """
+    Return the relative change of the mean of 'new' with respect to 'base'
+    and the bounds of its confidence interval (all as fractions)
+    """
+    n1, m1, v1 = stats(base)
+    n2, m2, v2 = stats(new)
+    if m1 == 0.0:
+        return 0.0, 0.0, 0.0
+    delta = m2 - m1
+    se2 = v1 / n1 + v2 / n2
+    if se2 == 0.0 or n1 < 2 or n2 < 2:
+        return delta / m1, delta / m1, delta / m1
+    # Welch-Satterthwaite degrees of freedom
+    df = se2 ** 2 / ((v1 / n1) ** 2 / (n1 - 1) + (v2 / n2) ** 2 / (n2 - 1))
+    half = t_quantile(0.5 + confidence / 2.0, df) * math.sqrt(se2)
+    return delta / m1, (delta - half) / m1, (delta + half) / m1
+
+
+def load(path):
+    try:
+        with open(path) as f:
+            data = json.load(f)
+        return {c["name"]: c for c in data["cases"] if c["samples"]}
+    except (OSError, ValueError, KeyError, TypeError) as e:
+        print(f"[ERROR]: Cannot load {path}: {e}", file=sys.stderr)
+        sys.exit(2)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two benchmark result files")
+    parser.add_argument("base", help="JSON results of the reference run")
+    parser.add_argument("new", help="JSON results of the run to check")
+    parser.add_argument("-t", "--threshold", type=float, default=5.0,
+                        help="maximum allowed slowdown in percent (default 5)")
+    parser.add_argument("-c", "--confidence", type=float, default=0.95,
+                        help="confidence level of the intervals (default 0.95)")
+    parser.add_argument("-f", "--filter", default="",
+                        help="compare only the cases whose name contains this string")
+    args = parser.parse_args()
+    if not 0.0 < args.confidence < 1.0:
+        parser.error("the confidence level must be in (0, 1)")
+
+    base = load(args.base)
+    new = load(args.new)
+    names = [n for n in base if n in new and args.filter in n]
+    if not names:
+        print("[ERROR]: No common cases to compare", file=sys.stderr)
+        return 2
+
+    threshold = args.threshold / 100.0
+    regressions = 0
+    width = max(len(n) for n in names)
+    print(f"{'case':<{width}} {'base':>12} {'new':>12} {'delta':>9}   {int(args.confidence * 100)}% CI")
+    for name in names:
+        b, n = base[name]["samples"], new[name]["samples"]
+        delta, lo, hi = compare(b, n, args.confidence)
+        if lo > threshold:
+            verdict = "REGRESSION"
+            regressions += 1
+        elif hi < -threshold:
+            verdict = "improvement"
+        elif lo > 0.0 or hi < 0.0:
+            verdict = "changed"
+        else:
+            verdict = ""
+        print(f"{name:<{width}} {sum(b) / len(b):>12.2f} {sum(n) / len(n):>12.2f} "
+              f"{delta * 100:>+8.2f}%   [{lo * 100:+.2f}%, {hi * 100:+.2f}%] {verdict}")
+
+    missing = len([n for n in base if n not in new and args.filter in n])
+    if missing:
+        print(f"[WARNING]: {missing} cases of {args.base} are missing in {args.new}", file=sys.stderr)
+    print(f"{len(names)} cases compared, {regressions} regressions above {args.threshold:g}%")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
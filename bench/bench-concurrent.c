@@ -0,0 +1,584 @@
+/*!
+ * \file bench-concurrent.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Concurrency scaling benchmark of thread-safe front ends built on
+ *      top of the min heap
+ *
+ * \details The library itself is not thread-safe, this benchmark compares some
+ *      common ways to share it between threads:
+ *      - mutex: a single heap protected by a mutex
+ *      - flat-combining: a single heap where one thread at a time (the combiner)
+ *        applies the operations published by all the others
+ *      - multiqueue: 2 heaps per thread each protected by its own lock, inserts
+ *        go to a random heap and pops take the smaller top of two random heaps
+ *        (relaxed ordering)
+ *
+ *      The heap is pre-filled, then the threads are split in producers and
+ *      consumers (a single thread does both) and a fixed number of operations
+ *      is executed for every thread count.
+ *      For each case the time per operation, the latency percentiles and the
+ *      rank error of the pops (how many smaller items were in the queue when
+ *      an item was popped) are reported.
+ *      Each operation takes a ticket from a global counter while holding the
+ *      lock, the rank error is computed afterwards by replaying the operations
+ *      in ticket order.
+ *
+ *      Usage: bench-concurrent [-r repetitions] [-t max threads] [-o operations]
+ *                              [-p producers percentage] [-j output.json]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench-common.h"
+#include "min-heap-api.h"
+
+#define BENCH_ARRAY_LEN(A) (sizeof(A) / sizeof((A)[0]))
+
+/*! \brief Maximum number of threads */
+#define BENCH_MAX_THREADS (64U)
+/*! \brief Number of items inserted before the measurements */
+#define BENCH_PREFILL (65536U)
+/*! \brief Number of heaps per thread of the multiqueue */
+#define BENCH_MQ_FACTOR (2U)
+
+int8_t bench_compare_u64(void *a, void *b) {
+    uint64_t f = *(uint64_t *)a;
+    uint64_t s = *(uint64_t *)b;
+    if (f < s)
+        return -1;
+    return f == s ? 0 : 1;
+}
+
+/*!
+ * \brief Global ticket used to order the operations of all the threads
+ */
+static atomic_uint_fast64_t bench_ticket;
+
+/*!
+ * \brief Thread-safe front end under test
+ * \details The insert and pop callbacks have to take a ticket from
+ *      bench_ticket while the item is inside the critical section
+ */
+typedef struct {
+    const char *name;
+    bool (*init)(size_t threads, size_t capacity);
+    bool (*insert)(size_t tid, uint64_t key, uint64_t *ticket);
+    bool (*pop)(size_t tid, uint64_t *key, uint64_t *ticket);
+    void (*destroy)(void);
+} BenchFrontEnd_t;
+
+/*!
+ * \defgroup bench_mutex Single heap protected by a mutex
+ * @{
+ */
+
+static ArenaAllocatorHandler_t bench_mutex_arena;
+static MinHeapHandler_t bench_mutex_heap;
+static pthread_mutex_t bench_mutex_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static bool bench_mutex_init(size_t threads, size_t capacity) {
+    (void)threads;
+    arena_allocator_api_init(&bench_mutex_arena);
+    return min_heap_api_init(&bench_mutex_heap, sizeof(uint64_t), capacity, bench_compare_u64, &bench_mutex_arena) == MIN_HEAP_OK;
+}
+
+static bool bench_mutex_insert(size_t tid, uint64_t key, uint64_t *ticket) {
+    (void)tid;
+    pthread_mutex_lock(&bench_mutex_lock);
+    bool ok = min_heap_api_insert(&bench_mutex_heap, &key) == MIN_HEAP_OK;
+    *ticket = atomic_fetch_add_explicit(&bench_ticket, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&bench_mutex_lock);
+    return ok;
+}
+
+static bool bench_mutex_pop(size_t tid, uint64_t *key, uint64_t *ticket) {
+    (void)tid;
+    pthread_mutex_lock(&bench_mutex_lock);
+    bool ok = min_heap_api_remove(&bench_mutex_heap, 0, key) == MIN_HEAP_OK;
+    *ticket = atomic_fetch_add_explicit(&bench_ticket, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&bench_mutex_lock);
+    return ok;
+}
+
+static void bench_mutex_destroy(void) {
+    arena_allocator_api_free(&bench_mutex_arena);
+}
+
+/*! @} */
+
+/*!
+ * \defgroup bench_fc Flat combining over a single heap
+ * @{
+ */
+
+typedef enum {
+    BENCH_FC_IDLE,
+    BENCH_FC_INSERT,
+    BENCH_FC_POP
+} BenchFcOp;
+
+/*!
+ * \brief Publication record of a single thread, aligned to avoid false sharing
+ */
+typedef struct {
+    _Alignas(64) atomic_int op;
+    uint64_t key;
+    uint64_t ticket;
+    bool ok;
+} BenchFcSlot_t;
+
+static ArenaAllocatorHandler_t bench_fc_arena;
+static MinHeapHandler_t bench_fc_heap;
+static BenchFcSlot_t bench_fc_slots[BENCH_MAX_THREADS];
+static size_t bench_fc_threads;
+static atomic_flag bench_fc_combiner = ATOMIC_FLAG_INIT;
+
+static bool bench_fc_init(size_t threads, size_t capacity) {
+    bench_fc_threads = threads;
+    for (size_t i = 0; i < BENCH_MAX_THREADS; ++i)
+        atomic_init(&bench_fc_slots[i].op, BENCH_FC_IDLE);
+    arena_allocator_api_init(&bench_fc_arena);
+    return min_heap_api_init(&bench_fc_heap, sizeof(uint64_t), capacity, bench_compare_u64, &bench_fc_arena) == MIN_HEAP_OK;
+}
+
+static bool bench_fc_apply(size_t tid, BenchFcOp op, uint64_t *key, uint64_t *ticket) {
+    BenchFcSlot_t *slot = &bench_fc_slots[tid];
+    slot->key = *key;
+    atomic_store_explicit(&slot->op, op, memory_order_release);
+
+    while (atomic_load_explicit(&slot->op, memory_order_acquire) != BENCH_FC_IDLE) {
+        if (atomic_flag_test_and_set_explicit(&bench_fc_combiner, memory_order_acquire))
+            continue;
+
+        // This thread is the combiner, serve all the pending requests
+        for (size_t i = 0; i < bench_fc_threads; ++i) {
+            BenchFcSlot_t *s = &bench_fc_slots[i];
+            int pending = atomic_load_explicit(&s->op, memory_order_acquire);
+            if (pending == BENCH_FC_INSERT)
+                s->ok = min_heap_api_insert(&bench_fc_heap, &s->key) == MIN_HEAP_OK;
+            else if (pending == BENCH_FC_POP)
+                s->ok = min_heap_api_remove(&bench_fc_heap, 0, &s->key) == MIN_HEAP_OK;
+            else
+                continue;
+            s->ticket = atomic_fetch_add_explicit(&bench_ticket, 1, memory_order_relaxed);
+            atomic_store_explicit(&s->op, BENCH_FC_IDLE, memory_order_release);
+        }
+        atomic_flag_clear_explicit(&bench_fc_combiner, memory_order_release);
+    }
+    *key = slot->key;
+    *ticket = slot->ticket;
+    return slot->ok;
+}
+
+static bool bench_fc_insert(size_t tid, uint64_t key, uint64_t *ticket) {
+    return bench_fc_apply(tid, BENCH_FC_INSERT, &key, ticket);
+}
+
+static bool bench_fc_pop(size_t tid, uint64_t *key, uint64_t *ticket) {
+    return bench_fc_apply(tid, BENCH_FC_POP, key, ticket);
+}
+
+static void bench_fc_destroy(void) {
+    arena_allocator_api_free(&bench_fc_arena);
+}
+
+/*! @} */
+
+/*!
+ * \defgroup bench_mq MultiQueue with relaxed ordering
+ * @{
+ */
+
+typedef struct {
+    _Alignas(64) pthread_mutex_t lock;
+    MinHeapHandler_t heap;
+    atomic_uint_fast64_t top; // Cached top key, UINT64_MAX if empty
+} BenchMqQueue_t;
+
+static ArenaAllocatorHandler_t bench_mq_arena;
+static BenchMqQueue_t bench_mq_queues[BENCH_MAX_THREADS * BENCH_MQ_FACTOR];
+static size_t bench_mq_count;
+static BenchRng_t bench_mq_rng[BENCH_MAX_THREADS];
+
+static void bench_mq_update_top(BenchMqQueue_t *q) {
+    uint64_t *top = min_heap_api_peek(&q->heap);
+    atomic_store_explicit(&q->top, top == NULL ? UINT64_MAX : *top, memory_order_relaxed);
+}
+
+static bool bench_mq_init(size_t threads, size_t capacity) {
+    bench_mq_count = threads * BENCH_MQ_FACTOR;
+    arena_allocator_api_init(&bench_mq_arena);
+    for (size_t i = 0; i < BENCH_MAX_THREADS; ++i)
+        bench_rng_seed(&bench_mq_rng[i], 0xABCDULL + i);
+    for (size_t i = 0; i < bench_mq_count; ++i) {
+        BenchMqQueue_t *q = &bench_mq_queues[i];
+        pthread_mutex_init(&q->lock, NULL);
+        atomic_init(&q->top, UINT64_MAX);
+        // Leave some room for the unbalance caused by the random choices
+        if (min_heap_api_init(&q->heap, sizeof(uint64_t), 2 * capacity / bench_mq_count + 1024, bench_compare_u64, &bench_mq_arena) != MIN_HEAP_OK)
+            return false;
+    }
+    return true;
+}
+
+static bool bench_mq_insert(size_t tid, uint64_t key, uint64_t *ticket) {
+    for (size_t attempt = 0; attempt < 2 * bench_mq_count; ++attempt) {
+        BenchMqQueue_t *q = &bench_mq_queues[bench_rng_next(&bench_mq_rng[tid]) % bench_mq_count];
+        if (pthread_mutex_trylock(&q->lock) != 0)
+            continue;
+        bool ok = min_heap_api_insert(&q->heap, &key) == MIN_HEAP_OK;
+        if (ok) {
+            *ticket = atomic_fetch_add_explicit(&bench_ticket, 1, memory_order_relaxed);
+            bench_mq_update_top(q);
+        }
+        pthread_mutex_unlock(&q->lock);
+        if (ok)
+            return true;
+    }
+    return false;
+}
+
+static bool bench_mq_pop(size_t tid, uint64_t *key, uint64_t *ticket) {
+    for (size_t attempt = 0; attempt < 4 * bench_mq_count; ++attempt) {
+        BenchMqQueue_t *a = &bench_mq_queues[bench_rng_next(&bench_mq_rng[tid]) % bench_mq_count];
+        BenchMqQueue_t *b = &bench_mq_queues[bench_rng_next(&bench_mq_rng[tid]) % bench_mq_count];
+        uint64_t ta = atomic_load_explicit(&a->top, memory_order_relaxed);
+        uint64_t tb = atomic_load_explicit(&b->top, memory_order_relaxed);
+        BenchMqQueue_t *q = ta <= tb ? a : b;
+        if ((ta <= tb ? ta : tb) == UINT64_MAX)
+            continue;
+        if (pthread_mutex_trylock(&q->lock) != 0)
+            continue;
+        bool ok = min_heap_api_remove(&q->heap, 0, key) == MIN_HEAP_OK;
+        if (ok) {
+            *ticket = atomic_fetch_add_explicit(&bench_ticket, 1, memory_order_relaxed);
+            bench_mq_update_top(q);
+        }
+        pthread_mutex_unlock(&q->lock);
+        if (ok)
+            return true;
+    }
+    return false;
+}
+
+static void bench_mq_destroy(void) {
+    for (size_t i = 0; i < bench_mq_count; ++i)
+        pthread_mutex_destroy(&bench_mq_queues[i].lock);
+    arena_allocator_api_free(&bench_mq_arena);
+}
+
+/*! @} */
+
+static const BenchFrontEnd_t bench_front_ends[] = {
+    { "mutex", bench_mutex_init, bench_mutex_insert, bench_mutex_pop, bench_mutex_destroy },
+    { "flat-combining", bench_fc_init, bench_fc_insert, bench_fc_pop, bench_fc_destroy },
+    { "multiqueue", bench_mq_init, bench_mq_insert, bench_mq_pop, bench_mq_destroy },
+};
+
+/*!
+ * \brief Operation recorded by a thread, used to compute the rank error
+ */
+typedef struct {
+    uint64_t ticket;
+    uint64_t key;
+    bool insert;
+} BenchEvent_t;
+
+typedef struct {
+    pthread_t thread;
+    size_t tid;
+    bool producer;
+    bool consumer;
+    size_t ops;
+    const BenchFrontEnd_t *fe;
+    pthread_barrier_t *barrier;
+    BenchEvent_t *events;
+    size_t event_count;
+    double *latencies;
+    size_t latency_count;
+} BenchWorker_t;
+
+static void *bench_worker(void *arg) {
+    BenchWorker_t *w = (BenchWorker_t *)arg;
+    BenchRng_t rng;
+    bench_rng_seed(&rng, 0x5EEDULL + w->tid);
+
+    pthread_barrier_wait(w->barrier);
+    for (size_t i = 0; i < w->ops; ++i) {
+        // A thread that is both producer and consumer alternates the operations
+        bool insert = w->producer && (!w->consumer || (i % 2) == 0);
+        BenchEvent_t ev = { .insert = insert, .key = bench_rng_next(&rng) >> 1 };
+
+        uint64_t start = bench_now_ns();
+        bool ok = insert ? w->fe->insert(w->tid, ev.key, &ev.ticket)
+                         : w->fe->pop(w->tid, &ev.key, &ev.ticket);
+        w->latencies[w->latency_count++] = (double)(bench_now_ns() - start);
+        if (ok)
+            w->events[w->event_count++] = ev;
+    }
+    return NULL;
+}
+
+static int bench_compare_event(const void *a, const void *b) {
+    uint64_t f = ((const BenchEvent_t *)a)->ticket;
+    uint64_t s = ((const BenchEvent_t *)b)->ticket;
+    return f < s ? -1 : (f > s);
+}
+
+static int bench_compare_key(const void *a, const void *b) {
+    uint64_t f = *(const uint64_t *)a;
+    uint64_t s = *(const uint64_t *)b;
+    return f < s ? -1 : (f > s);
+}
+
+static int bench_compare_latency(const void *a, const void *b) {
+    double f = *(const double *)a;
+    double s = *(const double *)b;
+    return f < s ? -1 : (f > s);
+}
+
+static size_t bench_key_index(const uint64_t *keys, size_t n, uint64_t key) {
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (keys[mid] < key)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/*!
+ * \brief Replay the operations in ticket order and compute the average rank
+ *      error of the pops with a Fenwick tree over the compressed keys
+ *
+ * \param prefill The keys inserted before the measurement
+ * \param events All the successful operations
+ * \return double The mean rank error, negative on error
+ */
+static double bench_rank_error(const uint64_t *prefill, size_t prefill_count, BenchEvent_t *events, size_t event_count) {
+    size_t n = 0;
+    uint64_t *keys = malloc((prefill_count + event_count) * sizeof(uint64_t));
+    uint32_t *tree = NULL;
+    double result = -1.0;
+    if (keys == NULL)
+        return result;
+
+    memcpy(keys, prefill, prefill_count * sizeof(uint64_t));
+    n = prefill_count;
+    for (size_t i = 0; i < event_count; ++i) {
+        if (events[i].insert)
+            keys[n++] = events[i].key;
+    }
+    qsort(keys, n, sizeof(uint64_t), bench_compare_key);
+    tree = calloc(n + 1, sizeof(uint32_t));
+    if (tree == NULL)
+        goto cleanup;
+
+    for (size_t i = 0; i < prefill_count; ++i) {
+        for (size_t j = bench_key_index(keys, n, prefill[i]) + 1; j <= n; j += j & -j)
+            ++tree[j];
+    }
+
+    qsort(events, event_count, sizeof(BenchEvent_t), bench_compare_event);
+    double total = 0.0;
+    size_t pops = 0;
+    for (size_t i = 0; i < event_count; ++i) {
+        size_t idx = bench_key_index(keys, n, events[i].key);
+        if (events[i].insert) {
+            for (size_t j = idx + 1; j <= n; j += j & -j)
+                ++tree[j];
+            continue;
+        }
+        // Number of items still in the queue with a smaller key
+        uint64_t rank = 0;
+        for (size_t j = idx; j > 0; j -= j & -j)
+            rank += tree[j];
+        total += rank;
+        ++pops;
+        for (size_t j = idx + 1; j <= n; j += j & -j)
+            --tree[j];
+    }
+    result = pops ? total / pops : 0.0;
+
+cleanup:
+    free(tree);
+    free(keys);
+    return result;
+}
+
+/*!
+ * \brief Measured values of a single run
+ */
+typedef struct {
+    double ns_per_op;
+    double p50;
+    double p99;
+    double p999;
+    double rank_error;
+} BenchRun_t;
+
+static bool bench_run(const BenchFrontEnd_t *fe,
+                      size_t threads,
+                      size_t ops,
+                      unsigned producers_pct,
+                      BenchRun_t *out) {
+    BenchWorker_t workers[BENCH_MAX_THREADS];
+    pthread_barrier_t barrier;
+    uint64_t prefill[BENCH_PREFILL];
+    size_t ops_per_thread = ops / threads;
+    size_t producers = threads == 1 ? 1 : (threads * producers_pct + 50) / 100;
+    bool ok = false;
+
+    if (producers == 0)
+        producers = 1;
+    if (threads > 1 && producers >= threads)
+        producers = threads - 1;
+
+    if (!fe->init(threads, BENCH_PREFILL + ops))
+        goto cleanup_fe;
+
+    BenchRng_t rng;
+    bench_rng_seed(&rng, 42);
+    for (size_t i = 0; i < BENCH_PREFILL; ++i) {
+        uint64_t ticket;
+        prefill[i] = bench_rng_next(&rng) >> 1;
+        if (!fe->insert(i % threads, prefill[i], &ticket))
+            goto cleanup_fe;
+    }
+    atomic_store(&bench_ticket, 0);
+
+    double *latencies = malloc(ops * sizeof(double));
+    BenchEvent_t *events = malloc(ops * sizeof(BenchEvent_t));
+    if (latencies == NULL || events == NULL)
+        goto cleanup_buffers;
+
+    pthread_barrier_init(&barrier, NULL, threads + 1);
+    for (size_t t = 0; t < threads; ++t) {
+        workers[t] = (BenchWorker_t) {
+            .tid = t,
+            .producer = threads == 1 || t < producers,
+            .consumer = threads == 1 || t >= producers,
+            .ops = ops_per_thread,
+            .fe = fe,
+            .barrier = &barrier,
+            .events = events + t * ops_per_thread,
+            .latencies = latencies + t * ops_per_thread,
+        };
+        pthread_create(&workers[t].thread, NULL, bench_worker, &workers[t]);
+    }
+    pthread_barrier_wait(&barrier);
+    uint64_t start = bench_now_ns();
+    for (size_t t = 0; t < threads; ++t)
+        pthread_join(workers[t].thread, NULL);
+    uint64_t elapsed = bench_now_ns() - start;
+    pthread_barrier_destroy(&barrier);
+
+    // Compact the per-thread buffers
+    size_t latency_count = 0, event_count = 0;
+    for (size_t t = 0; t < threads; ++t) {
+        memmove(latencies + latency_count, workers[t].latencies, workers[t].latency_count * sizeof(double));
+        memmove(events + event_count, workers[t].events, workers[t].event_count * sizeof(BenchEvent_t));
+        latency_count += workers[t].latency_count;
+        event_count += workers[t].event_count;
+    }
+    qsort(latencies, latency_count, sizeof(double), bench_compare_latency);
+
+    out->ns_per_op = (double)elapsed / latency_count;
+    out->p50 = latencies[latency_count * 50 / 100];
+    out->p99 = latencies[latency_count * 99 / 100];
+    out->p999 = latencies[latency_count * 999 / 1000];
+    out->rank_error = bench_rank_error(prefill, BENCH_PREFILL, events, event_count);
+    ok = out->rank_error >= 0.0;
+
+cleanup_buffers:
+    free(events);
+    free(latencies);
+cleanup_fe:
+    fe->destroy();
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    size_t reps = 3U;
+    size_t max_threads = 16U;
+    size_t ops = 1U << 20;
+    unsigned producers_pct = 50U;
+    const char *json_path = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "r:t:o:p:j:")) != -1) {
+        switch (opt) {
+            case 'r':
+                reps = strtoul(optarg, NULL, 10);
+                break;
+            case 't':
+                max_threads = strtoul(optarg, NULL, 10);
+                break;
+            case 'o':
+                ops = strtoul(optarg, NULL, 10);
+                break;
+            case 'p':
+                producers_pct = strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                json_path = optarg;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-r repetitions] [-t max threads] [-o operations] [-p producers %%] [-j output.json]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (reps == 0 || reps > BENCH_MAX_SAMPLES || max_threads == 0 || max_threads > BENCH_MAX_THREADS || ops < max_threads || producers_pct > 100) {
+        fprintf(stderr, "[ERROR]: Invalid arguments\n");
+        return EXIT_FAILURE;
+    }
+
+    BenchReport_t report;
+    if (!bench_report_open(&report, "concurrent", json_path)) {
+        fprintf(stderr, "[ERROR]: Cannot open %s\n", json_path);
+        return EXIT_FAILURE;
+    }
+
+    for (size_t f = 0; f < BENCH_ARRAY_LEN(bench_front_ends); ++f) {
+        for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+            double samples[5][BENCH_MAX_SAMPLES];
+            size_t count = 0;
+            for (size_t r = 0; r < reps; ++r) {
+                BenchRun_t run;
+                if (!bench_run(&bench_front_ends[f], threads, ops, producers_pct, &run))
+                    continue;
+                samples[0][count] = run.ns_per_op;
+                samples[1][count] = run.p50;
+                samples[2][count] = run.p99;
+                samples[3][count] = run.p999;
+                samples[4][count] = run.rank_error;
+                ++count;
+            }
+
+            static const char *metrics[5] = { "", ":p50", ":p99", ":p99.9", ":rank-error" };
+            static const char *units[5] = { "ns/op", "ns", "ns", "ns", "rank" };
+            char name[128];
+            if (count == 0)
+                fprintf(stderr, "[ERROR]: Cannot run %s with %zu threads\n", bench_front_ends[f].name, threads);
+            for (size_t m = 0; m < 5; ++m) {
+                snprintf(name, sizeof(name), "%s/T=%zu%s", bench_front_ends[f].name, threads, metrics[m]);
+                bench_report_case(&report, name, units[m], samples[m], count);
+            }
+        }
+    }
+
+    bench_report_close(&report);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,227 @@
+/*!
+ * \file bench-drain.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Benchmark of the sorted drain of a heap, serial and parallel
+ *
+ * \details A heap of N random 64 bit keys is emptied in increasing order
+ *      with min_heap_api_pop_k (serial) and with min_heap_api_drain_parallel
+ *      using one part per thread. The tasks are executed by a simple
+ *      fork-join runner that starts the threads at every call, the cost of
+ *      starting them is included in the measured time.
+ *      The output of every parallel drain is checked against the serial one.
+ *
+ *      Usage: bench-drain [-r repetitions] [-t max threads] [-j output.json]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench-common.h"
+#include "min-heap-api.h"
+
+#define BENCH_ARRAY_LEN(A) (sizeof(A) / sizeof((A)[0]))
+
+/*! \brief Maximum number of threads */
+#define BENCH_MAX_THREADS (16U)
+
+/*! \brief Numbers of items tested */
+static const size_t bench_sizes[] = { 1048576U, 10485760U };
+
+/*! \brief Numbers of threads tested */
+static const size_t bench_threads[] = { 1U, 2U, 4U, 8U, 16U };
+
+int8_t bench_compare_u64(void *a, void *b) {
+    uint64_t f = *(uint64_t *)a;
+    uint64_t s = *(uint64_t *)b;
+    if (f < s)
+        return -1;
+    return f == s ? 0 : 1;
+}
+
+/*!
+ * \brief Arguments of a worker thread of the fork-join runner
+ */
+typedef struct {
+    void (*task)(void *arg, size_t index);
+    void *arg;
+    size_t first;
+    size_t last;
+} BenchWorker_t;
+
+static void *bench_worker(void *arg) {
+    BenchWorker_t *worker = arg;
+    for (size_t i = worker->first; i < worker->last; ++i)
+        worker->task(worker->arg, i);
+    return NULL;
+}
+
+/*!
+ * \brief Run the tasks with at most BENCH_MAX_THREADS threads, the calling
+ *      thread executes the first share of the tasks
+ */
+static void bench_run(void (*task)(void *arg, size_t index), void *arg, size_t count, void *ctx) {
+    size_t threads = *(size_t *)ctx;
+    if (threads > count)
+        threads = count;
+    if (threads == 0)
+        return;
+    pthread_t ids[BENCH_MAX_THREADS];
+    BenchWorker_t workers[BENCH_MAX_THREADS];
+    for (size_t t = 0; t < threads; ++t)
+        workers[t] = (BenchWorker_t){ task, arg, t * count / threads, (t + 1) * count / threads };
+
+    size_t started = 1;
+    for (size_t t = 1; t < threads; ++t, ++started) {
+        if (pthread_create(&ids[t], NULL, bench_worker, &workers[t]) != 0)
+            break;
+    }
+    // Tasks of threads that could not be started run on the calling thread
+    for (size_t t = started; t < threads; ++t)
+        bench_worker(&workers[t]);
+    bench_worker(&workers[0]);
+    for (size_t t = 1; t < started; ++t)
+        pthread_join(ids[t], NULL);
+}
+
+/*!
+ * \brief Run a single drain
+ *
+ * \param threads The number of threads, 0 for the serial drain
+ * \param expected The serial output to check the result against, can be NULL
+ * \return double The time per item in ns, or a negative value on error or if
+ *      the output differs from the expected one
+ */
+static double bench_drain_run(const uint64_t *items, size_t n, size_t threads, uint64_t *out, const uint64_t *expected) {
+    ArenaAllocatorHandler_t arena;
+    MinHeapHandler_t heap;
+    double elapsed = -1.0;
+
+    arena_allocator_api_init(&arena);
+    if (min_heap_api_init(&heap, sizeof(uint64_t), n, bench_compare_u64, &arena) != MIN_HEAP_OK ||
+        min_heap_api_build(&heap, (void *)items, n) != MIN_HEAP_OK)
+        goto cleanup;
+
+    uint64_t start = bench_now_ns();
+    if (threads == 0) {
+        if (min_heap_api_pop_k(&heap, out, n) != n)
+            goto cleanup;
+    } else if (min_heap_api_drain_parallel(&heap, out, threads, bench_run, &threads) != MIN_HEAP_OK) {
+        goto cleanup;
+    }
+    uint64_t stop = bench_now_ns();
+
+    if (expected != NULL && memcmp(expected, out, n * sizeof(uint64_t)) != 0) {
+        fprintf(stderr, "[ERROR]: The parallel drain differs from the serial one\n");
+        goto cleanup;
+    }
+    elapsed = (double)(stop - start) / n;
+
+cleanup:
+    arena_allocator_api_free(&arena);
+    return elapsed;
+}
+
+int main(int argc, char **argv) {
+    size_t reps = 5U;
+    size_t max_threads = BENCH_MAX_THREADS;
+    const char *json_path = NULL;
+    // Set when a run fails or a parallel drain differs from the serial one
+    bool failed = false;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "r:t:j:")) != -1) {
+        switch (opt) {
+            case 'r':
+                reps = strtoul(optarg, NULL, 10);
+                break;
+            case 't':
+                max_threads = strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                json_path = optarg;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-r repetitions] [-t max threads] [-j output.json]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (reps == 0 || reps > BENCH_MAX_SAMPLES || max_threads == 0 || max_threads > BENCH_MAX_THREADS) {
+        fprintf(stderr, "[ERROR]: Repetitions must be in [1, %u] and threads in [1, %u]\n", BENCH_MAX_SAMPLES, BENCH_MAX_THREADS);
+        return EXIT_FAILURE;
+    }
+
+    const size_t max_items = bench_sizes[BENCH_ARRAY_LEN(bench_sizes) - 1];
+    uint64_t *items = malloc(max_items * sizeof(uint64_t));
+    uint64_t *expected = malloc(max_items * sizeof(uint64_t));
+    uint64_t *out = malloc(max_items * sizeof(uint64_t));
+    if (items == NULL || expected == NULL || out == NULL) {
+        fprintf(stderr, "[ERROR]: Cannot allocate the buffers\n");
+        free(items);
+        free(expected);
+        free(out);
+        return EXIT_FAILURE;
+    }
+    BenchRng_t rng;
+    bench_rng_seed(&rng, 0xD8A1ULL);
+    for (size_t i = 0; i < max_items; ++i)
+        items[i] = bench_rng_next(&rng);
+
+    BenchReport_t report;
+    if (!bench_report_open(&report, "drain", json_path)) {
+        fprintf(stderr, "[ERROR]: Cannot open %s\n", json_path);
+        free(items);
+        free(expected);
+        free(out);
+        return EXIT_FAILURE;
+    }
+
+    for (size_t s = 0; s < BENCH_ARRAY_LEN(bench_sizes); ++s) {
+        const size_t n = bench_sizes[s];
+        // The first serial drain also produces the reference output
+        double samples[BENCH_MAX_SAMPLES];
+        size_t count = 0;
+        for (size_t r = 0; r < reps; ++r) {
+            double ns = bench_drain_run(items, n, 0, expected, NULL);
+            if (ns >= 0.0)
+                samples[count++] = ns;
+            else
+                failed = true;
+        }
+        char name[128];
+        snprintf(name, sizeof(name), "serial/N=%zu", n);
+        if (count == 0) {
+            fprintf(stderr, "[ERROR]: Cannot run %s\n", name);
+            continue;
+        }
+        bench_report_case(&report, name, "ns/item", samples, count);
+
+        for (size_t t = 0; t < BENCH_ARRAY_LEN(bench_threads) && bench_threads[t] <= max_threads; ++t) {
+            count = 0;
+            for (size_t r = 0; r < reps; ++r) {
+                double ns = bench_drain_run(items, n, bench_threads[t], out, expected);
+                if (ns >= 0.0)
+                    samples[count++] = ns;
+                else
+                    failed = true;
+            }
+            snprintf(name, sizeof(name), "parallel/T=%zu/N=%zu", bench_threads[t], n);
+            if (count == 0)
+                fprintf(stderr, "[ERROR]: Cannot run %s\n", name);
+            bench_report_case(&report, name, "ns/item", samples, count);
+        }
+    }
+
+    bench_report_close(&report);
+    free(items);
+    free(expected);
+    free(out);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,311 @@
+/*!
+ * \file bench-hold-model.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Classic "hold model" benchmark of the min heap
+ *
+ * \details The heap is first filled with N items, then each step removes the
+ *      minimum and inserts it back with its key increased by a random
+ *      increment, so that the size stays constant at N.
+ *      The increments are drawn from the exponential, uniform, bimodal and
+ *      triangular distributions (all with mean 1) and the comparator cost is
+ *      swept from a plain comparison to an expensive one.
+ *      When the hardware performance counters are available their values
+ *      per hold operation are reported as well.
+ *
+ *      Usage: bench-hold-model [-r repetitions] [-s steps] [-j output.json]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench-common.h"
+#include "bench-perf.h"
+#include "min-heap-api.h"
+
+/*! \brief Default number of timed hold operations of a single repetition */
+#define BENCH_HOLD_DEFAULT_STEPS (1000000U)
+
+/*!
+ * \brief Item stored in the heap
+ */
+typedef struct {
+    double key;
+    uint64_t id;
+} BenchItem_t;
+
+/*!
+ * \brief Distribution of the key increments
+ */
+typedef enum {
+    BENCH_DIST_EXPONENTIAL,
+    BENCH_DIST_UNIFORM,
+    BENCH_DIST_BIMODAL,
+    BENCH_DIST_TRIANGULAR,
+    BENCH_DIST_COUNT
+} BenchDistribution;
+
+static const char *bench_dist_names[BENCH_DIST_COUNT] = {
+    "exponential",
+    "uniform",
+    "bimodal",
+    "triangular"
+};
+
+/*!
+ * \brief Comparator costs, expressed as the number of dummy rounds done
+ *      for every comparison
+ */
+static const struct {
+    const char *name;
+    unsigned rounds;
+} bench_cmp_costs[] = {
+    { "trivial", 0U },
+    { "light", 8U },
+    { "heavy", 64U },
+};
+
+/*! \brief Heap sizes tested */
+static const size_t bench_sizes[] = { 64U, 1024U, 16384U, 262144U };
+
+static unsigned bench_cmp_rounds = 0U;
+static volatile uint64_t bench_cmp_sink = 0U;
+
+int8_t bench_compare_item(void *a, void *b) {
+    const BenchItem_t *f = (const BenchItem_t *)a;
+    const BenchItem_t *s = (const BenchItem_t *)b;
+
+    // Simulate the cost of a complex comparator (e.g. multiple fields or indirections)
+    uint64_t h = f->id ^ s->id;
+    for (unsigned i = 0; i < bench_cmp_rounds; ++i)
+        h = (h ^ (h >> 29)) * 0xBF58476D1CE4E5B9ULL + i;
+    if (bench_cmp_rounds)
+        bench_cmp_sink = h;
+
+    if (f->key < s->key)
+        return -1;
+    return f->key == s->key ? 0 : 1;
+}
+
+static double bench_increment(BenchRng_t *rng, BenchDistribution dist) {
+    double u = bench_rng_uniform(rng);
+    switch (dist) {
+        case BENCH_DIST_EXPONENTIAL:
+            return -log(1.0 - u);
+        case BENCH_DIST_UNIFORM:
+            return 2.0 * u;
+        case BENCH_DIST_BIMODAL:
+            // 90% of short increments and 10% of long ones
+            return bench_rng_uniform(rng) < 0.9 ? 0.2 * u : 18.2 * u;
+        case BENCH_DIST_TRIANGULAR:
+            return u + bench_rng_uniform(rng);
+        default:
+            return u;
+    }
+}
+
+/*!
+ * \brief Engine under test, every priority queue built on top of
+ *      MinHeapHandler_t can be benchmarked by adding an entry to bench_engines
+ */
+typedef struct {
+    const char *name;
+    MinHeapReturnCode (*init)(MinHeapHandler_t *heap,
+                              size_t data_size,
+                              size_t capacity,
+                              int8_t (*compare)(void *, void *),
+                              ArenaAllocatorHandler_t *arena);
+    MinHeapReturnCode (*insert)(MinHeapHandler_t *heap, void *item);
+    MinHeapReturnCode (*pop)(MinHeapHandler_t *heap, void *out);
+} BenchEngine_t;
+
+static MinHeapReturnCode bench_binary_pop(MinHeapHandler_t *heap, void *out) {
+    return min_heap_api_remove(heap, 0, out);
+}
+
+static MinHeapReturnCode bench_stable_init(MinHeapHandler_t *heap,
+                                           size_t data_size,
+                                           size_t capacity,
+                                           int8_t (*compare)(void *, void *),
+                                           ArenaAllocatorHandler_t *arena) {
+    MinHeapReturnCode res = min_heap_api_init(heap, data_size, capacity, compare, arena);
+    return res == MIN_HEAP_OK ? min_heap_api_stable_init(heap, arena) : res;
+}
+
+static MinHeapReturnCode bench_keyspec_init(MinHeapHandler_t *heap,
+                                            size_t data_size,
+                                            size_t capacity,
+                                            int8_t (*compare)(void *, void *),
+                                            ArenaAllocatorHandler_t *arena) {
+    // The key is compared by the library, so the cost of the comparator is not simulated
+    (void)compare;
+    MinHeapKeyField_t key = { offsetof(BenchItem_t, key), MIN_HEAP_KEY_DOUBLE, MIN_HEAP_KEY_ASC };
+    return min_heap_api_init_keys(heap, data_size, capacity, &key, 1, arena);
+}
+
+static const BenchEngine_t bench_engines[] = {
+    { "binary", min_heap_api_init, min_heap_api_insert, bench_binary_pop },
+    { "stable", bench_stable_init, min_heap_api_insert, bench_binary_pop },
+    { "keyspec", bench_keyspec_init, min_heap_api_insert, bench_binary_pop },
+};
+
+#define BENCH_ARRAY_LEN(A) (sizeof(A) / sizeof((A)[0]))
+
+/*!
+ * \brief Run a single repetition of the hold model
+ *
+ * \details The values of the available hardware counters are divided by the
+ *      number of steps and stored in 'counters'
+ *
+ * \return double The average time of a hold operation in ns, or a negative value on error
+ */
+static double bench_hold_run(const BenchEngine_t *engine,
+                             size_t n,
+                             BenchDistribution dist,
+                             const double *increments,
+                             size_t steps,
+                             uint64_t seed,
+                             BenchPerf_t *perf,
+                             double *counters) {
+    ArenaAllocatorHandler_t arena;
+    MinHeapHandler_t heap;
+    BenchRng_t rng;
+    double elapsed = -1.0;
+
+    arena_allocator_api_init(&arena);
+    if (engine->init(&heap, sizeof(BenchItem_t), n, bench_compare_item, &arena) != MIN_HEAP_OK)
+        goto cleanup;
+
+    // Fill the heap and let it reach the steady state
+    bench_rng_seed(&rng, seed);
+    for (size_t i = 0; i < n; ++i) {
+        BenchItem_t item = { .key = bench_increment(&rng, dist), .id = i };
+        if (engine->insert(&heap, &item) != MIN_HEAP_OK)
+            goto cleanup;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        BenchItem_t item;
+        engine->pop(&heap, &item);
+        item.key += bench_increment(&rng, dist);
+        engine->insert(&heap, &item);
+    }
+
+    bench_perf_start(perf);
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < steps; ++i) {
+        BenchItem_t item;
+        engine->pop(&heap, &item);
+        item.key += increments[i];
+        engine->insert(&heap, &item);
+    }
+    uint64_t stop = bench_now_ns();
+    bench_perf_stop(perf);
+
+    elapsed = (double)(stop - start) / steps;
+    bench_perf_per_op(perf, steps, counters);
+
+cleanup:
+    arena_allocator_api_free(&arena);
+    return elapsed;
+}
+
+int main(int argc, char **argv) {
+    size_t reps = 5U;
+    size_t steps = BENCH_HOLD_DEFAULT_STEPS;
+    const char *json_path = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "r:s:j:")) != -1) {
+        switch (opt) {
+            case 'r':
+                reps = strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                steps = strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                json_path = optarg;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-r repetitions] [-s steps] [-j output.json]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (reps == 0 || reps > BENCH_MAX_SAMPLES || steps == 0) {
+        fprintf(stderr, "[ERROR]: Repetitions must be in [1, %u] and steps greater than 0\n", BENCH_MAX_SAMPLES);
+        return EXIT_FAILURE;
+    }
+
+    // Pre-generate the increments so that the generator cost is not measured
+    double *increments = malloc(steps * sizeof(double));
+    if (increments == NULL) {
+        fprintf(stderr, "[ERROR]: Cannot allocate the increments buffer\n");
+        return EXIT_FAILURE;
+    }
+
+    BenchPerf_t perf;
+    if (bench_perf_open(&perf) == 0)
+        fprintf(stderr, "[WARNING]: Hardware counters are not available, only the time is measured\n");
+
+    BenchReport_t report;
+    if (!bench_report_open(&report, "hold-model", json_path)) {
+        fprintf(stderr, "[ERROR]: Cannot open %s\n", json_path);
+        bench_perf_close(&perf);
+        free(increments);
+        return EXIT_FAILURE;
+    }
+
+    for (size_t d = 0; d < BENCH_DIST_COUNT; ++d) {
+        BenchRng_t rng;
+        bench_rng_seed(&rng, 0xC0FFEEULL + d);
+        for (size_t i = 0; i < steps; ++i)
+            increments[i] = bench_increment(&rng, (BenchDistribution)d);
+
+        for (size_t c = 0; c < BENCH_ARRAY_LEN(bench_cmp_costs); ++c) {
+            bench_cmp_rounds = bench_cmp_costs[c].rounds;
+            for (size_t s = 0; s < BENCH_ARRAY_LEN(bench_sizes); ++s) {
+                for (size_t e = 0; e < BENCH_ARRAY_LEN(bench_engines); ++e) {
+                    double samples[BENCH_MAX_SAMPLES];
+                    double counters[BENCH_PERF_COUNT][BENCH_MAX_SAMPLES];
+                    size_t counter_count[BENCH_PERF_COUNT] = { 0 };
+                    size_t count = 0;
+                    for (size_t r = 0; r < reps; ++r) {
+                        double per_op[BENCH_PERF_COUNT];
+                        double ns = bench_hold_run(&bench_engines[e], bench_sizes[s], (BenchDistribution)d, increments, steps, r + 1, &perf, per_op);
+                        if (ns < 0.0)
+                            continue;
+                        for (size_t p = 0; p < BENCH_PERF_COUNT; ++p) {
+                            if (per_op[p] >= 0.0)
+                                counters[p][counter_count[p]++] = per_op[p];
+                        }
+                        samples[count++] = ns;
+                    }
+
+                    char name[128];
+                    snprintf(name,
+                             sizeof(name),
+                             "%s/%s/%s/N=%zu",
+                             bench_engines[e].name,
+                             bench_dist_names[d],
+                             bench_cmp_costs[c].name,
+                             bench_sizes[s]);
+                    if (count == 0)
+                        fprintf(stderr, "[ERROR]: Cannot run %s\n", name);
+                    bench_report_case(&report, name, "ns/op", samples, count);
+                    bench_perf_report(&report, &perf, name, "ev/op", counters, counter_count, count);
+                }
+            }
+        }
+    }
+
+    bench_report_close(&report);
+    bench_perf_close(&perf);
+    free(increments);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,176 @@
+/*!
+ * \file bench-perf.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Hardware performance counters for the benchmark programs
+ */
+
+#define _GNU_SOURCE
+
+#include "bench-perf.h"
+
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static const char *bench_perf_names[BENCH_PERF_COUNT] = {
+    "instructions",
+    "cycles",
+    "branch-misses",
+    "l1d-misses",
+    "llc-misses",
+    "dtlb-misses"
+};
+
+#ifdef __linux__
+
+#define BENCH_PERF_CACHE_CONFIG(CACHE, OP, RESULT) \
+    ((CACHE) | ((OP) << 8) | ((RESULT) << 16))
+
+static int bench_perf_open_counter(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // Measure only the calling thread on any CPU
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+size_t bench_perf_open(BenchPerf_t *perf) {
+    static const struct {
+        uint32_t type;
+        uint64_t config;
+    } events[BENCH_PERF_COUNT] = {
+        [BENCH_PERF_INSTRUCTIONS] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        [BENCH_PERF_CYCLES] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        [BENCH_PERF_BRANCH_MISSES] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+        [BENCH_PERF_L1D_MISSES] = { PERF_TYPE_HW_CACHE,
+                                    BENCH_PERF_CACHE_CONFIG(PERF_COUNT_HW_CACHE_L1D,
+                                                            PERF_COUNT_HW_CACHE_OP_READ,
+                                                            PERF_COUNT_HW_CACHE_RESULT_MISS) },
+        [BENCH_PERF_LLC_MISSES] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        [BENCH_PERF_DTLB_MISSES] = { PERF_TYPE_HW_CACHE,
+                                     BENCH_PERF_CACHE_CONFIG(PERF_COUNT_HW_CACHE_DTLB,
+                                                             PERF_COUNT_HW_CACHE_OP_READ,
+                                                             PERF_COUNT_HW_CACHE_RESULT_MISS) },
+    };
+
+    size_t available = 0;
+    for (size_t i = 0; i < BENCH_PERF_COUNT; ++i) {
+        perf->fd[i] = bench_perf_open_counter(events[i].type, events[i].config);
+        perf->values[i] = 0;
+        perf->valid[i] = perf->fd[i] >= 0;
+        if (perf->fd[i] >= 0)
+            ++available;
+    }
+    return available;
+}
+
+void bench_perf_start(BenchPerf_t *perf) {
+    for (size_t i = 0; i < BENCH_PERF_COUNT; ++i) {
+        if (perf->fd[i] < 0)
+            continue;
+        ioctl(perf->fd[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(perf->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void bench_perf_stop(BenchPerf_t *perf) {
+    for (size_t i = 0; i < BENCH_PERF_COUNT; ++i) {
+        if (perf->fd[i] >= 0)
+            ioctl(perf->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (size_t i = 0; i < BENCH_PERF_COUNT; ++i) {
+        perf->values[i] = 0;
+        perf->valid[i] = false;
+        if (perf->fd[i] < 0)
+            continue;
+
+        // Value, time enabled and time running, a counter that never ran has no value
+        uint64_t buf[3];
+        if (read(perf->fd[i], buf, sizeof(buf)) != (ssize_t)sizeof(buf) || buf[2] == 0)
+            continue;
+        perf->valid[i] = true;
+        perf->values[i] = buf[2] < buf[1]
+                              ? (uint64_t)((double)buf[0] * buf[1] / buf[2])
+                              : buf[0];
+    }
+}
+
+void bench_perf_close(BenchPerf_t *perf) {
+    for (size_t i = 0; i < BENCH_PERF_COUNT; ++i) {
+        if (perf->fd[i] >= 0)
+            close(perf->fd[i]);
+        perf->fd[i] = -1;
+    }
+}
+
+#else
+
+size_t bench_perf_open(BenchPerf_t *perf) {
+    for (size_t i = 0; i < BENCH_PERF_COUNT; ++i) {
+        perf->fd[i] = -1;
+        perf->values[i] = 0;
+        perf->valid[i] = false;
+    }
+    return 0;
+}
+
+void bench_perf_start(BenchPerf_t *perf) {
+    (void)perf;
+}
+
+void bench_perf_stop(BenchPerf_t *perf) {
+    (void)perf;
+}
+
+void bench_perf_close(BenchPerf_t *perf) {
+    (void)perf;
+}
+
+#endif
+
+bool bench_perf_available(const BenchPerf_t *perf, BenchPerfCounter counter) {
+    return counter < BENCH_PERF_COUNT && perf->fd[counter] >= 0 && perf->valid[counter];
+}
+
+const char *bench_perf_name(BenchPerfCounter counter) {
+    return counter < BENCH_PERF_COUNT ? bench_perf_names[counter] : "unknown";
+}
+
+void bench_perf_per_op(const BenchPerf_t *perf, size_t ops, double counters[BENCH_PERF_COUNT]) {
+    // A negative value marks a counter that was not measured in this run
+    for (size_t i = 0; i < BENCH_PERF_COUNT; ++i)
+        counters[i] = bench_perf_available(perf, (BenchPerfCounter)i) ? (double)perf->values[i] / ops : -1.0;
+}
+
+void bench_perf_report(BenchReport_t *report,
+                       const BenchPerf_t *perf,
+                       const char *name,
+                       const char *unit,
+                       double counters[BENCH_PERF_COUNT][BENCH_MAX_SAMPLES],
+                       const size_t counter_count[BENCH_PERF_COUNT],
+                       size_t runs) {
+    for (size_t p = 0; p < BENCH_PERF_COUNT; ++p) {
+        // The counters that could not be opened are not reported at all
+        if (perf->fd[p] < 0)
+            continue;
+        char counter_name[160];
+        snprintf(counter_name, sizeof(counter_name), "%s:%s", name, bench_perf_name((BenchPerfCounter)p));
+        if (counter_count[p] == 0 && runs > 0)
+            printf("%-56s %10s (not measured, multiplexed out)\n", counter_name, "n/a");
+        bench_report_case(report, counter_name, unit, counters[p], counter_count[p]);
+    }
+}
@@ -0,0 +1,139 @@
+/*!
+ * \file bench-perf.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Hardware performance counters for the benchmark programs
+ *
+ * \details On Linux the counters are read with the perf_event_open system call,
+ *      each counter is opened on its own so that the unsupported ones
+ *      (e.g. inside containers or virtual machines, or when
+ *      /proc/sys/kernel/perf_event_paranoid is too restrictive) are simply
+ *      marked as unavailable and skipped.
+ *      On other systems every counter is always unavailable.
+ */
+
+#ifndef BENCH_PERF_H
+#define BENCH_PERF_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "bench-common.h"
+
+/*!
+ * \brief List of the supported hardware counters
+ */
+typedef enum {
+    BENCH_PERF_INSTRUCTIONS,
+    BENCH_PERF_CYCLES,
+    BENCH_PERF_BRANCH_MISSES,
+    BENCH_PERF_L1D_MISSES,
+    BENCH_PERF_LLC_MISSES,
+    BENCH_PERF_DTLB_MISSES,
+    BENCH_PERF_COUNT
+} BenchPerfCounter;
+
+/*!
+ * \struct BenchPerf_t
+ * \brief Handler of the set of hardware counters
+ *
+ * \var int fd
+ *      File descriptors of the counters, negative if unavailable
+ * \var uint64_t values
+ *      Values measured between the last start and stop calls
+ * \var bool valid
+ *      False if the counter did not run at all between the last start and
+ *      stop calls (e.g. the kernel multiplexed it out for the whole region)
+ */
+typedef struct {
+    int fd[BENCH_PERF_COUNT];
+    uint64_t values[BENCH_PERF_COUNT];
+    bool valid[BENCH_PERF_COUNT];
+} BenchPerf_t;
+
+/*!
+ * \brief Open all the hardware counters
+ *
+ * \param perf The counters handler
+ * \return size_t The number of available counters
+ */
+size_t bench_perf_open(BenchPerf_t *perf);
+
+/*!
+ * \brief Check if a counter is available
+ * \details After a measurement a counter that never ran is unavailable until
+ *      the next one, so its value must be reported as missing and not as zero
+ *
+ * \param perf The counters handler
+ * \param counter The counter to check
+ * \return bool True if the counter can be read and its last value is valid, false otherwise
+ */
+bool bench_perf_available(const BenchPerf_t *perf, BenchPerfCounter counter);
+
+/*!
+ * \brief Get the short name of a counter (e.g. "instructions")
+ *
+ * \param counter The counter
+ * \return const char * The name of the counter
+ */
+const char *bench_perf_name(BenchPerfCounter counter);
+
+/*!
+ * \brief Reset and enable all the available counters
+ *
+ * \param perf The counters handler
+ */
+void bench_perf_start(BenchPerf_t *perf);
+
+/*!
+ * \brief Disable all the counters and read their values
+ * \details If the kernel multiplexed the counters the values are scaled
+ *      by the ratio between the enabled and the running time, a counter
+ *      that never ran is marked as unavailable for this measurement
+ *
+ * \param perf The counters handler
+ */
+void bench_perf_stop(BenchPerf_t *perf);
+
+/*!
+ * \brief Get the values of the last measurement divided by the number of operations
+ *
+ * \param perf The counters handler
+ * \param ops The number of measured operations
+ * \param counters The value of each counter per operation, negative if the
+ *      counter was not measured
+ */
+void bench_perf_per_op(const BenchPerf_t *perf, size_t ops, double counters[BENCH_PERF_COUNT]);
+
+/*!
+ * \brief Report the counters of a benchmark case, one case for each opened counter
+ * \details Only the runs where a counter ran are reported, a counter that was
+ *      multiplexed out in every run is printed as missing and never as zero
+ *
+ * \param report The reporter handler
+ * \param perf The counters handler
+ * \param name The name of the benchmark case, the name of the counter is appended to it
+ * \param unit The unit of measure of the counters (e.g. "ev/op")
+ * \param counters The values of each counter, one for each run where it ran
+ * \param counter_count The number of values of each counter
+ * \param runs The number of successful runs of the case
+ */
+void bench_perf_report(BenchReport_t *report,
+                       const BenchPerf_t *perf,
+                       const char *name,
+                       const char *unit,
+                       double counters[BENCH_PERF_COUNT][BENCH_MAX_SAMPLES],
+                       const size_t counter_count[BENCH_PERF_COUNT],
+                       size_t runs);
+
+/*!
+ * \brief Close all the hardware counters
+ *
+ * \param perf The counters handler
+ */
+void bench_perf_close(BenchPerf_t *perf);
+
+#endif
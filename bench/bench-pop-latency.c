@@ -0,0 +1,196 @@
+/*!
+ * \file bench-pop-latency.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Latency of the removal of the minimum with and without the cache
+ *      of the smallest items
+ *
+ * \details The heap is kept at a steady size N with the hold model (each
+ *      step removes the minimum and inserts it back with its key increased
+ *      by an exponential increment), only the removals are timed one by one.
+ *      The mean, the median and the 99th percentile of the latency are
+ *      reported for a plain heap and for the cached heap with 16 items.
+ *
+ *      Usage: bench-pop-latency [-r repetitions] [-s steps] [-j output.json]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench-common.h"
+#include "min-heap-api.h"
+#include "min-heap-cached-api.h"
+
+/*! \brief Default number of timed removals of a single repetition */
+#define BENCH_POP_DEFAULT_STEPS (200000U)
+
+/*! \brief Number of items of the cache */
+#define BENCH_POP_CACHE_SIZE (16U)
+
+#define BENCH_ARRAY_LEN(A) (sizeof(A) / sizeof((A)[0]))
+
+/*! \brief Heap sizes tested */
+static const size_t bench_sizes[] = { 64U, 1024U, 16384U, 262144U };
+
+int8_t bench_compare_key(void *a, void *b) {
+    double f = *(double *)a;
+    double s = *(double *)b;
+    if (f < s)
+        return -1;
+    return f == s ? 0 : 1;
+}
+
+/*!
+ * \brief Queue under test, the plain heap is the cache handler's own heap
+ */
+typedef struct {
+    const char *name;
+    MinHeapReturnCode (*insert)(MinHeapCachedHandler_t *cached, void *item);
+    MinHeapReturnCode (*pop)(MinHeapCachedHandler_t *cached, void *out);
+} BenchEngine_t;
+
+static MinHeapReturnCode bench_binary_insert(MinHeapCachedHandler_t *cached, void *item) {
+    return min_heap_api_insert(&cached->heap, item);
+}
+
+static MinHeapReturnCode bench_binary_pop(MinHeapCachedHandler_t *cached, void *out) {
+    return min_heap_api_remove(&cached->heap, 0, out);
+}
+
+static const BenchEngine_t bench_engines[] = {
+    { "binary", bench_binary_insert, bench_binary_pop },
+    { "cached", min_heap_cached_api_insert, min_heap_cached_api_pop },
+};
+
+static int bench_compare_latency(const void *a, const void *b) {
+    double f = *(const double *)a;
+    double s = *(const double *)b;
+    return (f > s) - (f < s);
+}
+
+/*!
+ * \brief Run a single repetition
+ *
+ * \param stats Where to store the mean, the median and the 99th percentile in ns
+ * \return bool False on error
+ */
+static bool bench_pop_run(const BenchEngine_t *engine, size_t n, size_t steps, uint64_t seed, double *latencies, double *stats) {
+    ArenaAllocatorHandler_t arena;
+    MinHeapCachedHandler_t cached;
+    BenchRng_t rng;
+    bool ok = false;
+
+    arena_allocator_api_init(&arena);
+    if (min_heap_cached_api_init(&cached, sizeof(double), n, BENCH_POP_CACHE_SIZE, bench_compare_key, &arena) != MIN_HEAP_OK)
+        goto cleanup;
+
+    bench_rng_seed(&rng, seed);
+    for (size_t i = 0; i < n; ++i) {
+        double key = -log(1.0 - bench_rng_uniform(&rng));
+        if (engine->insert(&cached, &key) != MIN_HEAP_OK)
+            goto cleanup;
+    }
+
+    double total = 0.0;
+    for (size_t i = 0; i < n + steps; ++i) {
+        double key;
+        uint64_t start = bench_now_ns();
+        engine->pop(&cached, &key);
+        uint64_t stop = bench_now_ns();
+        key += -log(1.0 - bench_rng_uniform(&rng));
+        engine->insert(&cached, &key);
+
+        // The first n steps bring the heap to the steady state
+        if (i >= n) {
+            latencies[i - n] = (double)(stop - start);
+            total += latencies[i - n];
+        }
+    }
+
+    qsort(latencies, steps, sizeof(double), bench_compare_latency);
+    stats[0] = total / steps;
+    stats[1] = latencies[steps / 2];
+    stats[2] = latencies[steps * 99 / 100];
+    ok = true;
+
+cleanup:
+    arena_allocator_api_free(&arena);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    size_t reps = 5U;
+    size_t steps = BENCH_POP_DEFAULT_STEPS;
+    const char *json_path = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "r:s:j:")) != -1) {
+        switch (opt) {
+            case 'r':
+                reps = strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                steps = strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                json_path = optarg;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-r repetitions] [-s steps] [-j output.json]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (reps == 0 || reps > BENCH_MAX_SAMPLES || steps == 0) {
+        fprintf(stderr, "[ERROR]: Repetitions must be in [1, %u] and steps greater than 0\n", BENCH_MAX_SAMPLES);
+        return EXIT_FAILURE;
+    }
+
+    double *latencies = malloc(steps * sizeof(double));
+    if (latencies == NULL) {
+        fprintf(stderr, "[ERROR]: Cannot allocate the latencies buffer\n");
+        return EXIT_FAILURE;
+    }
+
+    BenchReport_t report;
+    if (!bench_report_open(&report, "pop-latency", json_path)) {
+        fprintf(stderr, "[ERROR]: Cannot open %s\n", json_path);
+        free(latencies);
+        return EXIT_FAILURE;
+    }
+
+    static const char *metrics[3] = { "", ":p50", ":p99" };
+    for (size_t s = 0; s < BENCH_ARRAY_LEN(bench_sizes); ++s) {
+        for (size_t e = 0; e < BENCH_ARRAY_LEN(bench_engines); ++e) {
+            double samples[3][BENCH_MAX_SAMPLES];
+            size_t count = 0;
+            for (size_t r = 0; r < reps; ++r) {
+                double stats[3];
+                if (!bench_pop_run(&bench_engines[e], bench_sizes[s], steps, r + 1, latencies, stats))
+                    continue;
+                for (size_t m = 0; m < 3; ++m)
+                    samples[m][count] = stats[m];
+                ++count;
+            }
+
+            char name[128];
+            snprintf(name, sizeof(name), "%s/N=%zu", bench_engines[e].name, bench_sizes[s]);
+            if (count == 0)
+                fprintf(stderr, "[ERROR]: Cannot run %s\n", name);
+            for (size_t m = 0; m < 3; ++m) {
+                char metric_name[160];
+                snprintf(metric_name, sizeof(metric_name), "%s%s", name, metrics[m]);
+                bench_report_case(&report, metric_name, "ns/pop", samples[m], count);
+            }
+        }
+    }
+
+    bench_report_close(&report);
+    free(latencies);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,214 @@
+/*!
+ * \file bench-selector.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Benchmark of the selector of the least loaded worker against a
+ *      removal of the root followed by an insertion
+ *
+ * \details N workers (1024 by default) execute jobs of random cost in [1, 16].
+ *      Each step acquires the least loaded worker for a new job and releases
+ *      a random job among the BENCH_SELECTOR_JOBS_PER_WORKER * N in progress.
+ *      The selector changes the load in place with a single sift, the baseline
+ *      uses the same addressable heap but removes the item and inserts it
+ *      again with the new load. The time per step (one acquisition and one
+ *      release) is reported.
+ *
+ *      Usage: bench-selector [-r repetitions] [-s steps] [-n workers] [-j output.json]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench-common.h"
+#include "min-heap-api.h"
+#include "min-heap-selector-api.h"
+
+/*! \brief Default number of timed steps of a single repetition */
+#define BENCH_SELECTOR_DEFAULT_STEPS (2000000U)
+
+/*! \brief Default number of workers */
+#define BENCH_SELECTOR_DEFAULT_WORKERS (1024U)
+
+/*! \brief Number of jobs in progress for each worker */
+#define BENCH_SELECTOR_JOBS_PER_WORKER (4U)
+
+/*!
+ * \brief A job in progress
+ */
+typedef struct {
+    uint32_t worker;
+    uint32_t cost;
+} BenchJob_t;
+
+/*!
+ * \brief Item of the baseline heap, the same layout of the selector
+ */
+typedef struct {
+    uint64_t load;
+    uint32_t worker;
+} BenchWorker_t;
+
+/*!
+ * \brief Baseline acquisition, remove the root and insert it again
+ */
+static size_t bench_baseline_acquire(MinHeapHandler_t *heap, uint32_t cost) {
+    BenchWorker_t item;
+    min_heap_api_remove(heap, 0, &item);
+    item.load += cost;
+    min_heap_api_insert(heap, &item);
+    return item.worker;
+}
+
+/*!
+ * \brief Baseline release, remove the item of the worker and insert it again
+ */
+static void bench_baseline_release(MinHeapHandler_t *heap, uint32_t worker, uint32_t cost) {
+    BenchWorker_t item;
+    min_heap_api_remove(heap, (size_t)min_heap_api_position(heap, worker), &item);
+    item.load -= cost;
+    min_heap_api_insert(heap, &item);
+}
+
+/*!
+ * \brief Run a single repetition
+ *
+ * \return double The time per step in ns, or a negative value on error
+ */
+static double bench_selector_run(bool baseline, size_t workers, size_t steps, uint64_t seed) {
+    ArenaAllocatorHandler_t arena;
+    MinHeapSelectorHandler_t selector;
+    MinHeapHandler_t heap;
+    BenchRng_t rng;
+    double elapsed = -1.0;
+
+    arena_allocator_api_init(&arena);
+    const size_t job_count = workers * BENCH_SELECTOR_JOBS_PER_WORKER;
+    BenchJob_t *jobs = arena_allocator_api_calloc(&arena, sizeof(BenchJob_t), job_count);
+    if (jobs == NULL)
+        goto cleanup;
+    if (baseline) {
+        const MinHeapKeyField_t keys[] = {
+            { offsetof(BenchWorker_t, load), MIN_HEAP_KEY_U64, MIN_HEAP_KEY_ASC },
+            { offsetof(BenchWorker_t, worker), MIN_HEAP_KEY_U32, MIN_HEAP_KEY_ASC },
+        };
+        if (min_heap_api_init_keys(&heap, sizeof(BenchWorker_t), workers, keys, 2, &arena) != MIN_HEAP_OK ||
+            min_heap_api_handles_init(&heap, offsetof(BenchWorker_t, worker), workers, &arena) != MIN_HEAP_OK)
+            goto cleanup;
+        for (size_t i = 0; i < workers; ++i) {
+            BenchWorker_t item = { 0, (uint32_t)i };
+            min_heap_api_insert(&heap, &item);
+        }
+    } else if (min_heap_selector_api_init(&selector, workers, &arena) != MIN_HEAP_OK) {
+        goto cleanup;
+    }
+
+    // Fill the workers with the jobs in progress
+    bench_rng_seed(&rng, seed);
+    for (size_t i = 0; i < job_count; ++i) {
+        size_t worker;
+        jobs[i].cost = 1U + (uint32_t)(bench_rng_next(&rng) % 16U);
+        if (baseline)
+            worker = bench_baseline_acquire(&heap, jobs[i].cost);
+        else
+            min_heap_selector_api_acquire(&selector, jobs[i].cost, &worker);
+        jobs[i].worker = (uint32_t)worker;
+    }
+
+    uint64_t checksum = 0;
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < steps; ++i) {
+        BenchJob_t *job = &jobs[bench_rng_next(&rng) % job_count];
+        uint32_t cost = 1U + (uint32_t)(bench_rng_next(&rng) % 16U);
+        size_t worker;
+        if (baseline) {
+            bench_baseline_release(&heap, job->worker, job->cost);
+            worker = bench_baseline_acquire(&heap, cost);
+        } else {
+            min_heap_selector_api_release(&selector, job->worker, job->cost);
+            min_heap_selector_api_acquire(&selector, cost, &worker);
+        }
+        job->worker = (uint32_t)worker;
+        job->cost = cost;
+        checksum += worker;
+    }
+    uint64_t stop = bench_now_ns();
+
+    // Keep the loop from being optimized away
+    if (checksum == 0)
+        fprintf(stderr, "[WARNING]: Every job went to the first worker\n");
+    elapsed = (double)(stop - start) / steps;
+
+cleanup:
+    arena_allocator_api_free(&arena);
+    return elapsed;
+}
+
+int main(int argc, char **argv) {
+    size_t reps = 5U;
+    size_t steps = BENCH_SELECTOR_DEFAULT_STEPS;
+    size_t workers = BENCH_SELECTOR_DEFAULT_WORKERS;
+    const char *json_path = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "r:s:n:j:")) != -1) {
+        switch (opt) {
+            case 'r':
+                reps = strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                steps = strtoul(optarg, NULL, 10);
+                break;
+            case 'n':
+                workers = strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                json_path = optarg;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-r repetitions] [-s steps] [-n workers] [-j output.json]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (reps == 0 || reps > BENCH_MAX_SAMPLES || steps == 0 || workers == 0 || workers > UINT32_MAX / BENCH_SELECTOR_JOBS_PER_WORKER) {
+        fprintf(stderr, "[ERROR]: Repetitions must be in [1, %u], steps and workers greater than 0\n", BENCH_MAX_SAMPLES);
+        return EXIT_FAILURE;
+    }
+
+    BenchReport_t report;
+    if (!bench_report_open(&report, "selector", json_path)) {
+        fprintf(stderr, "[ERROR]: Cannot open %s\n", json_path);
+        return EXIT_FAILURE;
+    }
+
+    static const struct {
+        const char *name;
+        bool baseline;
+    } modes[] = {
+        { "remove+insert", true },
+        { "update", false },
+    };
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m) {
+        double samples[BENCH_MAX_SAMPLES];
+        size_t count = 0;
+        for (size_t r = 0; r < reps; ++r) {
+            double ns = bench_selector_run(modes[m].baseline, workers, steps, r + 1);
+            if (ns >= 0.0)
+                samples[count++] = ns;
+        }
+
+        char name[128];
+        snprintf(name, sizeof(name), "%s/N=%zu", modes[m].name, workers);
+        if (count == 0)
+            fprintf(stderr, "[ERROR]: Cannot run %s\n", name);
+        bench_report_case(&report, name, "ns/step", samples, count);
+    }
+
+    bench_report_close(&report);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/*!
+ * \file bench-wfq.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Throughput benchmark of the weighted fair queuing scheduler
+ *
+ * \details F flows with random weights in [1, 16] are kept backlogged with
+ *      BENCH_WFQ_BACKLOG packets each. Each step sends a packet and enqueues
+ *      a new one (random length in [64, 1500]) in a random flow, so the number
+ *      of waiting packets stays constant. The time per step is reported for
+ *      both policies and for 100 to 10000 flows.
+ *
+ *      Usage: bench-wfq [-r repetitions] [-s steps] [-j output.json]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench-common.h"
+#include "min-heap-wfq-api.h"
+
+/*! \brief Default number of timed steps of a single repetition */
+#define BENCH_WFQ_DEFAULT_STEPS (1000000U)
+
+/*! \brief Number of packets waiting in each flow at the start */
+#define BENCH_WFQ_BACKLOG (4U)
+
+#define BENCH_ARRAY_LEN(A) (sizeof(A) / sizeof((A)[0]))
+
+/*! \brief Numbers of flows tested */
+static const size_t bench_flows[] = { 100U, 1000U, 10000U };
+
+static const struct {
+    const char *name;
+    MinHeapWfqMode mode;
+} bench_modes[] = {
+    { "wfq", MIN_HEAP_WFQ_MODE_WFQ },
+    { "wf2q", MIN_HEAP_WFQ_MODE_WF2Q },
+};
+
+/*!
+ * \brief Payload of a packet, e.g. a reference to its buffer
+ */
+typedef struct {
+    uint32_t buffer;
+    uint32_t offset;
+} BenchPacket_t;
+
+static uint32_t bench_length(BenchRng_t *rng) {
+    return 64U + (uint32_t)(bench_rng_next(rng) % (1500U - 64U + 1U));
+}
+
+/*!
+ * \brief Run a single repetition
+ *
+ * \return double The time per step in ns, or a negative value on error
+ */
+static double bench_wfq_run(MinHeapWfqMode mode, size_t flows, size_t steps, uint64_t seed) {
+    ArenaAllocatorHandler_t arena;
+    MinHeapWfqHandler_t wfq;
+    BenchRng_t rng;
+    double elapsed = -1.0;
+
+    arena_allocator_api_init(&arena);
+    if (min_heap_wfq_api_init(&wfq, mode, flows, flows * BENCH_WFQ_BACKLOG, sizeof(BenchPacket_t), &arena) != MIN_HEAP_OK)
+        goto cleanup;
+
+    bench_rng_seed(&rng, seed);
+    for (size_t f = 0; f < flows; ++f)
+        min_heap_wfq_api_set_weight(&wfq, f, 1U + (uint32_t)(bench_rng_next(&rng) % 16U));
+    for (size_t i = 0; i < BENCH_WFQ_BACKLOG; ++i) {
+        for (size_t f = 0; f < flows; ++f) {
+            BenchPacket_t packet = { (uint32_t)f, (uint32_t)i };
+            if (min_heap_wfq_api_enqueue(&wfq, f, bench_length(&rng), &packet) != MIN_HEAP_OK)
+                goto cleanup;
+        }
+    }
+
+    uint64_t checksum = 0;
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < steps; ++i) {
+        BenchPacket_t packet;
+        size_t flow;
+        uint32_t length;
+        min_heap_wfq_api_dequeue(&wfq, &flow, &length, &packet);
+        checksum += flow + length;
+        min_heap_wfq_api_enqueue(&wfq, (size_t)(bench_rng_next(&rng) % flows), bench_length(&rng), &packet);
+    }
+    uint64_t stop = bench_now_ns();
+
+    // Keep the loop from being optimized away
+    if (checksum == 0)
+        fprintf(stderr, "[WARNING]: Nothing was sent\n");
+    elapsed = (double)(stop - start) / steps;
+
+cleanup:
+    arena_allocator_api_free(&arena);
+    return elapsed;
+}
+
+int main(int argc, char **argv) {
+    size_t reps = 5U;
+    size_t steps = BENCH_WFQ_DEFAULT_STEPS;
+    const char *json_path = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "r:s:j:")) != -1) {
+        switch (opt) {
+            case 'r':
+                reps = strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                steps = strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                json_path = optarg;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-r repetitions] [-s steps] [-j output.json]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (reps == 0 || reps > BENCH_MAX_SAMPLES || steps == 0) {
+        fprintf(stderr, "[ERROR]: Repetitions must be in [1, %u] and steps greater than 0\n", BENCH_MAX_SAMPLES);
+        return EXIT_FAILURE;
+    }
+
+    BenchReport_t report;
+    if (!bench_report_open(&report, "wfq", json_path)) {
+        fprintf(stderr, "[ERROR]: Cannot open %s\n", json_path);
+        return EXIT_FAILURE;
+    }
+
+    for (size_t f = 0; f < BENCH_ARRAY_LEN(bench_flows); ++f) {
+        for (size_t m = 0; m < BENCH_ARRAY_LEN(bench_modes); ++m) {
+            double samples[BENCH_MAX_SAMPLES];
+            size_t count = 0;
+            for (size_t r = 0; r < reps; ++r) {
+                double ns = bench_wfq_run(bench_modes[m].mode, bench_flows[f], steps, r + 1);
+                if (ns >= 0.0)
+                    samples[count++] = ns;
+            }
+
+            char name[128];
+            snprintf(name, sizeof(name), "%s/F=%zu", bench_modes[m].name, bench_flows[f]);
+            if (count == 0)
+                fprintf(stderr, "[ERROR]: Cannot run %s\n", name);
+            bench_report_case(&report, name, "ns/packet", samples, count);
+        }
+    }
+
+    bench_report_close(&report);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,102 @@
+/*!
+ * \file min-heap-aggregator-api.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that finds the global minimum of a group of min heaps
+ *      in constant time
+ *
+ * \details The aggregator keeps a tournament tree over the top items of the
+ *      member heaps, every change of the top of a member costs O(log N)
+ *      comparisons where N is the number of members.
+ *      All the members must contain the same type of items and use the same
+ *      compare function.
+ *
+ * \warning If a member heap is modified directly (i.e. without the functions
+ *      of the aggregator) min_heap_aggregator_api_update has to be called
+ *      before using the aggregator again.
+ */
+
+#ifndef MIN_HEAP_AGGREGATOR_API_H
+#define MIN_HEAP_AGGREGATOR_API_H
+
+#include "min-heap-aggregator.h"
+#include "arena-allocator-api.h"
+
+/*!
+ * \brief Initialize the aggregator over a group of heaps
+ * \attention The array of heaps is not copied and has to stay valid
+ *
+ * \param agg The aggregator handler
+ * \param heaps The array of member heaps, each one already initialized
+ * \param count The number of member heaps
+ * \param arena The arena allocator handler needed to allocate the tournament tree
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the aggregator, the heaps or the arena are NULL
+ *       or if the tree cannot be allocated
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the number of heaps is zero
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_aggregator_api_init(
+    MinHeapAggregatorHandler_t *agg,
+    MinHeapHandler_t **heaps,
+    size_t count,
+    ArenaAllocatorHandler_t *arena);
+
+/*!
+ * \brief Refresh the tournament tree after the top of a member has changed
+ *
+ * \param agg The aggregator handler
+ * \param member The index of the changed member
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the aggregator is NULL
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the member does not exist
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_aggregator_api_update(MinHeapAggregatorHandler_t *agg, size_t member);
+
+/*!
+ * \brief Insert an item in a member heap and refresh the tournament tree
+ *
+ * \param agg The aggregator handler
+ * \param member The index of the member
+ * \param item The item to insert
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the member does not exist
+ *     - The same values of min_heap_api_insert otherwise
+ */
+MinHeapReturnCode min_heap_aggregator_api_insert(MinHeapAggregatorHandler_t *agg, size_t member, void *item);
+
+/*!
+ * \brief Get the index of the member that contains the global minimum
+ *
+ * \param agg The aggregator handler
+ * \return signed_size_t The index of the member, -1 if all the members are empty
+ */
+signed_size_t min_heap_aggregator_api_top_member(const MinHeapAggregatorHandler_t *agg);
+
+/*!
+ * \brief Get a reference to the global minimum
+ * \attention The return value can be NULL
+ *
+ * \param agg The aggregator handler
+ * \return void * A pointer to the minimum element of all the members
+ */
+void *min_heap_aggregator_api_peek(const MinHeapAggregatorHandler_t *agg);
+
+/*!
+ * \brief Remove the global minimum and refresh the tournament tree
+ * \attention 'out' and 'member' can be NULL
+ *
+ * \param agg The aggregator handler
+ * \param out The removed item (has to be an address)
+ * \param member The index of the member the item was removed from
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the aggregator is NULL
+ *     - MIN_HEAP_EMPTY if all the members are empty
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_aggregator_api_pop(MinHeapAggregatorHandler_t *agg, void *out, size_t *member);
+
+#endif
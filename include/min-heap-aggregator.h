@@ -0,0 +1,49 @@
+/*!
+ * \file min-heap-aggregator.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that defines the structure of an aggregator of min heaps
+ *
+ * \details The aggregator keeps a tournament tree over the top items of a
+ *      group of heaps, the root of the tree is the member with the global
+ *      minimum. Every node stores the index of the member that wins the
+ *      comparison between its two children, so when the top of a member
+ *      changes only the path from its leaf to the root is updated.
+ */
+
+#ifndef MIN_HEAP_AGGREGATOR_H
+#define MIN_HEAP_AGGREGATOR_H
+
+#include "min-heap.h"
+
+/*!
+ * \brief Value of a tournament tree node without any non-empty member
+ */
+#define MIN_HEAP_AGGREGATOR_NONE (SIZE_MAX)
+
+/*!
+ * \struct MinHeapAggregatorHandler_t
+ *
+ * \var MinHeapHandler_t **heaps
+ *       The member heaps
+ *
+ * \var size_t count
+ *       The number of member heaps
+ *
+ * \var size_t leaves
+ *       The number of leaves of the tournament tree (power of two)
+ *
+ * \var size_t *tree
+ *       The tournament tree, the root is at index 1 and the leaf of the
+ *       i-th member is at index leaves + i
+ */
+typedef struct {
+    MinHeapHandler_t **heaps;
+    size_t count;
+    size_t leaves;
+    size_t *tree;
+} MinHeapAggregatorHandler_t;
+
+#endif
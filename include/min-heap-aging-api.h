@@ -0,0 +1,108 @@
+/*!
+ * \file min-heap-aging-api.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that implements a priority queue with aging, where waiting
+ *      items gain priority so that low priority items cannot starve
+ *
+ * \details Instead of periodically decreasing the priority of every item,
+ *      which costs O(N log N) per tick, each item is keyed by the virtual
+ *      time priority * period + enqueue time (see min-heap-aging.h), which
+ *      orders the items by their effective priority at any time.
+ *      Insertions and removals cost O(log N) and nothing has to be done while
+ *      the time goes on. An item with base priority p inserted at time e is
+ *      served before every item with base priority q inserted after
+ *      e + (p - q) * period, so its waiting time is bounded.
+ */
+
+#ifndef MIN_HEAP_AGING_API_H
+#define MIN_HEAP_AGING_API_H
+
+#include "min-heap-aging.h"
+#include "arena-allocator-api.h"
+
+/*!
+ * \brief Initialize the priority queue with aging
+ *
+ * \param aging The aging queue handler
+ * \param payload_size The size of the payload of each item (can be zero)
+ * \param capacity The maximum number of items
+ * \param period The waiting time after which the effective priority decreases by one
+ * \param arena The arena allocator handler needed to allocate the buffers
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler or the arena are NULL
+ *       or if the buffers cannot be allocated
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the period is zero
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_aging_api_init(
+    MinHeapAgingHandler_t *aging,
+    size_t payload_size,
+    size_t capacity,
+    uint32_t period,
+    ArenaAllocatorHandler_t *arena);
+
+/*!
+ * \brief Get the number of items of the queue
+ *
+ * \param aging The aging queue handler
+ * \return size_t The number of items in the heap
+ */
+size_t min_heap_aging_api_size(const MinHeapAgingHandler_t *aging);
+
+/*!
+ * \brief Remove all the items of the queue
+ *
+ * \param aging The aging queue handler
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler is NULL
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_aging_api_clear(MinHeapAgingHandler_t *aging);
+
+/*!
+ * \brief Insert an item
+ * \attention 'payload' can be NULL only if the payload size is zero
+ *
+ * \param aging The aging queue handler
+ * \param priority The base priority of the item (lower is more urgent)
+ * \param now The current time, used as the enqueue time of the item
+ * \param payload The payload of the item
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler or the payload are NULL
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the virtual time of the item does not fit in 64 bits
+ *     - MIN_HEAP_FULL if the heap is full
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_aging_api_insert(MinHeapAgingHandler_t *aging, int32_t priority, uint64_t now, const void *payload);
+
+/*!
+ * \brief Get the item with the lowest effective priority
+ * \attention The return value can be NULL
+ *
+ * \param aging The aging queue handler
+ * \param now The current time
+ * \param priority The effective priority of the item at the current time,
+ *      saturated to the range of int32_t (can be NULL)
+ * \return void * A pointer to the payload of the item
+ */
+void *min_heap_aging_api_peek(const MinHeapAgingHandler_t *aging, uint64_t now, int32_t *priority);
+
+/*!
+ * \brief Remove the item with the lowest effective priority
+ * \attention 'priority' and 'payload' can be NULL
+ *
+ * \param aging The aging queue handler
+ * \param now The current time
+ * \param priority The effective priority of the removed item at the current time
+ * \param payload The payload of the removed item (has to be an address)
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler is NULL
+ *     - MIN_HEAP_EMPTY if the queue is empty
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_aging_api_pop(MinHeapAgingHandler_t *aging, uint64_t now, int32_t *priority, void *payload);
+
+#endif
@@ -0,0 +1,42 @@
+/*!
+ * \file min-heap-aging.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that defines the structure of a priority queue whose items
+ *      gain priority while they wait (aging)
+ *
+ * \details The effective priority of an item inserted at time e with base
+ *      priority p is p - (t - e) / period at time t (lower is more urgent).
+ *      Since all the items age at the same rate, the order of two items never
+ *      changes: comparing p_a - (t - e_a) / period with p_b - (t - e_b) / period
+ *      is the same as comparing p_a * period + e_a with p_b * period + e_b.
+ *      Each slot of the heap contains this virtual time, as a 64 bit signed
+ *      integer, followed by the payload of the user.
+ */
+
+#ifndef MIN_HEAP_AGING_H
+#define MIN_HEAP_AGING_H
+
+#include "min-heap.h"
+
+/*!
+ * \struct MinHeapAgingHandler_t
+ *
+ * \var MinHeapHandler_t heap
+ *       The heap of the slots, ordered by the virtual time at the start of each slot
+ *
+ * \var uint32_t period
+ *       The waiting time after which the effective priority of an item decreases by one
+ *
+ * \var size_t payload_size
+ *       The size of the payload that follows the virtual time
+ */
+typedef struct {
+    MinHeapHandler_t heap;
+    uint32_t period;
+    size_t payload_size;
+} MinHeapAgingHandler_t;
+
+#endif
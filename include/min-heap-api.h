@@ -45,6 +45,47 @@ MinHeapReturnCode min_heap_api_init(
     int8_t (*compare)(void *, void *),
     ArenaAllocatorHandler_t *arena);
 
+/*!
+ * \brief Initialize the minimum heap structure ordered by a lexicographic key
+ *
+ * \details The items are compared field by field in the given order, each field
+ *      with its own type and direction, and the first different field decides.
+ *      The comparison is done inline without calling any function pointer.
+ *      The key specification is copied in the arena, so it does not need to
+ *      outlive this call
+ *
+ * \param heap The min heap structur handler
+ * \param data_size The size of the items
+ * \param capacity The maximum number of the items in the heap
+ * \param keys The fields of the key, from the most to the least significant
+ * \param key_count The number of fields
+ * \param arena The arena allocator handler needed to allocate the data buffer
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap handler, the key specification or the arena are NULL
+ *     - MIN_HEAP_OUT_OF_BOUNDS if there are no fields, a field has an invalid type or direction
+ *       or it does not fit inside an item
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_init_keys(
+    MinHeapHandler_t *heap,
+    size_t data_size,
+    size_t capacity,
+    const MinHeapKeyField_t *keys,
+    size_t key_count,
+    ArenaAllocatorHandler_t *arena);
+
+/*!
+ * \brief Compare two items with the ordering of the heap
+ * \details Uses the key specification if the heap was initialized with
+ *      min_heap_api_init_keys, the compare function otherwise
+ *
+ * \param heap The min heap structure handler
+ * \param a The first item
+ * \param b The second item
+ * \return int8_t A negative value if a comes first, 0 if equal, a positive value otherwise
+ */
+int8_t min_heap_api_compare(const MinHeapHandler_t *heap, void *a, void *b);
+
 /*!
  * \brief Get the number of elements inside the heap
  *
@@ -134,9 +175,50 @@ MinHeapReturnCode min_heap_api_insert(MinHeapHandler_t *heap, void *item);
  */
 MinHeapReturnCode min_heap_api_remove(MinHeapHandler_t *heap, size_t index, void *out);
 
+/*!
+ * \brief Remove the k smallest items of the heap
+ * \attention 'out' can be NULL
+ *
+ * \param heap The heap handler structure
+ * \param out The buffer for the removed items in increasing order, has to be big enough to contain 'k' items
+ * \param k The maximum number of items to remove
+ * \return size_t The number of removed items, less than 'k' if the heap has fewer items
+ */
+size_t min_heap_api_pop_k(MinHeapHandler_t *heap, void *out, size_t k);
+
+/*!
+ * \brief Remove the minimum item passing it to a callback instead of copying it
+ * \details The callback receives a pointer to the item still in the heap buffer,
+ *      the pointer is valid only until the callback returns
+ * \attention The callback must not modify the heap
+ *
+ * \param heap The heap handler structure
+ * \param fn The callback that consumes the item
+ * \param ctx A user defined pointer passed to the callback
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap handler, the compare callback or the callback are NULL
+ *     - MIN_HEAP_EMPTY if the heap is empty
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_pop_with(MinHeapHandler_t *heap, void (*fn)(void *item, void *ctx), void *ctx);
+
+/*!
+ * \brief Remove the k smallest items passing them to a callback in increasing order
+ * \details Same as min_heap_api_pop_with for each item
+ *
+ * \param heap The heap handler structure
+ * \param fn The callback that consumes the items
+ * \param ctx A user defined pointer passed to the callback
+ * \param k The maximum number of items to remove
+ * \return size_t The number of removed items, less than 'k' if the heap has fewer items
+ */
+size_t min_heap_api_pop_k_with(MinHeapHandler_t *heap, void (*fn)(void *item, void *ctx), void *ctx, size_t k);
+
 /*!
  * \brief Find the index of an item in the heap array
  * \details This function has linear time complexity, use it wisely
+ *      (if the Bloom filter is enabled most of the missing items are
+ *      rejected in constant time)
  *
  * \param heap The heap handler structure
  * \param item The item to find
@@ -144,4 +226,336 @@ MinHeapReturnCode min_heap_api_remove(MinHeapHandler_t *heap, size_t index, void
  */
 signed_size_t min_heap_api_find(const MinHeapHandler_t *heap, void *item);
 
-#endif
\ No newline at end of file
+/*!
+ * \brief Copy all the items that are lower or equal than a bound, in no
+ *      particular order, without modifying the heap
+ * \details Only the subtrees whose root is not greater than the bound are
+ *      visited, so the time complexity is proportional to the number of
+ *      copied items and not to the size of the heap
+ * \attention If more than 'max' items are in range only the first 'max'
+ *      visited are copied
+ *
+ * \param heap The heap handler structure
+ * \param bound The upper bound (has to be an item compatible with the heap)
+ * \param out The output buffer, has to be big enough to contain 'max' items
+ * \param max The maximum number of items to copy
+ * \return size_t The number of copied items
+ */
+size_t min_heap_api_collect_below(const MinHeapHandler_t *heap, void *bound, void *out, size_t max);
+
+/*!
+ * \brief Remove an item from the heap given its value
+ * \attention 'out' can be NULL
+ * \details This function has linear time complexity unless the Bloom filter
+ *      is enabled and the item is not in the heap
+ *
+ * \param heap The heap handler structure
+ * \param item The item to remove
+ * \param out The removed item (has to be an address)
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap handler, the compare callback or the item are NULL
+ *     - MIN_HEAP_NOT_FOUND if the item is not in the heap
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_remove_by_value(MinHeapHandler_t *heap, void *item, void *out);
+
+/*!
+ * \brief Enable or disable the vectorized kernels for a heap (enabled by default)
+ * \details The result of the operations is the same, only their speed changes.
+ *      Without SIMD support (see min_heap_api_build) this has no effect
+ *
+ * \param heap The min heap structure handler
+ * \param enabled False to always use the scalar code
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap is NULL
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_set_simd(MinHeapHandler_t *heap, bool enabled);
+
+/*!
+ * \brief Replace the content of the heap with the given items in O(n)
+ *
+ * \details The items are copied in the heap buffer (they can already be in it)
+ *      and the heap properties are restored bottom-up with Floyd's method.
+ *      With a single 32 bit integer key at offset 0 (and not in stable mode) the
+ *      bottom level is processed 8 parents at a time with AVX2 if the CPU
+ *      supports it (x86-64 with GCC or Clang), define MIN_HEAP_NO_SIMD at compile
+ *      time to remove the vectorized code or see min_heap_api_set_simd
+ *
+ * \param heap The min heap structure handler
+ * \param items The array of items
+ * \param count The number of items
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap, the items or the compare function are NULL
+ *     - MIN_HEAP_FULL if the items are more than the capacity of the heap
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_build(MinHeapHandler_t *heap, void *items, size_t count);
+
+/*!
+ * \brief Replace the content of the heap with the given items sorted with an LSD radix sort
+ *
+ * \details Only for heaps initialized with min_heap_api_init_keys, every field of
+ *      the key is sorted one byte at a time (the bytes that are equal for every
+ *      item are skipped), so the time complexity is O(n) for any number of items.
+ *      The resulting heap is fully sorted, which also makes the following
+ *      removals of the minimum cheaper.
+ *      The sort is stable, in stable mode equal items keep the order of the array
+ *
+ * \param heap The min heap structure handler
+ * \param items The array of items
+ * \param count The number of items
+ * \param scratch A buffer of at least 'count' items used by the sort, it can be 'items' itself
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap, the items or the scratch buffer are NULL
+ *     - MIN_HEAP_INVALID_STATE if the heap has no key specification
+ *     - MIN_HEAP_FULL if the items are more than the capacity of the heap
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_build_radix(MinHeapHandler_t *heap, void *items, size_t count, void *scratch);
+
+/*!
+ * \brief Enable a counting Bloom filter used to skip the search of the items
+ *      that are not in the heap
+ * \details The filter is updated on every insertion and removal and costs one
+ *      byte for each counter, with k = 3 hashes the false positive rate is
+ *      about 5% with 5 counters per item and 1% with 10 counters per item
+ * \attention Two items that are equal according to the compare callback
+ *      must have the same hash
+ *
+ * \param heap The heap handler structure
+ * \param counters The number of counters of the filter
+ * \param hash A pointer to a function that should hash an item of the heap
+ * \param arena The arena allocator handler needed to allocate the counters
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap handler, the callback or the arena are NULL
+ *       or the counters cannot be allocated
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the number of counters is zero
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_bloom_init(
+    MinHeapHandler_t *heap,
+    size_t counters,
+    uint32_t (*hash)(void *),
+    ArenaAllocatorHandler_t *arena);
+
+/*!
+ * \brief Enable the stable mode, where equal items are removed from the top
+ *      in the same order they were inserted (FIFO)
+ * \details The insertion sequence of every item is stored in a separate array
+ *      (4 bytes per item) and is used as a tie-breaker only when the compare
+ *      callback returns zero.
+ *      The items already in the heap are ordered by their current position.
+ * \attention The sequence counter wraps around safely as long as less than
+ *      2^31 insertions happen while an item is in the heap
+ *
+ * \param heap The heap handler structure
+ * \param arena The arena allocator handler needed to allocate the sequence array
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap handler or the arena are NULL
+ *       or the sequence array cannot be allocated
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_stable_init(MinHeapHandler_t *heap, ArenaAllocatorHandler_t *arena);
+
+/*!
+ * \brief Make the items addressable by a handle, so that an item can be found,
+ *      updated or removed in O(log N) without searching it
+ * \details Each item contains a uint32_t handle in [0, handle_count) at the
+ *      given offset, the heap keeps the slot of the item of each handle up to date
+ *      in a separate array (4 bytes per handle). The handles of the items in the
+ *      heap have to be unique, items with a handle out of range are not tracked.
+ *
+ * \param heap The heap handler structure
+ * \param handle_offset The offset of the handle inside each item
+ * \param handle_count The number of handles
+ * \param arena The arena allocator handler needed to allocate the position array
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap handler or the arena are NULL
+ *       or the position array cannot be allocated
+ *     - MIN_HEAP_OUT_OF_BOUNDS if there are no handles, the handle does not fit
+ *       in the items or the capacity does not fit in 32 bits
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_handles_init(
+    MinHeapHandler_t *heap,
+    size_t handle_offset,
+    size_t handle_count,
+    ArenaAllocatorHandler_t *arena);
+
+/*!
+ * \brief Get the index of the item with a given handle in constant time
+ *
+ * \param heap The heap handler structure
+ * \param handle The handle of the item
+ * \return signed_size_t The index of the item or -1 if it is not in the heap
+ */
+signed_size_t min_heap_api_position(const MinHeapHandler_t *heap, uint32_t handle);
+
+/*!
+ * \brief Get a reference to the item at a given index
+ * \attention The return value can be NULL
+ *
+ * \param heap The heap handler structure
+ * \param index The index of the item
+ * \return void * A pointer to the item
+ */
+void *min_heap_api_at(const MinHeapHandler_t *heap, size_t index);
+
+/*!
+ * \brief Restore the order of the heap after the key of an item has been
+ *      changed in place (e.g. through min_heap_api_at or min_heap_api_peek)
+ * \details The item is moved up or down with a single sift, in O(log N) time
+ *      and without copying it
+ * \attention The hash of the item for the Bloom filter must not change
+ *
+ * \param heap The heap handler structure
+ * \param index The index of the changed item
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap handler or the compare callback are NULL
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the index is greater than the size of the heap
+ *     - MIN_HEAP_INVALID_STATE if a transaction is in progress (the change cannot be undone)
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_update(MinHeapHandler_t *heap, size_t index);
+
+/*!
+ * \brief Copy the k smallest items of an array (that is not a heap) into 'out'
+ *      sorted in ascending order
+ * \details A bounded max heap of k items is used, so the time complexity is
+ *      O(n log k) and no additional memory is needed
+ *
+ * \param array The input array, it is not modified
+ * \param n The number of items of the array
+ * \param k The number of items to select
+ * \param data_size The size of a single item in bytes
+ * \param compare A pointer to a function that should compare two items
+ * \param out The output buffer, has to be big enough to contain k items
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the array, the callback or out are NULL
+ *     - MIN_HEAP_OUT_OF_BOUNDS if k is greater than n
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_select(
+    void *array,
+    size_t n,
+    size_t k,
+    size_t data_size,
+    int8_t (*compare)(void *, void *),
+    void *out);
+
+/*!
+ * \brief Move the k smallest items of an array to its beginning sorted in
+ *      ascending order, the remaining items are left in an unspecified order
+ * \details The time complexity is O(n log k) and no additional memory is needed
+ *
+ * \param array The array to sort
+ * \param n The number of items of the array
+ * \param k The number of items to sort
+ * \param data_size The size of a single item in bytes
+ * \param compare A pointer to a function that should compare two items
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the array or the callback are NULL
+ *     - MIN_HEAP_OUT_OF_BOUNDS if k is greater than n
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_partial_sort(
+    void *array,
+    size_t n,
+    size_t k,
+    size_t data_size,
+    int8_t (*compare)(void *, void *));
+
+/*!
+ * \brief Maximum number of parts of the parallel drain
+ */
+#define MIN_HEAP_DRAIN_MAX_PARTS (64U)
+
+/*!
+ * \brief Remove all the items of the heap and write them in increasing order,
+ *      splitting the work in parallel tasks
+ *
+ * \details The library does not create threads, the tasks are executed by
+ *      the 'run' callback (e.g. with a thread pool) which has to call
+ *      task(arg, i) for every i in [0, count) and return when all of them
+ *      are completed, the tasks of a call are independent.
+ *      'run' is called twice: the first time each task sorts with heapsort one
+ *      of the 'parts' chunks of the heap buffer, the second time each task
+ *      finds with a multiway selection the pieces of the chunks that belong
+ *      to one part of the output and merges them.
+ *      The result is the same of removing all the items one by one (equal items
+ *      may be in a different order, except in stable mode)
+ *
+ * \param heap The heap handler structure
+ * \param out The output buffer, has to be big enough to contain all the items
+ * \param parts The number of tasks of each call of 'run' (e.g. the number of threads)
+ * \param run The callback that executes the tasks
+ * \param ctx A user defined pointer passed to 'run'
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap handler, the output buffer, the callbacks are NULL
+ *     - MIN_HEAP_OUT_OF_BOUNDS if parts is zero or greater than MIN_HEAP_DRAIN_MAX_PARTS
+ *     - MIN_HEAP_INVALID_STATE if a transaction is in progress
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_drain_parallel(
+    MinHeapHandler_t *heap,
+    void *out,
+    size_t parts,
+    void (*run)(void (*task)(void *arg, size_t index), void *arg, size_t count, void *ctx),
+    void *ctx);
+
+/*!
+ * \brief Enable the transactions on the heap
+ * \details An undo log with an entry for each slot of the heap (the size of an
+ *      item plus 8 to 12 bytes) is allocated, during a transaction the first
+ *      write to every slot saves its previous content in the log
+ *
+ * \param heap The heap handler structure
+ * \param arena The arena allocator handler needed to allocate the undo log
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap handler or the arena are NULL
+ *       or the undo log cannot be allocated
+ *     - MIN_HEAP_INVALID_STATE if a transaction is in progress
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_txn_init(MinHeapHandler_t *heap, ArenaAllocatorHandler_t *arena);
+
+/*!
+ * \brief Begin a transaction, all the following insertions, removals and
+ *      clears can be undone with min_heap_api_txn_rollback
+ * \attention Nested transactions are not supported
+ *
+ * \param heap The heap handler structure
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap handler is NULL or the transactions are not enabled
+ *     - MIN_HEAP_INVALID_STATE if a transaction is already in progress
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_txn_begin(MinHeapHandler_t *heap);
+
+/*!
+ * \brief Keep all the changes of the current transaction
+ * \details This function has constant time complexity
+ *
+ * \param heap The heap handler structure
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap handler is NULL or the transactions are not enabled
+ *     - MIN_HEAP_INVALID_STATE if no transaction is in progress
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_txn_commit(MinHeapHandler_t *heap);
+
+/*!
+ * \brief Undo all the changes of the current transaction
+ * \details The time complexity is proportional to the number of slots
+ *      modified during the transaction
+ *
+ * \param heap The heap handler structure
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap handler is NULL or the transactions are not enabled
+ *     - MIN_HEAP_INVALID_STATE if no transaction is in progress
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_api_txn_rollback(MinHeapHandler_t *heap);
+
+#endif
@@ -0,0 +1,107 @@
+/*!
+ * \file min-heap-cache-api.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that implements a cache with cost-aware eviction (LFU and
+ *      GreedyDual) backed by an addressable min heap
+ *
+ * \details A lookup costs O(1) on average, a hit updates the priority of the
+ *      entry in place in O(log N) and an eviction removes the minimum of the
+ *      heap in O(log N). Unlike LRU the eviction takes into account how often
+ *      an entry is used and how expensive it is to rebuild it.
+ */
+
+#ifndef MIN_HEAP_CACHE_API_H
+#define MIN_HEAP_CACHE_API_H
+
+#include "min-heap-cache.h"
+#include "arena-allocator-api.h"
+
+/*!
+ * \brief Initialize the cache
+ *
+ * \param cache The cache handler
+ * \param policy The eviction policy
+ * \param capacity The maximum number of entries
+ * \param value_size The size of the value of each entry (can be zero)
+ * \param arena The arena allocator handler needed to allocate the buffers
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler or the arena are NULL
+ *       or if the buffers cannot be allocated
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the policy is not valid or the capacity is zero
+ *       or does not fit in 31 bits
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_cache_api_init(
+    MinHeapCacheHandler_t *cache,
+    MinHeapCachePolicy policy,
+    size_t capacity,
+    size_t value_size,
+    ArenaAllocatorHandler_t *arena);
+
+/*!
+ * \brief Get the number of entries of the cache
+ *
+ * \param cache The cache handler
+ * \return size_t The number of entries
+ */
+size_t min_heap_cache_api_size(const MinHeapCacheHandler_t *cache);
+
+/*!
+ * \brief Look up a key, on a hit the priority of the entry is updated
+ * \attention The return value can be NULL, if the value size is zero a hit
+ *      returns MIN_HEAP_CACHE_HIT, which must not be accessed
+ *
+ * \param cache The cache handler
+ * \param key The key to look up
+ * \return void * A pointer to the value of the entry, MIN_HEAP_CACHE_HIT on a hit
+ *      if the value size is zero, NULL on a miss
+ */
+void *min_heap_cache_api_get(MinHeapCacheHandler_t *cache, uint64_t key);
+
+/*!
+ * \brief Insert an entry, or replace the value and the cost of an existing one
+ *
+ * \details If the cache is full the entry with the lowest priority is evicted
+ *      and its key and value are copied in 'evicted_key' and 'evicted_value'
+ * \attention 'value' can be NULL only if the value size is zero,
+ *      'evicted', 'evicted_key' and 'evicted_value' can be NULL
+ *
+ * \param cache The cache handler
+ * \param key The key of the entry
+ * \param cost The cost of a miss of the entry
+ * \param value The value of the entry
+ * \param evicted Set to true if an entry has been evicted
+ * \param evicted_key The key of the evicted entry
+ * \param evicted_value The value of the evicted entry (has to be an address)
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler or the value are NULL
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_cache_api_put(
+    MinHeapCacheHandler_t *cache,
+    uint64_t key,
+    uint32_t cost,
+    const void *value,
+    bool *evicted,
+    uint64_t *evicted_key,
+    void *evicted_value);
+
+/*!
+ * \brief Remove an entry
+ * \attention 'value' can be NULL
+ *
+ * \param cache The cache handler
+ * \param key The key of the entry
+ * \param value The value of the removed entry (has to be an address)
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler is NULL
+ *     - MIN_HEAP_NOT_FOUND if the key is not in the cache
+ *     - MIN_HEAP_INVALID_STATE if the heap has been changed outside of the cache
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_cache_api_remove(MinHeapCacheHandler_t *cache, uint64_t key, void *value);
+
+#endif
@@ -0,0 +1,130 @@
+/*!
+ * \file min-heap-cache.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that defines the structure of a cache with cost-aware
+ *      eviction backed by an addressable min heap
+ *
+ * \details Every entry has a priority H = L + value, where value depends on
+ *      the policy and L (the inflation) is the priority of the last evicted
+ *      entry. The entry with the lowest priority is evicted first, the
+ *      inflation makes the entries that are not used anymore age with
+ *      respect to the new ones. The entries are found with an open
+ *      addressing hash map of their keys and their priorities are kept in a
+ *      heap whose items are addressable by the index of the entry.
+ */
+
+#ifndef MIN_HEAP_CACHE_H
+#define MIN_HEAP_CACHE_H
+
+#include "min-heap.h"
+
+/*!
+ * \brief Value of an empty bucket of the hash map
+ */
+#define MIN_HEAP_CACHE_EMPTY (UINT32_MAX)
+
+/*!
+ * \brief Read-only byte whose address is returned on a hit when the values are empty
+ */
+extern const uint8_t min_heap_cache_hit;
+
+/*!
+ * \brief Value returned by min_heap_cache_api_get on a hit if the value size is zero,
+ *      it does not point inside the cache and must not be accessed
+ */
+#define MIN_HEAP_CACHE_HIT ((void *)&min_heap_cache_hit)
+
+/*!
+ * \brief Eviction policy of the cache
+ */
+typedef enum {
+    MIN_HEAP_CACHE_LFU,                   // H = L + frequency (LFU with dynamic aging)
+    MIN_HEAP_CACHE_GREEDY_DUAL,           // H = L + cost
+    MIN_HEAP_CACHE_GREEDY_DUAL_FREQUENCY  // H = L + frequency * cost
+} MinHeapCachePolicy;
+
+/*!
+ * \struct MinHeapCacheEntry_t
+ *
+ * \var uint64_t key
+ *       The key of the entry
+ *
+ * \var uint32_t cost
+ *       The cost of a miss of the entry (e.g. the time needed to rebuild it)
+ *
+ * \var uint32_t frequency
+ *       The number of accesses since the entry was inserted
+ */
+typedef struct {
+    uint64_t key;
+    uint32_t cost;
+    uint32_t frequency;
+} MinHeapCacheEntry_t;
+
+/*!
+ * \struct MinHeapCacheHandler_t
+ *
+ * \var MinHeapHandler_t heap
+ *       The priorities of the entries, addressable by the index of the entry
+ *
+ * \var MinHeapCacheEntry_t *entries
+ *       The entries
+ *
+ * \var uint8_t *values
+ *       The values of the entries
+ *
+ * \var size_t value_size
+ *       The size of a value
+ *
+ * \var size_t capacity
+ *       The maximum number of entries
+ *
+ * \var uint32_t *table
+ *       The buckets of the hash map, each one contains the index of an entry
+ *
+ * \var size_t table_mask
+ *       The number of buckets minus one (power of two)
+ *
+ * \var uint32_t *free_slots
+ *       The stack of the unused entries
+ *
+ * \var size_t free_count
+ *       The number of unused entries
+ *
+ * \var uint64_t inflation
+ *       The priority of the last evicted entry (L)
+ *
+ * \var uint64_t clock
+ *       The number of accesses, used to evict the least recently used entry
+ *       among the ones with the same priority
+ *
+ * \var MinHeapCachePolicy policy
+ *       The eviction policy
+ *
+ * \var size_t hits
+ *       The number of lookups that found the key
+ *
+ * \var size_t misses
+ *       The number of lookups that did not find the key
+ */
+typedef struct {
+    MinHeapHandler_t heap;
+    MinHeapCacheEntry_t *entries;
+    uint8_t *values;
+    size_t value_size;
+    size_t capacity;
+    uint32_t *table;
+    size_t table_mask;
+    uint32_t *free_slots;
+    size_t free_count;
+    uint64_t inflation;
+    uint64_t clock;
+    MinHeapCachePolicy policy;
+    size_t hits;
+    size_t misses;
+} MinHeapCacheHandler_t;
+
+#endif
@@ -0,0 +1,99 @@
+/*!
+ * \file min-heap-cached-api.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that implements a min heap whose smallest items are kept
+ *      in a small sorted cache
+ *
+ * \details The removal of the minimum takes the last item of the cache in O(1),
+ *      when the cache is empty it is refilled with min_heap_api_pop_k.
+ *      An inserted item lower than the maximum of the cache is put directly
+ *      in the cache (if the cache is full its maximum is moved to the heap),
+ *      every other item is inserted in the heap.
+ *      A cache of about 16 items is usually enough.
+ */
+
+#ifndef MIN_HEAP_CACHED_API_H
+#define MIN_HEAP_CACHED_API_H
+
+#include "min-heap-cached.h"
+#include "arena-allocator-api.h"
+
+/*!
+ * \brief Initialize the cached min heap
+ *
+ * \param cached The cached heap handler
+ * \param data_size The size of the items
+ * \param capacity The maximum number of items of the heap
+ * \param cache_capacity The maximum number of items of the cache
+ * \param compare A pointer to a function that should compare two items
+ * \param arena The arena allocator handler needed to allocate the buffers
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler, the callback or the arena are NULL
+ *       or if the buffers cannot be allocated
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the capacity of the cache is zero
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_cached_api_init(
+    MinHeapCachedHandler_t *cached,
+    size_t data_size,
+    size_t capacity,
+    size_t cache_capacity,
+    int8_t (*compare)(void *, void *),
+    ArenaAllocatorHandler_t *arena);
+
+/*!
+ * \brief Get the number of items of the cached heap
+ *
+ * \param cached The cached heap handler
+ * \return size_t The number of items in the cache and in the heap
+ */
+size_t min_heap_cached_api_size(const MinHeapCachedHandler_t *cached);
+
+/*!
+ * \brief Remove all the items of the cached heap
+ *
+ * \param cached The cached heap handler
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler is NULL
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_cached_api_clear(MinHeapCachedHandler_t *cached);
+
+/*!
+ * \brief Insert an item in the cached heap
+ *
+ * \param cached The cached heap handler
+ * \param item The item to insert
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler or the item are NULL
+ *     - MIN_HEAP_FULL if an item has to be inserted in the heap and the heap is full
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_cached_api_insert(MinHeapCachedHandler_t *cached, void *item);
+
+/*!
+ * \brief Get a reference to the minimum item
+ * \attention The return value can be NULL
+ *
+ * \param cached The cached heap handler
+ * \return void * A pointer to the minimum item
+ */
+void *min_heap_cached_api_peek(const MinHeapCachedHandler_t *cached);
+
+/*!
+ * \brief Remove the minimum item
+ * \attention 'out' can be NULL
+ *
+ * \param cached The cached heap handler
+ * \param out The removed item (has to be an address)
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler is NULL
+ *     - MIN_HEAP_EMPTY if the cached heap is empty
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_cached_api_pop(MinHeapCachedHandler_t *cached, void *out);
+
+#endif
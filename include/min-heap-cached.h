@@ -0,0 +1,43 @@
+/*!
+ * \file min-heap-cached.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that defines the structure of a min heap with a cache of
+ *      its smallest items
+ *
+ * \details The cache is a small sorted buffer that contains the smallest
+ *      items, every item of the cache is lower or equal than every item of
+ *      the heap. The cache is sorted in decreasing order so that its
+ *      minimum is the last item.
+ */
+
+#ifndef MIN_HEAP_CACHED_H
+#define MIN_HEAP_CACHED_H
+
+#include "min-heap.h"
+
+/*!
+ * \struct MinHeapCachedHandler_t
+ *
+ * \var MinHeapHandler_t heap
+ *       The heap of the items that are not in the cache
+ *
+ * \var void *cache
+ *       The buffer of the cache, sorted in decreasing order
+ *
+ * \var size_t cache_capacity
+ *       The maximum number of items of the cache
+ *
+ * \var size_t cache_size
+ *       The number of items of the cache
+ */
+typedef struct {
+    MinHeapHandler_t heap;
+    void *cache;
+    size_t cache_capacity;
+    size_t cache_size;
+} MinHeapCachedHandler_t;
+
+#endif
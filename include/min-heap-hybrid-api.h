@@ -0,0 +1,99 @@
+/*!
+ * \file min-heap-hybrid-api.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that implements a priority queue optimized for nearly
+ *      sorted input (e.g. timestamps)
+ *
+ * \details An item greater or equal than the last item of the sorted run is
+ *      appended to it in O(1), any other item is inserted in the heap in
+ *      O(log M) where M is the number of out of order items. The removal of
+ *      the minimum compares the first item of the run with the top of the heap,
+ *      so it costs O(1) when it comes from the run.
+ *      When the run is full the in order items are inserted in the heap too.
+ */
+
+#ifndef MIN_HEAP_HYBRID_API_H
+#define MIN_HEAP_HYBRID_API_H
+
+#include "min-heap-hybrid.h"
+#include "arena-allocator-api.h"
+
+/*!
+ * \brief Initialize the hybrid priority queue
+ *
+ * \param hybrid The hybrid queue handler
+ * \param data_size The size of the items
+ * \param run_capacity The maximum number of items of the sorted run
+ * \param heap_capacity The maximum number of out of order items
+ * \param compare A pointer to a function that should compare two items
+ * \param arena The arena allocator handler needed to allocate the buffers
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler, the callback or the arena are NULL
+ *       or if the buffers cannot be allocated
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the capacity of the run is zero
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_hybrid_api_init(
+    MinHeapHybridHandler_t *hybrid,
+    size_t data_size,
+    size_t run_capacity,
+    size_t heap_capacity,
+    int8_t (*compare)(void *, void *),
+    ArenaAllocatorHandler_t *arena);
+
+/*!
+ * \brief Get the number of items of the hybrid queue
+ *
+ * \param hybrid The hybrid queue handler
+ * \return size_t The number of items in the run and in the heap
+ */
+size_t min_heap_hybrid_api_size(const MinHeapHybridHandler_t *hybrid);
+
+/*!
+ * \brief Remove all the items of the hybrid queue
+ *
+ * \param hybrid The hybrid queue handler
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler is NULL
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_hybrid_api_clear(MinHeapHybridHandler_t *hybrid);
+
+/*!
+ * \brief Insert an item in the hybrid queue
+ *
+ * \param hybrid The hybrid queue handler
+ * \param item The item to insert
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler or the item are NULL
+ *     - MIN_HEAP_FULL if the item belongs to the heap and the heap is full
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_hybrid_api_insert(MinHeapHybridHandler_t *hybrid, void *item);
+
+/*!
+ * \brief Get a reference to the minimum item
+ * \attention The return value can be NULL
+ *
+ * \param hybrid The hybrid queue handler
+ * \return void * A pointer to the minimum item
+ */
+void *min_heap_hybrid_api_peek(const MinHeapHybridHandler_t *hybrid);
+
+/*!
+ * \brief Remove the minimum item
+ * \attention 'out' can be NULL
+ *
+ * \param hybrid The hybrid queue handler
+ * \param out The removed item (has to be an address)
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler is NULL
+ *     - MIN_HEAP_EMPTY if the queue is empty
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_hybrid_api_pop(MinHeapHybridHandler_t *hybrid, void *out);
+
+#endif
@@ -0,0 +1,47 @@
+/*!
+ * \file min-heap-hybrid.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that defines the structure of a priority queue for nearly
+ *      sorted input
+ *
+ * \details The items that arrive in order are appended to a sorted run kept
+ *      in a ring buffer, only the items smaller than the last one of the run
+ *      (the stragglers) are inserted in a min heap. The minimum is always
+ *      either the first item of the run or the top of the heap.
+ */
+
+#ifndef MIN_HEAP_HYBRID_H
+#define MIN_HEAP_HYBRID_H
+
+#include "min-heap.h"
+
+/*!
+ * \struct MinHeapHybridHandler_t
+ *
+ * \var MinHeapHandler_t heap
+ *       The heap of the out of order items
+ *
+ * \var void *run
+ *       The ring buffer of the sorted run
+ *
+ * \var size_t run_capacity
+ *       The maximum number of items of the run
+ *
+ * \var size_t run_head
+ *       The index of the first (minimum) item of the run
+ *
+ * \var size_t run_size
+ *       The number of items of the run
+ */
+typedef struct {
+    MinHeapHandler_t heap;
+    void *run;
+    size_t run_capacity;
+    size_t run_head;
+    size_t run_size;
+} MinHeapHybridHandler_t;
+
+#endif
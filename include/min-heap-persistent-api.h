@@ -0,0 +1,114 @@
+/*!
+ * \file min-heap-persistent-api.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that implements a persistent (immutable) min heap whose
+ *      nodes are allocated with an arena allocator
+ *
+ * \details Every operation leaves the input versions untouched and returns a
+ *      new version in O(log n) time, useful for search algorithms
+ *      (e.g. branch and bound) that need many versions of a priority queue.
+ *      The nodes are never freed one by one, use a dedicated arena for each
+ *      search episode and free it with arena_allocator_api_free when none of
+ *      the versions is needed anymore.
+ */
+
+#ifndef MIN_HEAP_PERSISTENT_API_H
+#define MIN_HEAP_PERSISTENT_API_H
+
+#include "min-heap-persistent.h"
+#include "arena-allocator-api.h"
+
+/*!
+ * \brief Initialize the persistent heap context
+ *
+ * \param heap The persistent heap handler
+ * \param data_size The size of the items
+ * \param compare A pointer to a function that should compare two items of the heap
+ * \param arena The arena allocator handler used to allocate the nodes
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap handler, the callback or the arena are NULL
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_persistent_api_init(
+    MinHeapPersistentHandler_t *heap,
+    size_t data_size,
+    int8_t (*compare)(void *, void *),
+    ArenaAllocatorHandler_t *arena);
+
+/*!
+ * \brief Get the number of items of a version
+ *
+ * \param version The version of the heap
+ * \return size_t The number of items
+ */
+size_t min_heap_persistent_api_size(MinHeapPersistent_t version);
+
+/*!
+ * \brief Get a reference to the minimum of a version
+ * \attention The return value can be NULL and the item must not be modified
+ *
+ * \param version The version of the heap
+ * \return const void * A pointer to the minimum element
+ */
+const void *min_heap_persistent_api_peek(MinHeapPersistent_t version);
+
+/*!
+ * \brief Create a new version with an additional item
+ *
+ * \param heap The persistent heap handler
+ * \param version The starting version (NULL for the empty heap)
+ * \param item The item to insert
+ * \param out The new version
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap handler, the item or out are NULL
+ *       or if a node cannot be allocated
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_persistent_api_insert(
+    const MinHeapPersistentHandler_t *heap,
+    MinHeapPersistent_t version,
+    void *item,
+    MinHeapPersistent_t *out);
+
+/*!
+ * \brief Create a new version without the minimum item
+ * \attention 'item' can be NULL
+ *
+ * \param heap The persistent heap handler
+ * \param version The starting version
+ * \param item The removed item (has to be an address)
+ * \param out The new version
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap handler or out are NULL
+ *       or if a node cannot be allocated
+ *     - MIN_HEAP_EMPTY if the version is empty
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_persistent_api_pop(
+    const MinHeapPersistentHandler_t *heap,
+    MinHeapPersistent_t version,
+    void *item,
+    MinHeapPersistent_t *out);
+
+/*!
+ * \brief Create a new version that contains the items of two versions
+ *
+ * \param heap The persistent heap handler
+ * \param a The first version
+ * \param b The second version
+ * \param out The new version
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the heap handler or out are NULL
+ *       or if a node cannot be allocated
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_persistent_api_meld(
+    const MinHeapPersistentHandler_t *heap,
+    MinHeapPersistent_t a,
+    MinHeapPersistent_t b,
+    MinHeapPersistent_t *out);
+
+#endif
@@ -0,0 +1,75 @@
+/*!
+ * \file min-heap-persistent.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that defines the structure of a persistent min heap
+ *
+ * \details A persistent heap is never modified, every operation returns a new
+ *      version that shares most of its nodes with the previous one.
+ *      The heap is a leftist tree: the rank of a node (length of the path
+ *      to the nearest empty child) of every left child is greater or equal
+ *      than the one of its sibling, so the right spine has at most
+ *      O(log n) nodes and only those nodes are copied when two heaps are
+ *      merged.
+ */
+
+#ifndef MIN_HEAP_PERSISTENT_H
+#define MIN_HEAP_PERSISTENT_H
+
+#include "min-heap.h"
+#include "arena-allocator-api.h"
+
+/*!
+ * \struct MinHeapPersistentNode_t
+ *
+ * \var left
+ *       The left subtree (can be NULL)
+ *
+ * \var right
+ *       The right subtree (can be NULL)
+ *
+ * \var size_t rank
+ *       The length of the right spine of the subtree
+ *
+ * \var size_t size
+ *       The number of items in the subtree
+ *
+ * \var uint8_t data
+ *       The item stored in the node
+ */
+typedef struct MinHeapPersistentNode {
+    const struct MinHeapPersistentNode *left;
+    const struct MinHeapPersistentNode *right;
+    size_t rank;
+    size_t size;
+    uint8_t data[];
+} MinHeapPersistentNode_t;
+
+/*!
+ * \brief A version of a persistent heap is a pointer to its root,
+ *      the empty heap is NULL
+ */
+typedef const MinHeapPersistentNode_t *MinHeapPersistent_t;
+
+/*!
+ * \struct MinHeapPersistentHandler_t
+ * \brief Context shared by all the versions of the heap
+ *
+ * \var size_t data_size
+ *       The size of a single item in bytes
+ *
+ * \var int8_t (*compare)(void *, void*)
+ *       The function used to compare two element
+ *
+ * \var ArenaAllocatorHandler_t *arena
+ *       The arena allocator used to allocate the nodes
+ */
+typedef struct {
+    size_t data_size;
+    int8_t (*compare)(void *, void *);
+    ArenaAllocatorHandler_t *arena;
+} MinHeapPersistentHandler_t;
+
+#endif
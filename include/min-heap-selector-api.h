@@ -0,0 +1,74 @@
+/*!
+ * \file min-heap-selector-api.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that implements a selector of the least loaded worker
+ *
+ * \details Both the acquisition and the release of a worker cost O(log N)
+ *      with a single sift and no copy of the items.
+ */
+
+#ifndef MIN_HEAP_SELECTOR_API_H
+#define MIN_HEAP_SELECTOR_API_H
+
+#include "min-heap-selector.h"
+#include "arena-allocator-api.h"
+
+/*!
+ * \brief Initialize the selector with every worker unloaded
+ *
+ * \param selector The selector handler
+ * \param worker_count The number of workers
+ * \param arena The arena allocator handler needed to allocate the heap
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler or the arena are NULL
+ *       or if the heap cannot be allocated
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the number of workers is zero or does not fit in 32 bits
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_selector_api_init(MinHeapSelectorHandler_t *selector, size_t worker_count, ArenaAllocatorHandler_t *arena);
+
+/*!
+ * \brief Select the least loaded worker and add a load to it
+ * \details If more workers have the same load the one with the lowest index is selected
+ *
+ * \param selector The selector handler
+ * \param load The load to add (e.g. 1 for a job or its estimated cost)
+ * \param worker The index of the selected worker
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler, the heap buffer or the worker are NULL
+ *     - MIN_HEAP_EMPTY if there are no workers
+ *     - MIN_HEAP_FULL if the load of the worker would overflow
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_selector_api_acquire(MinHeapSelectorHandler_t *selector, uint32_t load, size_t *worker);
+
+/*!
+ * \brief Remove a load from a worker (e.g. when one of its jobs is done)
+ *
+ * \param selector The selector handler
+ * \param worker The index of the worker
+ * \param load The load to remove
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler is NULL
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the worker does not exist or its load is lower than 'load'
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_selector_api_release(MinHeapSelectorHandler_t *selector, size_t worker, uint32_t load);
+
+/*!
+ * \brief Get the current load of a worker
+ *
+ * \param selector The selector handler
+ * \param worker The index of the worker
+ * \param load The load of the worker
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler or the load are NULL
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the worker does not exist
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_selector_api_load(const MinHeapSelectorHandler_t *selector, size_t worker, uint64_t *load);
+
+#endif
@@ -0,0 +1,37 @@
+/*!
+ * \file min-heap-selector.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that defines the structure of a selector of the least
+ *      loaded worker of a fixed set
+ *
+ * \details Each worker is an item of an addressable heap ordered by its load
+ *      (and by its index on ties), the handle of the item is the index of the
+ *      worker. The load of the selected worker is increased in place, so the
+ *      root only has to be moved down, while the load of a worker that
+ *      completes a job is decreased in place after finding its slot with the
+ *      position array of the heap.
+ */
+
+#ifndef MIN_HEAP_SELECTOR_H
+#define MIN_HEAP_SELECTOR_H
+
+#include "min-heap.h"
+
+/*!
+ * \struct MinHeapSelectorHandler_t
+ *
+ * \var MinHeapHandler_t heap
+ *       The workers, ordered by their load
+ *
+ * \var size_t worker_count
+ *       The number of workers
+ */
+typedef struct {
+    MinHeapHandler_t heap;
+    size_t worker_count;
+} MinHeapSelectorHandler_t;
+
+#endif
@@ -0,0 +1,126 @@
+/*!
+ * \file min-heap-timer-api.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that implements a timer heap whose deadlines are stored as
+ *      16 or 32 bit offsets from a per-heap epoch
+ *
+ * \details When all the pending deadlines are close to the current time,
+ *      storing them as small offsets instead of 64 bit absolute timestamps
+ *      reduces the size of each slot and the memory traffic of the heap
+ *      operations. As the time goes on the epoch is moved forward with
+ *      min_heap_timer_api_rebase, which shifts all the offsets in a single
+ *      linear pass without reordering the heap (a uniform shift does not
+ *      change the order of the items).
+ */
+
+#ifndef MIN_HEAP_TIMER_API_H
+#define MIN_HEAP_TIMER_API_H
+
+#include "min-heap-timer.h"
+#include "arena-allocator-api.h"
+
+/*!
+ * \brief Initialize the timer heap
+ *
+ * \param timer The timer heap handler
+ * \param key_type The type of the offsets, MIN_HEAP_KEY_U16 or MIN_HEAP_KEY_U32
+ * \param payload_size The size of the payload of each timer (can be zero)
+ * \param capacity The maximum number of timers
+ * \param epoch The initial epoch
+ * \param arena The arena allocator handler needed to allocate the buffers
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler or the arena are NULL
+ *       or if the buffers cannot be allocated
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the key type is not a 16 or 32 bit unsigned integer
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_timer_api_init(
+    MinHeapTimerHandler_t *timer,
+    MinHeapKeyType key_type,
+    size_t payload_size,
+    size_t capacity,
+    uint64_t epoch,
+    ArenaAllocatorHandler_t *arena);
+
+/*!
+ * \brief Get the number of pending timers
+ *
+ * \param timer The timer heap handler
+ * \return size_t The number of timers in the heap
+ */
+size_t min_heap_timer_api_size(const MinHeapTimerHandler_t *timer);
+
+/*!
+ * \brief Remove all the timers, the epoch is not changed
+ *
+ * \param timer The timer heap handler
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler is NULL
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_timer_api_clear(MinHeapTimerHandler_t *timer);
+
+/*!
+ * \brief Insert a timer
+ * \attention 'payload' can be NULL only if the payload size is zero
+ *
+ * \param timer The timer heap handler
+ * \param deadline The absolute deadline of the timer
+ * \param payload The payload of the timer
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler or the payload are NULL
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the deadline is before the epoch or too far from it
+ *     - MIN_HEAP_FULL if the heap is full
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_timer_api_insert(MinHeapTimerHandler_t *timer, uint64_t deadline, const void *payload);
+
+/*!
+ * \brief Get the earliest timer
+ * \attention The return value can be NULL
+ * \attention The payload follows the offset without padding, so it may not be
+ *      aligned (copy it with memcpy before reading its fields)
+ *
+ * \param timer The timer heap handler
+ * \param deadline The absolute deadline of the earliest timer (can be NULL)
+ * \return void * A pointer to the payload of the earliest timer
+ */
+void *min_heap_timer_api_peek(const MinHeapTimerHandler_t *timer, uint64_t *deadline);
+
+/*!
+ * \brief Remove the earliest timer
+ * \attention 'deadline' and 'payload' can be NULL
+ *
+ * \param timer The timer heap handler
+ * \param deadline The absolute deadline of the removed timer
+ * \param payload The payload of the removed timer (has to be an address)
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler is NULL
+ *     - MIN_HEAP_EMPTY if there are no timers
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_timer_api_pop(MinHeapTimerHandler_t *timer, uint64_t *deadline, void *payload);
+
+/*!
+ * \brief Move the epoch and shift all the offsets accordingly in O(N)
+ *
+ * \details The order of the heap is not changed. The epoch can be moved
+ *      forward up to the earliest deadline, and backward as long as the
+ *      latest deadline still fits in an offset (only the leaves are checked
+ *      since the latest deadline is always a leaf)
+ * \attention The Bloom filter of the heap, if any, is not updated
+ *
+ * \param timer The timer heap handler
+ * \param epoch The new epoch
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler is NULL
+ *     - MIN_HEAP_INVALID_STATE if a transaction is in progress
+ *     - MIN_HEAP_OUT_OF_BOUNDS if a deadline cannot be represented with the new epoch
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_timer_api_rebase(MinHeapTimerHandler_t *timer, uint64_t epoch);
+
+#endif
@@ -0,0 +1,47 @@
+/*!
+ * \file min-heap-timer.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that defines the structure of a timer heap with compact
+ *      keys relative to an epoch
+ *
+ * \details Each slot of the heap contains the offset of the deadline from
+ *      the epoch of the heap, stored as a 16 or 32 bit unsigned integer,
+ *      followed by the payload of the user. Only deadlines between the epoch
+ *      and the epoch plus the maximum offset can be stored.
+ */
+
+#ifndef MIN_HEAP_TIMER_H
+#define MIN_HEAP_TIMER_H
+
+#include "min-heap.h"
+
+/*!
+ * \struct MinHeapTimerHandler_t
+ *
+ * \var MinHeapHandler_t heap
+ *       The heap of the slots, ordered by the offset at the start of each slot
+ *
+ * \var uint64_t epoch
+ *       The time the offsets are relative to
+ *
+ * \var uint64_t max_offset
+ *       The maximum offset that can be stored in a slot
+ *
+ * \var size_t key_size
+ *       The size of the offset (2 or 4 bytes)
+ *
+ * \var size_t payload_size
+ *       The size of the payload that follows the offset
+ */
+typedef struct {
+    MinHeapHandler_t heap;
+    uint64_t epoch;
+    uint64_t max_offset;
+    size_t key_size;
+    size_t payload_size;
+} MinHeapTimerHandler_t;
+
+#endif
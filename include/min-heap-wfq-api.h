@@ -0,0 +1,106 @@
+/*!
+ * \file min-heap-wfq-api.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that implements a weighted fair queuing packet scheduler
+ *      that shares a link between flows with different weights
+ *
+ * \details Each backlogged flow receives a share of the link proportional to
+ *      its weight. Two policies are available:
+ *      - MIN_HEAP_WFQ_MODE_WFQ: the packet with the lowest virtual finish time
+ *        is sent, the virtual time is the finish time of the last packet sent
+ *        (self-clocked fair queuing, no emulation of the fluid system)
+ *      - MIN_HEAP_WFQ_MODE_WF2Q: only the packets whose virtual start time is
+ *        not after the virtual time can be sent (WF2Q+), which avoids that a
+ *        flow with a high weight sends a long burst ahead of its fluid service.
+ *        The first packets that have not started yet are kept in a second heap
+ *        keyed by their start time
+ *      Enqueue and dequeue cost O(log F) where F is the number of flows,
+ *      independently of the number of waiting packets.
+ */
+
+#ifndef MIN_HEAP_WFQ_API_H
+#define MIN_HEAP_WFQ_API_H
+
+#include "min-heap-wfq.h"
+#include "arena-allocator-api.h"
+
+/*!
+ * \brief Initialize the scheduler, every flow starts with weight 1
+ *
+ * \param wfq The scheduler handler
+ * \param mode The selection policy
+ * \param flow_count The number of flows
+ * \param packet_capacity The maximum number of packets waiting in all the flows
+ * \param payload_size The size of the payload of each packet (can be zero)
+ * \param arena The arena allocator handler needed to allocate the buffers
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler or the arena are NULL
+ *       or if the buffers cannot be allocated
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the mode is not valid, if there are no flows or
+ *       if the number of packets is zero or does not fit in 32 bits
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_wfq_api_init(
+    MinHeapWfqHandler_t *wfq,
+    MinHeapWfqMode mode,
+    size_t flow_count,
+    size_t packet_capacity,
+    size_t payload_size,
+    ArenaAllocatorHandler_t *arena);
+
+/*!
+ * \brief Set the weight of a flow, it applies to the packets that arrive afterwards
+ *
+ * \param wfq The scheduler handler
+ * \param flow The index of the flow
+ * \param weight The weight of the flow
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler is NULL
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the flow does not exist or the weight is zero
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_wfq_api_set_weight(MinHeapWfqHandler_t *wfq, size_t flow, uint32_t weight);
+
+/*!
+ * \brief Get the number of packets waiting in all the flows
+ *
+ * \param wfq The scheduler handler
+ * \return size_t The number of packets
+ */
+size_t min_heap_wfq_api_size(const MinHeapWfqHandler_t *wfq);
+
+/*!
+ * \brief Append a packet to the queue of a flow
+ * \attention 'payload' can be NULL only if the payload size is zero
+ *
+ * \param wfq The scheduler handler
+ * \param flow The index of the flow
+ * \param length The length of the packet (e.g. in bytes)
+ * \param payload The payload of the packet
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler or the payload are NULL
+ *     - MIN_HEAP_OUT_OF_BOUNDS if the flow does not exist
+ *     - MIN_HEAP_FULL if all the packet slots are in use
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_wfq_api_enqueue(MinHeapWfqHandler_t *wfq, size_t flow, uint32_t length, const void *payload);
+
+/*!
+ * \brief Remove the next packet to send
+ * \attention 'flow', 'length' and 'payload' can be NULL
+ *
+ * \param wfq The scheduler handler
+ * \param flow The index of the flow of the packet
+ * \param length The length of the packet
+ * \param payload The payload of the packet (has to be an address)
+ * \return MinHeapReturnCode
+ *     - MIN_HEAP_NULL_POINTER if the handler is NULL
+ *     - MIN_HEAP_EMPTY if no packet is waiting
+ *     - MIN_HEAP_OK otherwise
+ */
+MinHeapReturnCode min_heap_wfq_api_dequeue(MinHeapWfqHandler_t *wfq, size_t *flow, uint32_t *length, void *payload);
+
+#endif
@@ -0,0 +1,145 @@
+/*!
+ * \file min-heap-wfq.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that defines the structure of a weighted fair queuing
+ *      packet scheduler
+ *
+ * \details Every packet gets a virtual start and finish time when it arrives:
+ *      start = max(V, finish of the previous packet of its flow) and
+ *      finish = start + length / weight, where V is the virtual time of the
+ *      scheduler. The packets of each flow wait in a FIFO list, only the
+ *      first packet of each backlogged flow is in a heap, so the cost of
+ *      the operations grows with the logarithm of the number of flows.
+ */
+
+#ifndef MIN_HEAP_WFQ_H
+#define MIN_HEAP_WFQ_H
+
+#include "min-heap.h"
+
+/*!
+ * \brief Fixed point scale of the virtual times, the finish time of a packet
+ *      grows by length * MIN_HEAP_WFQ_SCALE / weight
+ */
+#define MIN_HEAP_WFQ_SCALE (65536U)
+
+/*!
+ * \brief Index of the end of a list of packets
+ */
+#define MIN_HEAP_WFQ_NONE (UINT32_MAX)
+
+/*!
+ * \brief Selection policy of the scheduler
+ */
+typedef enum {
+    MIN_HEAP_WFQ_MODE_WFQ,  // The packet with the lowest finish time (self-clocked virtual time)
+    MIN_HEAP_WFQ_MODE_WF2Q  // The packet with the lowest finish time among the ones already started (WF2Q+)
+} MinHeapWfqMode;
+
+/*!
+ * \struct MinHeapWfqFlow_t
+ *
+ * \var uint32_t weight
+ *       The share of the link of the flow
+ *
+ * \var uint32_t head
+ *       The index of the first packet of the flow, MIN_HEAP_WFQ_NONE if empty
+ *
+ * \var uint32_t tail
+ *       The index of the last packet of the flow
+ *
+ * \var uint64_t last_finish
+ *       The virtual finish time of the last packet that arrived
+ *
+ * \var size_t backlog
+ *       The number of packets waiting in the flow
+ */
+typedef struct {
+    uint32_t weight;
+    uint32_t head;
+    uint32_t tail;
+    uint64_t last_finish;
+    size_t backlog;
+} MinHeapWfqFlow_t;
+
+/*!
+ * \struct MinHeapWfqPacket_t
+ * \brief Header of a packet slot, followed by the payload
+ *
+ * \var uint64_t start
+ *       The virtual start time
+ *
+ * \var uint64_t finish
+ *       The virtual finish time
+ *
+ * \var uint32_t length
+ *       The length of the packet
+ *
+ * \var uint32_t next
+ *       The index of the next packet of the flow (or of the free list)
+ */
+typedef struct {
+    uint64_t start;
+    uint64_t finish;
+    uint32_t length;
+    uint32_t next;
+} MinHeapWfqPacket_t;
+
+/*!
+ * \struct MinHeapWfqHandler_t
+ *
+ * \var MinHeapHandler_t eligible
+ *       The flows whose first packet can be sent, keyed by its finish time
+ *
+ * \var MinHeapHandler_t pending
+ *       The flows whose first packet has not started yet, keyed by its start time (WF2Q only)
+ *
+ * \var MinHeapWfqFlow_t *flows
+ *       The array of the flows
+ *
+ * \var size_t flow_count
+ *       The number of flows
+ *
+ * \var uint8_t *packets
+ *       The pool of the packet slots
+ *
+ * \var size_t slot_size
+ *       The size of a packet slot (header and payload)
+ *
+ * \var size_t payload_size
+ *       The size of the payload of a packet
+ *
+ * \var uint32_t free_head
+ *       The first free packet slot, MIN_HEAP_WFQ_NONE if the pool is full
+ *
+ * \var size_t size
+ *       The number of packets waiting in all the flows
+ *
+ * \var uint64_t vtime
+ *       The virtual time of the scheduler
+ *
+ * \var uint64_t active_weight
+ *       The sum of the weights of the backlogged flows
+ *
+ * \var MinHeapWfqMode mode
+ *       The selection policy
+ */
+typedef struct {
+    MinHeapHandler_t eligible;
+    MinHeapHandler_t pending;
+    MinHeapWfqFlow_t *flows;
+    size_t flow_count;
+    uint8_t *packets;
+    size_t slot_size;
+    size_t payload_size;
+    uint32_t free_head;
+    size_t size;
+    uint64_t vtime;
+    uint64_t active_weight;
+    MinHeapWfqMode mode;
+} MinHeapWfqHandler_t;
+
+#endif
@@ -21,6 +21,134 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+/*!
+ * \brief Types of the fields that can be used as keys of the heap
+ */
+typedef enum {
+    MIN_HEAP_KEY_U8,
+    MIN_HEAP_KEY_U16,
+    MIN_HEAP_KEY_U32,
+    MIN_HEAP_KEY_U64,
+    MIN_HEAP_KEY_I8,
+    MIN_HEAP_KEY_I16,
+    MIN_HEAP_KEY_I32,
+    MIN_HEAP_KEY_I64,
+    MIN_HEAP_KEY_FLOAT,
+    MIN_HEAP_KEY_DOUBLE
+} MinHeapKeyType;
+
+/*!
+ * \brief Sort direction of a key field, the value is used as the sign of the comparison
+ */
+typedef enum {
+    MIN_HEAP_KEY_ASC = 1,
+    MIN_HEAP_KEY_DESC = -1
+} MinHeapKeyOrder;
+
+/*!
+ * \struct MinHeapKeyField_t
+ * \brief Description of a single field of a lexicographic key
+ *
+ * \var size_t offset
+ *       The offset of the field inside the item (e.g. offsetof(Task, deadline))
+ *
+ * \var MinHeapKeyType type
+ *       The type of the field
+ *
+ * \var MinHeapKeyOrder order
+ *       The sort direction of the field
+ */
+typedef struct {
+    size_t offset;
+    MinHeapKeyType type;
+    MinHeapKeyOrder order;
+} MinHeapKeyField_t;
+
+/*!
+ * \struct MinHeapExtension_t
+ * \brief State of the optional features of a heap
+ * \details It is allocated in the arena by the first function that enables
+ *      one of the features, so a plain heap only needs the handler
+ *
+ * \var uint32_t (*hash)(void *)
+ *       The function used to hash an item for the Bloom filter (can be NULL)
+ *
+ * \var uint8_t *bloom
+ *       The counters of the Bloom filter, NULL if the filter is disabled
+ *
+ * \var size_t bloom_size
+ *       The number of counters of the Bloom filter
+ *
+ * \var uint32_t *seq
+ *       The insertion sequence of each item, NULL if the stable mode is disabled
+ *
+ * \var uint32_t next_seq
+ *       The sequence number of the next inserted item
+ *
+ * \var uint8_t *undo
+ *       The undo log of the transactions, NULL if the transactions are disabled
+ *
+ * \var uint32_t *undo_mark
+ *       The epoch of the last transaction that saved each slot in the undo log
+ *
+ * \var size_t undo_size
+ *       The number of entries in the undo log
+ *
+ * \var size_t txn_size
+ *       The size of the heap when the current transaction began
+ *
+ * \var uint32_t txn_seq
+ *       The sequence number of the next item when the current transaction began
+ *
+ * \var uint32_t txn_epoch
+ *       The identifier of the current transaction
+ *
+ * \var bool txn_active
+ *       True if a transaction is in progress
+ *
+ * \var const MinHeapKeyField_t *keys
+ *       The fields of the lexicographic key used instead of the compare function, can be NULL
+ *
+ * \var int8_t (**key_compare)(const uint8_t *, const uint8_t *)
+ *       The comparison function of each field, chosen for its type and direction
+ *
+ * \var size_t key_count
+ *       The number of fields of the key
+ *
+ * \var uint32_t *positions
+ *       The slot of the item of each handle, NULL if the items are not addressable
+ *
+ * \var size_t handle_offset
+ *       The offset of the uint32_t handle inside each item
+ *
+ * \var size_t handle_count
+ *       The number of handles
+ *
+ * \var bool no_simd
+ *       True if the vectorized kernels must not be used even if they are available
+ */
+typedef struct {
+    uint32_t (*hash)(void *);
+    uint8_t *bloom;
+    size_t bloom_size;
+    uint32_t *seq;
+    uint32_t next_seq;
+    uint8_t *undo;
+    uint32_t *undo_mark;
+    size_t undo_size;
+    size_t txn_size;
+    uint32_t txn_seq;
+    uint32_t txn_epoch;
+    bool txn_active;
+    const MinHeapKeyField_t *keys;
+    int8_t (**key_compare)(const uint8_t *, const uint8_t *);
+    size_t key_count;
+    uint32_t *positions;
+    size_t handle_offset;
+    size_t handle_count;
+    bool no_simd;
+} MinHeapExtension_t;
+
 /*!
  * \struct MinHeapHandler_t
  *
@@ -38,6 +166,9 @@
  *
  * \var void *data
  *       The buffer containign the data
+ *
+ * \var MinHeapExtension_t *ext
+ *       The state of the optional features, NULL if none of them is enabled
  */
 typedef struct {
     size_t data_size;
@@ -45,6 +176,7 @@ typedef struct {
     size_t capacity;
     int8_t (*compare)(void *, void *);
     void *data;
+    MinHeapExtension_t *ext;
 } MinHeapHandler_t;
 
 /*!
@@ -55,7 +187,9 @@ typedef enum {
     MIN_HEAP_NULL_POINTER,
     MIN_HEAP_EMPTY,
     MIN_HEAP_FULL,
-    MIN_HEAP_OUT_OF_BOUNDS
+    MIN_HEAP_OUT_OF_BOUNDS,
+    MIN_HEAP_NOT_FOUND,
+    MIN_HEAP_INVALID_STATE
 } MinHeapReturnCode;
 
 typedef long signed_size_t;
@@ -0,0 +1,125 @@
+/*!
+ * \file min-heap-aggregator-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that finds the global minimum of a group of min heaps
+ *      in constant time
+ */
+
+#include "min-heap-aggregator-api.h"
+#include "min-heap-api.h"
+
+/*!
+ * \brief Get the winner between two members
+ * \details Empty members always lose, on ties the lower index wins
+ */
+static inline size_t min_heap_aggregator_winner(const MinHeapAggregatorHandler_t *agg, size_t a, size_t b) {
+    if (a == MIN_HEAP_AGGREGATOR_NONE)
+        return b;
+    if (b == MIN_HEAP_AGGREGATOR_NONE)
+        return a;
+    MinHeapHandler_t *ha = agg->heaps[a];
+    MinHeapHandler_t *hb = agg->heaps[b];
+    int8_t cmp = min_heap_api_compare(ha, ha->data, hb->data);
+    if (cmp < 0 || (cmp == 0 && a < b))
+        return a;
+    return b;
+}
+
+static inline size_t min_heap_aggregator_leaf(const MinHeapAggregatorHandler_t *agg, size_t member) {
+    if (member >= agg->count || min_heap_api_is_empty(agg->heaps[member]))
+        return MIN_HEAP_AGGREGATOR_NONE;
+    return member;
+}
+
+MinHeapReturnCode min_heap_aggregator_api_init(
+    MinHeapAggregatorHandler_t *agg,
+    MinHeapHandler_t **heaps,
+    size_t count,
+    ArenaAllocatorHandler_t *arena) {
+    if (agg == NULL || heaps == NULL || arena == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (count == 0)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    for (size_t i = 0; i < count; ++i) {
+        if (heaps[i] == NULL || (heaps[i]->compare == NULL && (heaps[i]->ext == NULL || heaps[i]->ext->keys == NULL)))
+            return MIN_HEAP_NULL_POINTER;
+    }
+
+    size_t leaves = 1;
+    while (leaves < count)
+        leaves <<= 1;
+    agg->tree = arena_allocator_api_calloc(arena, sizeof(size_t), 2 * leaves);
+    if (agg->tree == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    agg->heaps = heaps;
+    agg->count = count;
+    agg->leaves = leaves;
+
+    // Build the whole tree bottom-up
+    for (size_t i = 0; i < leaves; ++i)
+        agg->tree[leaves + i] = min_heap_aggregator_leaf(agg, i);
+    for (size_t i = leaves - 1; i > 0; --i)
+        agg->tree[i] = min_heap_aggregator_winner(agg, agg->tree[2 * i], agg->tree[2 * i + 1]);
+    return MIN_HEAP_OK;
+}
+
+MinHeapReturnCode min_heap_aggregator_api_update(MinHeapAggregatorHandler_t *agg, size_t member) {
+    if (agg == NULL || agg->tree == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (member >= agg->count)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+
+    // Replay the matches from the leaf up to the root
+    size_t node = agg->leaves + member;
+    agg->tree[node] = min_heap_aggregator_leaf(agg, member);
+    for (node >>= 1; node > 0; node >>= 1)
+        agg->tree[node] = min_heap_aggregator_winner(agg, agg->tree[2 * node], agg->tree[2 * node + 1]);
+    return MIN_HEAP_OK;
+}
+
+MinHeapReturnCode min_heap_aggregator_api_insert(MinHeapAggregatorHandler_t *agg, size_t member, void *item) {
+    if (agg == NULL || agg->tree == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (member >= agg->count)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+
+    MinHeapHandler_t *heap = agg->heaps[member];
+    void *top = min_heap_api_peek(heap);
+    MinHeapReturnCode res = min_heap_api_insert(heap, item);
+    if (res != MIN_HEAP_OK)
+        return res;
+
+    // The tree changes only if the new item became the top of the member
+    if (top == NULL || min_heap_api_compare(heap, heap->data, item) == 0)
+        return min_heap_aggregator_api_update(agg, member);
+    return MIN_HEAP_OK;
+}
+
+signed_size_t min_heap_aggregator_api_top_member(const MinHeapAggregatorHandler_t *agg) {
+    if (agg == NULL || agg->tree == NULL || agg->tree[1] == MIN_HEAP_AGGREGATOR_NONE)
+        return -1;
+    return (signed_size_t)agg->tree[1];
+}
+
+void *min_heap_aggregator_api_peek(const MinHeapAggregatorHandler_t *agg) {
+    signed_size_t member = min_heap_aggregator_api_top_member(agg);
+    return member < 0 ? NULL : min_heap_api_peek(agg->heaps[member]);
+}
+
+MinHeapReturnCode min_heap_aggregator_api_pop(MinHeapAggregatorHandler_t *agg, void *out, size_t *member) {
+    if (agg == NULL || agg->tree == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    signed_size_t top = min_heap_aggregator_api_top_member(agg);
+    if (top < 0)
+        return MIN_HEAP_EMPTY;
+
+    MinHeapReturnCode res = min_heap_api_remove(agg->heaps[top], 0, out);
+    if (res != MIN_HEAP_OK)
+        return res;
+    if (member != NULL)
+        *member = (size_t)top;
+    return min_heap_aggregator_api_update(agg, (size_t)top);
+}
@@ -0,0 +1,103 @@
+/*!
+ * \file min-heap-aging-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that implements a priority queue with aging, where waiting
+ *      items gain priority so that low priority items cannot starve
+ */
+
+#include "min-heap-aging-api.h"
+#include "min-heap-api.h"
+
+#include <string.h>
+
+/*!
+ * \brief Get the effective priority of an item at a given time
+ * \details The result is floor((vtime - now) / period) saturated to the
+ *      range of int32_t
+ */
+static int32_t min_heap_aging_priority(const MinHeapAgingHandler_t *aging, const uint8_t *slot, uint64_t now) {
+    int64_t vtime;
+    memcpy(&vtime, slot, sizeof(vtime));
+    if (now > (uint64_t)INT64_MAX || vtime < INT64_MIN + (int64_t)now)
+        return INT32_MIN;
+
+    int64_t diff = vtime - (int64_t)now;
+    int64_t priority = diff / aging->period;
+    if (diff % aging->period != 0 && diff < 0)
+        --priority;
+    if (priority < INT32_MIN)
+        return INT32_MIN;
+    return priority > INT32_MAX ? INT32_MAX : (int32_t)priority;
+}
+
+MinHeapReturnCode min_heap_aging_api_init(
+    MinHeapAgingHandler_t *aging,
+    size_t payload_size,
+    size_t capacity,
+    uint32_t period,
+    ArenaAllocatorHandler_t *arena) {
+    if (aging == NULL || arena == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (period == 0)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    aging->period = period;
+    aging->payload_size = payload_size;
+
+    MinHeapKeyField_t key = { 0, MIN_HEAP_KEY_I64, MIN_HEAP_KEY_ASC };
+    return min_heap_api_init_keys(&aging->heap, sizeof(int64_t) + payload_size, capacity, &key, 1, arena);
+}
+
+size_t min_heap_aging_api_size(const MinHeapAgingHandler_t *aging) {
+    return aging == NULL ? 0U : aging->heap.size;
+}
+
+MinHeapReturnCode min_heap_aging_api_clear(MinHeapAgingHandler_t *aging) {
+    if (aging == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    return min_heap_api_clear(&aging->heap);
+}
+
+MinHeapReturnCode min_heap_aging_api_insert(MinHeapAgingHandler_t *aging, int32_t priority, uint64_t now, const void *payload) {
+    if (aging == NULL || (payload == NULL && aging->payload_size > 0))
+        return MIN_HEAP_NULL_POINTER;
+
+    // |priority * period| < 2^63, only the addition of the time can overflow
+    int64_t scaled = (int64_t)priority * aging->period;
+    if (now > (uint64_t)INT64_MAX || (scaled > 0 && (int64_t)now > INT64_MAX - scaled))
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    int64_t vtime = scaled + (int64_t)now;
+
+    uint8_t slot[aging->heap.data_size];
+    memcpy(slot, &vtime, sizeof(vtime));
+    if (aging->payload_size > 0)
+        memcpy(slot + sizeof(vtime), payload, aging->payload_size);
+    return min_heap_api_insert(&aging->heap, slot);
+}
+
+void *min_heap_aging_api_peek(const MinHeapAgingHandler_t *aging, uint64_t now, int32_t *priority) {
+    if (aging == NULL)
+        return NULL;
+    uint8_t *slot = min_heap_api_peek(&aging->heap);
+    if (slot == NULL)
+        return NULL;
+    if (priority != NULL)
+        *priority = min_heap_aging_priority(aging, slot, now);
+    return slot + sizeof(int64_t);
+}
+
+MinHeapReturnCode min_heap_aging_api_pop(MinHeapAgingHandler_t *aging, uint64_t now, int32_t *priority, void *payload) {
+    if (aging == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    uint8_t slot[aging->heap.data_size];
+    MinHeapReturnCode res = min_heap_api_remove(&aging->heap, 0, slot);
+    if (res != MIN_HEAP_OK)
+        return res;
+    if (priority != NULL)
+        *priority = min_heap_aging_priority(aging, slot, now);
+    if (payload != NULL && aging->payload_size > 0)
+        memcpy(payload, slot + sizeof(int64_t), aging->payload_size);
+    return MIN_HEAP_OK;
+}
@@ -22,6 +22,13 @@
 
 #include <string.h>
 
+// The bottom level of the build is vectorized on x86-64 unless MIN_HEAP_NO_SIMD is defined,
+// the AVX2 support of the CPU is checked at runtime
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(MIN_HEAP_NO_SIMD)
+#define MIN_HEAP_BUILD_AVX2
+#include <immintrin.h>
+#endif
+
 /*!
  * \brief Macros to get the parent and children indices given the current item index
  *
@@ -32,31 +39,553 @@
 #define MIN_HEAP_CHILD_L(I) ((I) * 2 + 1)
 #define MIN_HEAP_CHILD_R(I) ((I) * 2 + 2)
 
-static inline void min_heap_swap(const MinHeapHandler_t *heap, void *a, void *b) {
+/*!
+ * \brief Number of counters of the Bloom filter updated for each item
+ */
+#define MIN_HEAP_BLOOM_HASHES (3U)
+
+/*!
+ * \brief Order of the heap used by the sift functions, the max order is used
+ *      only internally by the select and partial sort functions
+ */
+#define MIN_HEAP_ORDER_MIN (1)
+#define MIN_HEAP_ORDER_MAX (-1)
+
+/*!
+ * \brief Macro to get the address of an item given its index
+ *
+ * \param H The heap handler
+ * \param I The item index
+ * \return The address of the item
+ */
+#define MIN_HEAP_ITEM(H, I) ((uint8_t *)(H)->data + (I) * (H)->data_size)
+
+/*!
+ * \brief Macro to check if the heap has a compare function or a key specification
+ *
+ * \param H The heap handler
+ */
+#define MIN_HEAP_HAS_COMPARE(H) ((H)->compare != NULL || ((H)->ext != NULL && (H)->ext->keys != NULL))
+
+/*!
+ * \brief Macro to check if a transaction is in progress on the heap
+ *
+ * \param H The heap handler
+ */
+#define MIN_HEAP_IN_TXN(H) ((H)->ext != NULL && (H)->ext->txn_active)
+
+/*!
+ * \brief Macro to define the comparison functions of a key field of the given type,
+ *      one for each direction
+ * \details The values are copied out with memcpy since the fields may be unaligned
+ *
+ * \param N The suffix of the function names
+ * \param T The C type of the field
+ */
+#define MIN_HEAP_KEY_COMPARE_FN(N, T)                                                   \
+    static int8_t min_heap_key_compare_##N##_asc(const uint8_t *a, const uint8_t *b) {  \
+        T f;                                                                            \
+        T s;                                                                            \
+        memcpy(&f, a, sizeof(T));                                                       \
+        memcpy(&s, b, sizeof(T));                                                       \
+        return (int8_t)((f > s) - (f < s));                                             \
+    }                                                                                   \
+    static int8_t min_heap_key_compare_##N##_desc(const uint8_t *a, const uint8_t *b) { \
+        T f;                                                                            \
+        T s;                                                                            \
+        memcpy(&f, a, sizeof(T));                                                       \
+        memcpy(&s, b, sizeof(T));                                                       \
+        return (int8_t)((f < s) - (f > s));                                             \
+    }
+
+/*!
+ * \brief Macros to get the size and the fields of an entry of the undo log,
+ *      each entry contains the slot index, its sequence and its data
+ *
+ * \param H The heap handler
+ * \param E The entry index
+ */
+#define MIN_HEAP_TXN_ENTRY_SIZE(H) (sizeof(size_t) + sizeof(uint32_t) + (H)->data_size)
+#define MIN_HEAP_TXN_ENTRY(H, E) ((H)->ext->undo + (E) * MIN_HEAP_TXN_ENTRY_SIZE(H))
+#define MIN_HEAP_TXN_ENTRY_SEQ(H, E) (MIN_HEAP_TXN_ENTRY(H, E) + sizeof(size_t))
+#define MIN_HEAP_TXN_ENTRY_DATA(H, E) (MIN_HEAP_TXN_ENTRY_SEQ(H, E) + sizeof(uint32_t))
+
+/*!
+ * \brief Save the content of a slot in the undo log before it is overwritten
+ * \details Only the first write of each slot during a transaction is saved,
+ *      so the log never contains more entries than the capacity of the heap
+ * \attention It must be called only during a transaction, the operations
+ *      check it once with MIN_HEAP_IN_TXN
+ */
+static inline void min_heap_txn_record(MinHeapHandler_t *heap, size_t slot) {
+    MinHeapExtension_t *ext = heap->ext;
+    if (ext->undo_mark[slot] == ext->txn_epoch)
+        return;
+    ext->undo_mark[slot] = ext->txn_epoch;
+
+    size_t entry = ext->undo_size++;
+    uint32_t seq = ext->seq != NULL ? ext->seq[slot] : 0U;
+    memcpy(MIN_HEAP_TXN_ENTRY(heap, entry), &slot, sizeof(size_t));
+    memcpy(MIN_HEAP_TXN_ENTRY_SEQ(heap, entry), &seq, sizeof(uint32_t));
+    memcpy(MIN_HEAP_TXN_ENTRY_DATA(heap, entry), MIN_HEAP_ITEM(heap, slot), heap->data_size);
+}
+
+MIN_HEAP_KEY_COMPARE_FN(uint8, uint8_t)
+MIN_HEAP_KEY_COMPARE_FN(uint16, uint16_t)
+MIN_HEAP_KEY_COMPARE_FN(uint32, uint32_t)
+MIN_HEAP_KEY_COMPARE_FN(uint64, uint64_t)
+MIN_HEAP_KEY_COMPARE_FN(int8, int8_t)
+MIN_HEAP_KEY_COMPARE_FN(int16, int16_t)
+MIN_HEAP_KEY_COMPARE_FN(int32, int32_t)
+MIN_HEAP_KEY_COMPARE_FN(int64, int64_t)
+MIN_HEAP_KEY_COMPARE_FN(float, float)
+MIN_HEAP_KEY_COMPARE_FN(double, double)
+
+/*!
+ * \brief Comparison function of each key type, indexed by the type and then by
+ *      the direction (ascending first)
+ */
+static int8_t (*const min_heap_key_compare_table[][2])(const uint8_t *, const uint8_t *) = {
+    [MIN_HEAP_KEY_U8] = { min_heap_key_compare_uint8_asc, min_heap_key_compare_uint8_desc },
+    [MIN_HEAP_KEY_U16] = { min_heap_key_compare_uint16_asc, min_heap_key_compare_uint16_desc },
+    [MIN_HEAP_KEY_U32] = { min_heap_key_compare_uint32_asc, min_heap_key_compare_uint32_desc },
+    [MIN_HEAP_KEY_U64] = { min_heap_key_compare_uint64_asc, min_heap_key_compare_uint64_desc },
+    [MIN_HEAP_KEY_I8] = { min_heap_key_compare_int8_asc, min_heap_key_compare_int8_desc },
+    [MIN_HEAP_KEY_I16] = { min_heap_key_compare_int16_asc, min_heap_key_compare_int16_desc },
+    [MIN_HEAP_KEY_I32] = { min_heap_key_compare_int32_asc, min_heap_key_compare_int32_desc },
+    [MIN_HEAP_KEY_I64] = { min_heap_key_compare_int64_asc, min_heap_key_compare_int64_desc },
+    [MIN_HEAP_KEY_FLOAT] = { min_heap_key_compare_float_asc, min_heap_key_compare_float_desc },
+    [MIN_HEAP_KEY_DOUBLE] = { min_heap_key_compare_double_asc, min_heap_key_compare_double_desc }
+};
+
+/*!
+ * \brief Compare two items with the lexicographic key of the heap
+ * \details The function of each field is chosen by min_heap_api_init_keys for
+ *      its type and direction, so a comparison is one indirect call per field
+ *      like a hand-written callback. A key with a single field skips the loop,
+ *      whose exit test would otherwise add a branch to every comparison
+ */
+static inline int8_t min_heap_compare_keys(const MinHeapExtension_t *ext, const uint8_t *a, const uint8_t *b) {
+    if (ext->key_count == 1)
+        return ext->key_compare[0](a + ext->keys[0].offset, b + ext->keys[0].offset);
+    int8_t cmp = 0;
+    for (size_t i = 0; cmp == 0 && i < ext->key_count; ++i)
+        cmp = ext->key_compare[i](a + ext->keys[i].offset, b + ext->keys[i].offset);
+    return cmp;
+}
+
+/*!
+ * \brief Compare two items with the key specification or the compare function of the heap
+ */
+static inline int8_t min_heap_compare_items(const MinHeapHandler_t *heap, void *a, void *b) {
+    if (heap->compare != NULL)
+        return heap->compare(a, b);
+    return min_heap_compare_keys(heap->ext, a, b);
+}
+
+/*!
+ * \brief Compare two items of the heap given their indices
+ * \details In stable mode equal items are ordered by their insertion sequence,
+ *      the difference is evaluated as a signed number so that the counter
+ *      can safely wrap around
+ */
+static inline int8_t min_heap_compare_at(const MinHeapHandler_t *heap, size_t a, size_t b) {
+    int8_t cmp = min_heap_compare_items(heap, MIN_HEAP_ITEM(heap, a), MIN_HEAP_ITEM(heap, b));
+    if (cmp != 0 || heap->ext == NULL || heap->ext->seq == NULL)
+        return cmp;
+    int32_t diff = (int32_t)(heap->ext->seq[a] - heap->ext->seq[b]);
+    if (diff < 0)
+        return -1;
+    return diff == 0 ? 0 : 1;
+}
+
+/*!
+ * \brief Store the slot of an item in the position of its handle
+ */
+static inline void min_heap_track(MinHeapHandler_t *heap, size_t slot) {
+    const MinHeapExtension_t *ext = heap->ext;
+    if (ext == NULL || ext->positions == NULL)
+        return;
+    uint32_t handle;
+    memcpy(&handle, MIN_HEAP_ITEM(heap, slot) + ext->handle_offset, sizeof(handle));
+    if (handle < ext->handle_count)
+        ext->positions[handle] = (uint32_t)slot;
+}
+
+/*!
+ * \brief Store the slots of all the items
+ */
+static void min_heap_track_all(MinHeapHandler_t *heap) {
+    if (heap->ext == NULL || heap->ext->positions == NULL)
+        return;
+    for (size_t i = 0; i < heap->size; ++i)
+        min_heap_track(heap, i);
+}
+
+/*!
+ * \brief Compare two items with the compare function given their indices
+ */
+static inline int8_t min_heap_compare_plain(const MinHeapHandler_t *heap, size_t a, size_t b) {
+    return heap->compare(MIN_HEAP_ITEM(heap, a), MIN_HEAP_ITEM(heap, b));
+}
+
+/*!
+ * \brief Compare two items with the key specification given their indices
+ */
+static inline int8_t min_heap_compare_keys_at(const MinHeapHandler_t *heap, size_t a, size_t b) {
+    return min_heap_compare_keys(heap->ext, MIN_HEAP_ITEM(heap, a), MIN_HEAP_ITEM(heap, b));
+}
+
+/*!
+ * \brief Swap two items without updating any per slot state
+ */
+static inline void min_heap_swap_plain(MinHeapHandler_t *heap, size_t a, size_t b) {
+    uint8_t *pa = MIN_HEAP_ITEM(heap, a);
+    uint8_t *pb = MIN_HEAP_ITEM(heap, b);
     uint8_t aux[heap->data_size]; //local buffer as a swapping area
-    memcpy(aux, a, heap->data_size);
-    memcpy(a, b, heap->data_size);
-    memcpy(b, aux, heap->data_size);
+    memcpy(aux, pa, heap->data_size);
+    memcpy(pa, pb, heap->data_size);
+    memcpy(pb, aux, heap->data_size);
 }
 
-MinHeapReturnCode min_heap_api_init(
+static inline void min_heap_swap(MinHeapHandler_t *heap, size_t a, size_t b) {
+    min_heap_swap_plain(heap, a, b);
+    MinHeapExtension_t *ext = heap->ext;
+    if (ext == NULL)
+        return;
+    if (ext->seq != NULL) {
+        uint32_t seq = ext->seq[a];
+        ext->seq[a] = ext->seq[b];
+        ext->seq[b] = seq;
+    }
+    min_heap_track(heap, a);
+    min_heap_track(heap, b);
+}
+
+/*!
+ * \brief Swap two items during a transaction, their slots are saved in the undo log first
+ */
+static inline void min_heap_swap_txn(MinHeapHandler_t *heap, size_t a, size_t b) {
+    min_heap_txn_record(heap, a);
+    min_heap_txn_record(heap, b);
+    min_heap_swap(heap, a, b);
+}
+
+/*!
+ * \brief Macro to define the sift functions of a variant of the heap
+ * \details The variant is chosen once at the beginning of each operation,
+ *      so the loops do not check at every step which features are enabled.
+ *      The right child is picked by adding the comparison result to the left
+ *      index, so the compiler emits a conditional set instead of a branch that
+ *      is mispredicted half of the times on random keys
+ *
+ * \param N The suffix of the function names
+ * \param CMP The function that compares two items given their indices
+ * \param SWAP The function that swaps two items given their indices
+ */
+#define MIN_HEAP_SIFT_FN(N, CMP, SWAP)                                                            \
+    static size_t min_heap_sift_up_##N(MinHeapHandler_t *heap, size_t index, int8_t order) {     \
+        size_t parent = MIN_HEAP_PARENT(index);                                                   \
+        while (index != 0 && order * CMP(heap, index, parent) < 0) {                              \
+            SWAP(heap, index, parent);                                                            \
+            index = parent;                                                                       \
+            parent = MIN_HEAP_PARENT(index);                                                      \
+        }                                                                                         \
+        return index;                                                                             \
+    }                                                                                             \
+    static size_t min_heap_sift_down_##N(MinHeapHandler_t *heap, size_t index, int8_t order) {   \
+        size_t l = MIN_HEAP_CHILD_L(index);                                                       \
+        while (l < heap->size) {                                                                  \
+            size_t child = l;                                                                     \
+            if (MIN_HEAP_CHILD_R(index) < heap->size)                                             \
+                child += order * CMP(heap, l, l + 1) >= 0;                                        \
+            if (order * CMP(heap, child, index) >= 0)                                             \
+                break;                                                                            \
+            SWAP(heap, index, child);                                                             \
+            index = child;                                                                        \
+            l = MIN_HEAP_CHILD_L(index);                                                          \
+        }                                                                                         \
+        return index;                                                                             \
+    }
+
+MIN_HEAP_SIFT_FN(plain, min_heap_compare_plain, min_heap_swap_plain)
+MIN_HEAP_SIFT_FN(keys, min_heap_compare_keys_at, min_heap_swap_plain)
+MIN_HEAP_SIFT_FN(ext, min_heap_compare_at, min_heap_swap)
+MIN_HEAP_SIFT_FN(txn, min_heap_compare_at, min_heap_swap_txn)
+
+/*!
+ * \brief Move an item up in a heap with a single key field and no state for each slot
+ * \details The comparison function, the offset of the field and the size are
+ *      loaded once, the generic loops load them again after every swap since
+ *      the items are copied through byte pointers
+ */
+static size_t min_heap_sift_up_key(MinHeapHandler_t *heap, size_t index, int8_t order) {
+    int8_t (*compare)(const uint8_t *, const uint8_t *) = heap->ext->key_compare[0];
+    const uint8_t *field = (const uint8_t *)heap->data + heap->ext->keys[0].offset;
+    const size_t data_size = heap->data_size;
+    size_t parent = MIN_HEAP_PARENT(index);
+    while (index != 0 && order * compare(field + index * data_size, field + parent * data_size) < 0) {
+        min_heap_swap_plain(heap, index, parent);
+        index = parent;
+        parent = MIN_HEAP_PARENT(index);
+    }
+    return index;
+}
+
+/*!
+ * \brief Move an item down in a heap with a single key field and no state for each slot
+ */
+static size_t min_heap_sift_down_key(MinHeapHandler_t *heap, size_t index, int8_t order) {
+    int8_t (*compare)(const uint8_t *, const uint8_t *) = heap->ext->key_compare[0];
+    const uint8_t *field = (const uint8_t *)heap->data + heap->ext->keys[0].offset;
+    const size_t data_size = heap->data_size;
+    const size_t size = heap->size;
+    size_t l = MIN_HEAP_CHILD_L(index);
+    while (l < size) {
+        size_t child = l;
+        if (MIN_HEAP_CHILD_R(index) < size)
+            child += order * compare(field + l * data_size, field + (l + 1) * data_size) >= 0;
+        if (order * compare(field + child * data_size, field + index * data_size) >= 0)
+            break;
+        min_heap_swap_plain(heap, index, child);
+        index = child;
+        l = MIN_HEAP_CHILD_L(index);
+    }
+    return index;
+}
+
+/*!
+ * \brief Variants of the sift functions
+ */
+typedef enum {
+    MIN_HEAP_SIFT_PLAIN,  // Compare function and no state for each slot
+    MIN_HEAP_SIFT_KEY,    // Key specification with a single field and no state for each slot
+    MIN_HEAP_SIFT_KEYS,   // Key specification and no state for each slot
+    MIN_HEAP_SIFT_EXT,    // Stable mode or handles, the state of each slot moves with its item
+    MIN_HEAP_SIFT_TXN     // During a transaction, the slots are saved in the undo log
+} MinHeapSiftVariant;
+
+/*!
+ * \brief Choose the variant of the sift functions for the features enabled on the heap
+ */
+static inline MinHeapSiftVariant min_heap_sift_variant(const MinHeapHandler_t *heap) {
+    const MinHeapExtension_t *ext = heap->ext;
+    if (ext == NULL)
+        return MIN_HEAP_SIFT_PLAIN;
+    if (ext->txn_active)
+        return MIN_HEAP_SIFT_TXN;
+    if (ext->seq != NULL || ext->positions != NULL)
+        return MIN_HEAP_SIFT_EXT;
+    if (heap->compare != NULL)
+        return MIN_HEAP_SIFT_PLAIN;
+    return ext->key_count == 1 ? MIN_HEAP_SIFT_KEY : MIN_HEAP_SIFT_KEYS;
+}
+
+/*!
+ * \brief Move an item up until its parent is lower (or greater with the max order)
+ *
+ * \param heap The heap handler structure
+ * \param index The index of the item to move
+ * \param order MIN_HEAP_ORDER_MIN or MIN_HEAP_ORDER_MAX
+ * \return size_t The final index of the item
+ */
+static size_t min_heap_sift_up(MinHeapHandler_t *heap, size_t index, int8_t order) {
+    switch (min_heap_sift_variant(heap)) {
+        case MIN_HEAP_SIFT_PLAIN:
+            return min_heap_sift_up_plain(heap, index, order);
+        case MIN_HEAP_SIFT_KEY:
+            return min_heap_sift_up_key(heap, index, order);
+        case MIN_HEAP_SIFT_KEYS:
+            return min_heap_sift_up_keys(heap, index, order);
+        case MIN_HEAP_SIFT_EXT:
+            return min_heap_sift_up_ext(heap, index, order);
+        default:
+            return min_heap_sift_up_txn(heap, index, order);
+    }
+}
+
+/*!
+ * \brief Move an item down until both its children are greater (or lower with the max order)
+ *
+ * \param heap The heap handler structure
+ * \param index The index of the item to move
+ * \param order MIN_HEAP_ORDER_MIN or MIN_HEAP_ORDER_MAX
+ * \return size_t The final index of the item
+ */
+static size_t min_heap_sift_down(MinHeapHandler_t *heap, size_t index, int8_t order) {
+    switch (min_heap_sift_variant(heap)) {
+        case MIN_HEAP_SIFT_PLAIN:
+            return min_heap_sift_down_plain(heap, index, order);
+        case MIN_HEAP_SIFT_KEY:
+            return min_heap_sift_down_key(heap, index, order);
+        case MIN_HEAP_SIFT_KEYS:
+            return min_heap_sift_down_keys(heap, index, order);
+        case MIN_HEAP_SIFT_EXT:
+            return min_heap_sift_down_ext(heap, index, order);
+        default:
+            return min_heap_sift_down_txn(heap, index, order);
+    }
+}
+
+/*!
+ * \brief Get the index of the k-th counter of an item in the Bloom filter
+ * \details The k hashes are derived from a single one with double hashing
+ */
+static inline size_t min_heap_bloom_index(const MinHeapExtension_t *ext, uint32_t hash, size_t k) {
+    uint32_t step = ((hash >> 17) | (hash << 15)) | 1U;
+    return (size_t)(hash + k * step) % ext->bloom_size;
+}
+
+static inline void min_heap_bloom_add(MinHeapHandler_t *heap, void *item) {
+    MinHeapExtension_t *ext = heap->ext;
+    if (ext == NULL || ext->bloom == NULL)
+        return;
+    uint32_t hash = ext->hash(item);
+    for (size_t k = 0; k < MIN_HEAP_BLOOM_HASHES; ++k) {
+        uint8_t *counter = ext->bloom + min_heap_bloom_index(ext, hash, k);
+        // Saturated counters are never decremented to avoid false negatives
+        if (*counter < UINT8_MAX)
+            ++*counter;
+    }
+}
+
+static inline void min_heap_bloom_remove(MinHeapHandler_t *heap, void *item) {
+    MinHeapExtension_t *ext = heap->ext;
+    if (ext == NULL || ext->bloom == NULL)
+        return;
+    uint32_t hash = ext->hash(item);
+    for (size_t k = 0; k < MIN_HEAP_BLOOM_HASHES; ++k) {
+        uint8_t *counter = ext->bloom + min_heap_bloom_index(ext, hash, k);
+        if (*counter > 0 && *counter < UINT8_MAX)
+            --*counter;
+    }
+}
+
+static inline bool min_heap_bloom_may_contain(const MinHeapHandler_t *heap, void *item) {
+    const MinHeapExtension_t *ext = heap->ext;
+    if (ext == NULL || ext->bloom == NULL)
+        return true;
+    uint32_t hash = ext->hash(item);
+    for (size_t k = 0; k < MIN_HEAP_BLOOM_HASHES; ++k) {
+        if (ext->bloom[min_heap_bloom_index(ext, hash, k)] == 0)
+            return false;
+    }
+    return true;
+}
+
+/*!
+ * \brief Clear the Bloom filter, if it is enabled
+ */
+static inline void min_heap_bloom_clear(MinHeapHandler_t *heap) {
+    if (heap->ext != NULL && heap->ext->bloom != NULL)
+        memset(heap->ext->bloom, 0, heap->ext->bloom_size);
+}
+
+/*!
+ * \brief Get the extension of the heap, it is allocated the first time an
+ *      optional feature is enabled
+ *
+ * \return MinHeapExtension_t * The extension, NULL if it cannot be allocated
+ */
+static MinHeapExtension_t *min_heap_extension(MinHeapHandler_t *heap, ArenaAllocatorHandler_t *arena) {
+    if (heap->ext == NULL)
+        heap->ext = arena_allocator_api_calloc(arena, sizeof(MinHeapExtension_t), 1);
+    return heap->ext;
+}
+
+/*!
+ * \brief Initialize the heap without any optional feature
+ */
+static MinHeapReturnCode min_heap_init(
     MinHeapHandler_t *heap,
     size_t data_size,
     size_t capacity,
     int8_t (*compare)(void *, void *),
     ArenaAllocatorHandler_t *arena) {
-    if (heap == NULL || compare == NULL || arena == NULL)
-        return MIN_HEAP_NULL_POINTER;
     heap->data_size = data_size;
     heap->size = 0;
     heap->capacity = capacity;
     heap->compare = compare;
+    heap->ext = NULL;
     heap->data = arena_allocator_api_calloc(arena, data_size, capacity);
     if (heap->data == NULL)
         return MIN_HEAP_NULL_POINTER;
     return MIN_HEAP_OK;
 }
 
+MinHeapReturnCode min_heap_api_init(
+    MinHeapHandler_t *heap,
+    size_t data_size,
+    size_t capacity,
+    int8_t (*compare)(void *, void *),
+    ArenaAllocatorHandler_t *arena) {
+    if (heap == NULL || compare == NULL || arena == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    return min_heap_init(heap, data_size, capacity, compare, arena);
+}
+
+/*!
+ * \brief Get the size in bytes of a key field
+ */
+static inline size_t min_heap_key_width(MinHeapKeyType type) {
+    switch (type) {
+        case MIN_HEAP_KEY_U8:
+        case MIN_HEAP_KEY_I8:
+            return sizeof(uint8_t);
+        case MIN_HEAP_KEY_U16:
+        case MIN_HEAP_KEY_I16:
+            return sizeof(uint16_t);
+        case MIN_HEAP_KEY_U32:
+        case MIN_HEAP_KEY_I32:
+        case MIN_HEAP_KEY_FLOAT:
+            return sizeof(uint32_t);
+        default:
+            return sizeof(uint64_t);
+    }
+}
+
+MinHeapReturnCode min_heap_api_init_keys(
+    MinHeapHandler_t *heap,
+    size_t data_size,
+    size_t capacity,
+    const MinHeapKeyField_t *keys,
+    size_t key_count,
+    ArenaAllocatorHandler_t *arena) {
+    if (heap == NULL || keys == NULL || arena == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (key_count == 0)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    for (size_t i = 0; i < key_count; ++i) {
+        if (keys[i].type > MIN_HEAP_KEY_DOUBLE || (keys[i].order != MIN_HEAP_KEY_ASC && keys[i].order != MIN_HEAP_KEY_DESC))
+            return MIN_HEAP_OUT_OF_BOUNDS;
+        // The field must lie entirely inside the item
+        if (keys[i].offset > data_size || data_size - keys[i].offset < min_heap_key_width(keys[i].type))
+            return MIN_HEAP_OUT_OF_BOUNDS;
+    }
+
+    MinHeapReturnCode res = min_heap_init(heap, data_size, capacity, NULL, arena);
+    if (res != MIN_HEAP_OK)
+        return res;
+
+    // The specification is copied so that the caller does not need to keep it
+    MinHeapExtension_t *ext = min_heap_extension(heap, arena);
+    MinHeapKeyField_t *copy = arena_allocator_api_calloc(arena, sizeof(MinHeapKeyField_t), key_count);
+    int8_t (**fns)(const uint8_t *, const uint8_t *) = arena_allocator_api_calloc(arena, sizeof(*fns), key_count);
+    if (ext == NULL || copy == NULL || fns == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    memcpy(copy, keys, key_count * sizeof(MinHeapKeyField_t));
+    for (size_t i = 0; i < key_count; ++i)
+        fns[i] = min_heap_key_compare_table[keys[i].type][keys[i].order == MIN_HEAP_KEY_ASC ? 0 : 1];
+    ext->keys = copy;
+    ext->key_compare = fns;
+    ext->key_count = key_count;
+    return MIN_HEAP_OK;
+}
+
+int8_t min_heap_api_compare(const MinHeapHandler_t *heap, void *a, void *b) {
+    return min_heap_compare_items(heap, a, b);
+}
+
 size_t min_heap_api_size(const MinHeapHandler_t *heap) {
     return heap == NULL ? 0U : heap->size;
 }
@@ -88,37 +617,37 @@ MinHeapReturnCode min_heap_api_clear(MinHeapHandler_t *heap) {
     if (heap == NULL)
         return MIN_HEAP_NULL_POINTER;
     heap->size = 0;
+    min_heap_bloom_clear(heap);
     return MIN_HEAP_OK;
 }
 
 MinHeapReturnCode min_heap_api_insert(MinHeapHandler_t *heap, void *item) {
-    if (heap == NULL || item == NULL || heap->compare == NULL || heap->data == NULL)
+    if (heap == NULL || item == NULL || !MIN_HEAP_HAS_COMPARE(heap) || heap->data == NULL)
         return MIN_HEAP_NULL_POINTER;
     if (heap->size == heap->capacity)
         return MIN_HEAP_FULL;
 
     // Insert item at the end of the heap
-    const size_t data_size = heap->data_size;
     size_t cur = heap->size;
-    uint8_t *base = (uint8_t *)heap->data;
-    memcpy(base + cur * data_size, item, data_size);
+    MinHeapExtension_t *ext = heap->ext;
+    if (ext != NULL && ext->txn_active)
+        min_heap_txn_record(heap, cur);
+    memcpy(MIN_HEAP_ITEM(heap, cur), item, heap->data_size);
+    if (ext != NULL) {
+        if (ext->seq != NULL)
+            ext->seq[cur] = ext->next_seq++;
+        min_heap_track(heap, cur);
+        min_heap_bloom_add(heap, item);
+    }
     ++heap->size;
 
     // Restore heap properties
-    size_t parent = MIN_HEAP_PARENT(cur);
-    while (cur != 0 && heap->compare(base + cur * data_size, base + parent * data_size) < 0) {
-        // Swap items
-        min_heap_swap(heap, base + cur * data_size, base + parent * data_size);
-
-        // Update indices
-        cur = parent;
-        parent = MIN_HEAP_PARENT(cur);
-    }
+    min_heap_sift_up(heap, cur, MIN_HEAP_ORDER_MIN);
     return MIN_HEAP_OK;
 }
 
 MinHeapReturnCode min_heap_api_remove(MinHeapHandler_t *heap, size_t index, void *out) {
-    if (heap == NULL || heap->compare == NULL)
+    if (heap == NULL || !MIN_HEAP_HAS_COMPARE(heap))
         return MIN_HEAP_NULL_POINTER;
     if (heap->size == 0)
         return MIN_HEAP_EMPTY;
@@ -126,76 +655,839 @@ MinHeapReturnCode min_heap_api_remove(MinHeapHandler_t *heap, size_t index, void
         return MIN_HEAP_OUT_OF_BOUNDS;
 
     // Swap the error with the last one in the heap (if not the same)
-    uint8_t *base = (uint8_t *)heap->data;
-    const size_t data_size = heap->data_size;
-    if (heap->size > 1)
-        min_heap_swap(heap, base + index * data_size, base + (heap->size - 1) * data_size);
+    if (heap->size > 1 && MIN_HEAP_IN_TXN(heap))
+        min_heap_swap_txn(heap, index, heap->size - 1);
+    else if (heap->size > 1)
+        min_heap_swap(heap, index, heap->size - 1);
 
     // Remove last element
     --heap->size;
+    min_heap_bloom_remove(heap, MIN_HEAP_ITEM(heap, heap->size));
 
     // Copy element
     if (out != NULL)
-        memcpy(out, base + heap->size * data_size, data_size);
+        memcpy(out, MIN_HEAP_ITEM(heap, heap->size), heap->data_size);
 
     if (index == heap->size)
         return MIN_HEAP_OK;
 
     // Restore heap properties
-    int8_t cmp = heap->compare(base + index * data_size, base + heap->size * data_size);
+    int8_t cmp = min_heap_compare_at(heap, index, heap->size);
     // Up-heapify
-    if (cmp < 0) {
-        size_t parent = MIN_HEAP_PARENT(index);
-        while (index != 0 && heap->compare(base + index * data_size, base + parent * data_size) < 0) {
-            // Swap items
-            min_heap_swap(heap, base + index * data_size, base + parent * data_size);
-
-            // Update indices
-            index = parent;
-            parent = MIN_HEAP_PARENT(index);
-        }
-    }
+    if (cmp < 0)
+        min_heap_sift_up(heap, index, MIN_HEAP_ORDER_MIN);
     // Down-heapify
-    else if (cmp > 0) {
-        // Restore heap properties
-        size_t l = MIN_HEAP_CHILD_L(index);
-        size_t r = MIN_HEAP_CHILD_R(index);
-        size_t child = (r >= heap->size)
-                           ? l
-                           : (heap->compare(base + l * data_size, base + r * data_size) < 0
-                                  ? l
-                                  : r);
-
-        // Until a leaf is reached (or the parent has only the left child)
-        while (r < heap->size && heap->compare(base + child * data_size, base + index * data_size) < 0) {
-            min_heap_swap(heap, base + index * data_size, base + child * data_size);
-
-            // Update indices
-            index = child;
-            l = MIN_HEAP_CHILD_L(index);
-            r = MIN_HEAP_CHILD_R(index);
-            child = (r >= heap->size)
-                        ? l
-                        : (heap->compare(base + l * data_size, base + r * data_size) < 0
-                               ? l
-                               : r);
-        }
-
-        // Check left child
-        if (l < heap->size && heap->compare(base + l * data_size, base + index * data_size) < 0)
-            min_heap_swap(heap, base + index * data_size, base + child * data_size);
-    }
+    else if (cmp > 0)
+        min_heap_sift_down(heap, index, MIN_HEAP_ORDER_MIN);
     return MIN_HEAP_OK;
 }
 
 signed_size_t min_heap_api_find(const MinHeapHandler_t *heap, void *item) {
-    if (heap == NULL || item == NULL || heap->compare == NULL || heap->size == 0 || heap->data == NULL)
+    if (heap == NULL || item == NULL || !MIN_HEAP_HAS_COMPARE(heap) || heap->size == 0 || heap->data == NULL)
+        return -1;
+    if (!min_heap_bloom_may_contain(heap, item))
         return -1;
 
     for (size_t i = 0; i < heap->size; ++i) {
-        if (heap->compare(item, (uint8_t *)heap->data + heap->data_size * i) == 0)
+        if (min_heap_compare_items(heap, item, MIN_HEAP_ITEM(heap, i)) == 0)
             return i;
     }
 
     return -1;
-}
\ No newline at end of file
+}
+
+size_t min_heap_api_pop_k(MinHeapHandler_t *heap, void *out, size_t k) {
+    if (heap == NULL || !MIN_HEAP_HAS_COMPARE(heap))
+        return 0U;
+    size_t count = 0;
+    for (; count < k && heap->size > 0; ++count)
+        min_heap_api_remove(heap, 0, out == NULL ? NULL : (uint8_t *)out + count * heap->data_size);
+    return count;
+}
+
+MinHeapReturnCode min_heap_api_pop_with(MinHeapHandler_t *heap, void (*fn)(void *item, void *ctx), void *ctx) {
+    if (heap == NULL || fn == NULL || !MIN_HEAP_HAS_COMPARE(heap))
+        return MIN_HEAP_NULL_POINTER;
+    if (heap->size == 0)
+        return MIN_HEAP_EMPTY;
+
+    // The root is consumed in place before its slot is overwritten by the removal
+    fn(heap->data, ctx);
+    return min_heap_api_remove(heap, 0, NULL);
+}
+
+size_t min_heap_api_pop_k_with(MinHeapHandler_t *heap, void (*fn)(void *item, void *ctx), void *ctx, size_t k) {
+    size_t count = 0;
+    while (count < k && min_heap_api_pop_with(heap, fn, ctx) == MIN_HEAP_OK)
+        ++count;
+    return count;
+}
+
+size_t min_heap_api_collect_below(const MinHeapHandler_t *heap, void *bound, void *out, size_t max) {
+    if (heap == NULL || bound == NULL || out == NULL || !MIN_HEAP_HAS_COMPARE(heap) || heap->data == NULL)
+        return 0U;
+    if (heap->size == 0 || max == 0 || min_heap_compare_items(heap, heap->data, bound) > 0)
+        return 0U;
+
+    // Iterative pre-order visit of the subtree whose items are not greater than the bound,
+    // every visited item compares at most its two children
+    uint8_t *dst = (uint8_t *)out;
+    size_t count = 0;
+    size_t cur = 0;
+    while (true) {
+        memcpy(dst + count * heap->data_size, MIN_HEAP_ITEM(heap, cur), heap->data_size);
+        if (++count == max)
+            break;
+
+        // Descend to the first child in range
+        size_t l = MIN_HEAP_CHILD_L(cur);
+        size_t r = MIN_HEAP_CHILD_R(cur);
+        if (l < heap->size && min_heap_compare_items(heap, MIN_HEAP_ITEM(heap, l), bound) <= 0) {
+            cur = l;
+            continue;
+        }
+        if (r < heap->size && min_heap_compare_items(heap, MIN_HEAP_ITEM(heap, r), bound) <= 0) {
+            cur = r;
+            continue;
+        }
+
+        // Go up until a right sibling in range is found
+        while (cur != 0) {
+            // Left children have an odd index
+            if ((cur & 1U) && cur + 1 < heap->size && min_heap_compare_items(heap, MIN_HEAP_ITEM(heap, cur + 1), bound) <= 0)
+                break;
+            cur = MIN_HEAP_PARENT(cur);
+        }
+        if (cur == 0)
+            break;
+        ++cur;
+    }
+    return count;
+}
+
+MinHeapReturnCode min_heap_api_remove_by_value(MinHeapHandler_t *heap, void *item, void *out) {
+    if (heap == NULL || item == NULL || !MIN_HEAP_HAS_COMPARE(heap))
+        return MIN_HEAP_NULL_POINTER;
+    signed_size_t index = min_heap_api_find(heap, item);
+    if (index < 0)
+        return MIN_HEAP_NOT_FOUND;
+    return min_heap_api_remove(heap, (size_t)index, out);
+}
+
+/*!
+ * \brief Check if the heap has a single 32 bit integer key and get the mask
+ *      that maps it to a signed ascending key
+ * \details Flipping the sign bit turns the unsigned order into the signed one
+ *      and flipping every bit reverses the order, so the vectorized build can
+ *      always use the signed minimum
+ *
+ * \param heap The heap handler structure
+ * \param mask Where to store the mask to XOR with the keys
+ * \return bool True if the keys can be processed as 32 bit integers
+ */
+static inline bool min_heap_build_key_mask(const MinHeapHandler_t *heap, uint32_t *mask) {
+    const MinHeapExtension_t *ext = heap->ext;
+    if (ext == NULL || ext->keys == NULL || ext->key_count != 1 || ext->seq != NULL || heap->data_size != sizeof(uint32_t))
+        return false;
+    const MinHeapKeyField_t *key = &ext->keys[0];
+    if (key->offset != 0 || (key->type != MIN_HEAP_KEY_I32 && key->type != MIN_HEAP_KEY_U32))
+        return false;
+    *mask = key->type == MIN_HEAP_KEY_U32 ? 0x80000000U : 0U;
+    if (key->order == MIN_HEAP_KEY_DESC)
+        *mask = ~*mask;
+    return true;
+}
+
+#ifdef MIN_HEAP_BUILD_AVX2
+/*!
+ * \brief Sift down by one level groups of 8 consecutive parents whose children are leaves
+ * \details The 16 children of a group are contiguous, they are split in the
+ *      left and right ones, compared with the parents and merged back with
+ *      blends, which gives the same result of min_heap_sift_down without branches
+ *
+ * \param keys The 32 bit keys of the heap
+ * \param first The first parent index
+ * \param last The index after the last parent, all the parents must have two leaf children
+ * \param mask The mask returned by min_heap_build_key_mask
+ * \return size_t The index of the first parent that has not been processed
+ */
+__attribute__((target("avx2"))) static size_t min_heap_build_leaves_avx2(
+    uint32_t *keys,
+    size_t first,
+    size_t last,
+    uint32_t mask) {
+    const __m256i m = _mm256_set1_epi32((int32_t)mask);
+    size_t i = first;
+    for (; i + 8 <= last; i += 8) {
+        __m256i *parents = (__m256i *)(keys + i);
+        __m256i *children = (__m256i *)(keys + MIN_HEAP_CHILD_L(i));
+        __m256i p = _mm256_xor_si256(_mm256_loadu_si256(parents), m);
+        __m256 lo = _mm256_castsi256_ps(_mm256_xor_si256(_mm256_loadu_si256(children), m));
+        __m256 hi = _mm256_castsi256_ps(_mm256_xor_si256(_mm256_loadu_si256(children + 1), m));
+
+        // Split the even (left) and the odd (right) children
+        __m256i l = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(lo, hi, 0x88)), 0xD8);
+        __m256i r = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(lo, hi, 0xDD)), 0xD8);
+
+        // On equal children the right one is chosen, as in min_heap_sift_down
+        __m256i pick_l = _mm256_cmpgt_epi32(r, l);
+        __m256i child = _mm256_min_epi32(l, r);
+        __m256i swap = _mm256_cmpgt_epi32(p, child);
+        __m256i new_l = _mm256_blendv_epi8(l, p, _mm256_and_si256(swap, pick_l));
+        __m256i new_r = _mm256_blendv_epi8(r, p, _mm256_andnot_si256(pick_l, swap));
+        p = _mm256_min_epi32(p, child);
+
+        // Interleave the children back
+        __m256i even = _mm256_unpacklo_epi32(new_l, new_r);
+        __m256i odd = _mm256_unpackhi_epi32(new_l, new_r);
+        _mm256_storeu_si256(parents, _mm256_xor_si256(p, m));
+        _mm256_storeu_si256(children, _mm256_xor_si256(_mm256_permute2x128_si256(even, odd, 0x20), m));
+        _mm256_storeu_si256(children + 1, _mm256_xor_si256(_mm256_permute2x128_si256(even, odd, 0x31), m));
+    }
+    return i;
+}
+#endif
+
+MinHeapReturnCode min_heap_api_set_simd(MinHeapHandler_t *heap, bool enabled) {
+    if (heap == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    // Only the heaps with a key specification have vectorized kernels
+    if (heap->ext != NULL)
+        heap->ext->no_simd = !enabled;
+    return MIN_HEAP_OK;
+}
+
+/*!
+ * \brief Copy the items of a bulk load in the heap buffer (they can already be in it)
+ * \details During a transaction every overwritten slot is saved before the
+ *      copy, so the load can be rolled back
+ */
+static void min_heap_load(MinHeapHandler_t *heap, void *items, size_t count) {
+    if (MIN_HEAP_IN_TXN(heap)) {
+        for (size_t i = 0; i < count; ++i)
+            min_heap_txn_record(heap, i);
+    }
+    memmove(heap->data, items, count * heap->data_size);
+}
+
+/*!
+ * \brief Set the size of the heap after a bulk load, the sequences are
+ *      assigned in the order of the buffer and the Bloom filter is rebuilt
+ */
+static void min_heap_load_finish(MinHeapHandler_t *heap, size_t count) {
+    heap->size = count;
+    MinHeapExtension_t *ext = heap->ext;
+    if (ext == NULL)
+        return;
+    if (ext->seq != NULL) {
+        for (size_t i = 0; i < count; ++i)
+            ext->seq[i] = ext->next_seq++;
+    }
+    if (ext->bloom != NULL) {
+        min_heap_bloom_clear(heap);
+        for (size_t i = 0; i < count; ++i)
+            min_heap_bloom_add(heap, MIN_HEAP_ITEM(heap, i));
+    }
+}
+
+MinHeapReturnCode min_heap_api_build(MinHeapHandler_t *heap, void *items, size_t count) {
+    if (heap == NULL || items == NULL || !MIN_HEAP_HAS_COMPARE(heap) || heap->data == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (count > heap->capacity)
+        return MIN_HEAP_FULL;
+
+    min_heap_load(heap, items, count);
+    min_heap_load_finish(heap, count);
+
+    // Floyd's method, the parents are the items before count / 2
+    size_t next = count / 2;
+#ifdef MIN_HEAP_BUILD_AVX2
+    uint32_t mask;
+    if (count > 1 && min_heap_build_key_mask(heap, &mask) && !heap->ext->no_simd && __builtin_cpu_supports("avx2")) {
+        // The parents from next / 2 have only leaf children
+        size_t first = next / 2;
+        size_t done = min_heap_build_leaves_avx2(heap->data, first, (count - 1) / 2, mask);
+        for (size_t i = next; i > done; --i)
+            min_heap_sift_down(heap, i - 1, MIN_HEAP_ORDER_MIN);
+        next = first;
+    }
+#endif
+    while (next > 0)
+        min_heap_sift_down(heap, --next, MIN_HEAP_ORDER_MIN);
+    min_heap_track_all(heap);
+    return MIN_HEAP_OK;
+}
+
+/*!
+ * \brief Number of bits of a digit of the radix sort
+ */
+#define MIN_HEAP_RADIX_BITS (8U)
+#define MIN_HEAP_RADIX_SIZE (1U << MIN_HEAP_RADIX_BITS)
+
+/*!
+ * \brief Map a key field to an unsigned integer with the same order
+ * \details Signed integers have the sign bit flipped, negative floating point
+ *      numbers have every bit flipped and positive ones the sign bit only,
+ *      descending fields are complemented
+ *
+ * \param key The key field
+ * \param item The item
+ * \return uint64_t The mapped key, it uses only the bytes of the field
+ */
+static inline uint64_t min_heap_radix_key(const MinHeapKeyField_t *key, const uint8_t *item) {
+    const size_t width = min_heap_key_width(key->type);
+    const uint64_t sign = 1ULL << (width * 8U - 1U);
+    const uint64_t all = sign | (sign - 1U);
+    uint64_t value = 0U;
+    const uint8_t *field = item + key->offset;
+    switch (width) {
+        case sizeof(uint8_t): {
+            uint8_t v;
+            memcpy(&v, field, sizeof(v));
+            value = v;
+        } break;
+        case sizeof(uint16_t): {
+            uint16_t v;
+            memcpy(&v, field, sizeof(v));
+            value = v;
+        } break;
+        case sizeof(uint32_t): {
+            uint32_t v;
+            memcpy(&v, field, sizeof(v));
+            value = v;
+        } break;
+        default:
+            memcpy(&value, field, sizeof(value));
+            break;
+    }
+
+    switch (key->type) {
+        case MIN_HEAP_KEY_I8:
+        case MIN_HEAP_KEY_I16:
+        case MIN_HEAP_KEY_I32:
+        case MIN_HEAP_KEY_I64:
+            value ^= sign;
+            break;
+        case MIN_HEAP_KEY_FLOAT:
+        case MIN_HEAP_KEY_DOUBLE:
+            value = (value & sign) ? (~value & all) : (value | sign);
+            break;
+        default:
+            break;
+    }
+    return key->order == MIN_HEAP_KEY_DESC ? (~value & all) : value;
+}
+
+MinHeapReturnCode min_heap_api_build_radix(MinHeapHandler_t *heap, void *items, size_t count, void *scratch) {
+    if (heap == NULL || items == NULL || scratch == NULL || heap->data == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (heap->ext == NULL || heap->ext->keys == NULL)
+        return MIN_HEAP_INVALID_STATE;
+    if (count > heap->capacity)
+        return MIN_HEAP_FULL;
+
+    min_heap_load(heap, items, count);
+    const MinHeapExtension_t *ext = heap->ext;
+
+    // LSD radix sort, from the least significant digit of the last field,
+    // the items move back and forth between the heap buffer and the scratch one
+    const size_t size = heap->data_size;
+    uint8_t *src = heap->data;
+    uint8_t *dst = scratch;
+    for (size_t f = ext->key_count; f > 0; --f) {
+        // Local copy, so that the writes to the buffers cannot alias it
+        const MinHeapKeyField_t key = ext->keys[f - 1];
+        const size_t digits = min_heap_key_width(key.type) * 8U / MIN_HEAP_RADIX_BITS;
+        for (size_t d = 0; d < digits; ++d) {
+            const size_t shift = d * MIN_HEAP_RADIX_BITS;
+            size_t offsets[MIN_HEAP_RADIX_SIZE] = { 0 };
+            for (size_t i = 0; i < count; ++i)
+                ++offsets[(min_heap_radix_key(&key, src + i * size) >> shift) & (MIN_HEAP_RADIX_SIZE - 1U)];
+
+            // Skip the digits that are equal for every item
+            bool trivial = false;
+            size_t total = 0;
+            for (size_t b = 0; b < MIN_HEAP_RADIX_SIZE; ++b) {
+                trivial = trivial || offsets[b] == count;
+                size_t n = offsets[b];
+                offsets[b] = total;
+                total += n;
+            }
+            if (trivial)
+                continue;
+
+            for (size_t i = 0; i < count; ++i) {
+                const uint8_t *item = src + i * size;
+                size_t b = (min_heap_radix_key(&key, item) >> shift) & (MIN_HEAP_RADIX_SIZE - 1U);
+                memcpy(dst + offsets[b]++ * size, item, size);
+            }
+            uint8_t *tmp = src;
+            src = dst;
+            dst = tmp;
+        }
+    }
+    if (src != heap->data)
+        memcpy(heap->data, src, count * heap->data_size);
+
+    // A sorted array is already a heap, in stable mode the order of equal items is kept
+    min_heap_load_finish(heap, count);
+    min_heap_track_all(heap);
+    return MIN_HEAP_OK;
+}
+
+MinHeapReturnCode min_heap_api_bloom_init(
+    MinHeapHandler_t *heap,
+    size_t counters,
+    uint32_t (*hash)(void *),
+    ArenaAllocatorHandler_t *arena) {
+    if (heap == NULL || hash == NULL || arena == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (counters == 0)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    MinHeapExtension_t *ext = min_heap_extension(heap, arena);
+    uint8_t *bloom = arena_allocator_api_calloc(arena, sizeof(uint8_t), counters);
+    if (ext == NULL || bloom == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    ext->hash = hash;
+    ext->bloom = bloom;
+    ext->bloom_size = counters;
+
+    // Add the items that are already in the heap
+    for (size_t i = 0; i < heap->size; ++i)
+        min_heap_bloom_add(heap, (uint8_t *)heap->data + i * heap->data_size);
+    return MIN_HEAP_OK;
+}
+
+MinHeapReturnCode min_heap_api_stable_init(MinHeapHandler_t *heap, ArenaAllocatorHandler_t *arena) {
+    if (heap == NULL || arena == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    MinHeapExtension_t *ext = min_heap_extension(heap, arena);
+    uint32_t *seq = arena_allocator_api_calloc(arena, sizeof(uint32_t), heap->capacity);
+    if (ext == NULL || seq == NULL)
+        return MIN_HEAP_NULL_POINTER;
+
+    // A parent always precedes its children so the heap properties still hold
+    for (size_t i = 0; i < heap->size; ++i)
+        seq[i] = (uint32_t)i;
+    ext->next_seq = (uint32_t)heap->size;
+    ext->seq = seq;
+    return MIN_HEAP_OK;
+}
+
+MinHeapReturnCode min_heap_api_handles_init(
+    MinHeapHandler_t *heap,
+    size_t handle_offset,
+    size_t handle_count,
+    ArenaAllocatorHandler_t *arena) {
+    if (heap == NULL || arena == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (handle_count == 0 || handle_offset + sizeof(uint32_t) > heap->data_size || heap->capacity > UINT32_MAX)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    MinHeapExtension_t *ext = min_heap_extension(heap, arena);
+    uint32_t *positions = arena_allocator_api_calloc(arena, sizeof(uint32_t), handle_count);
+    if (ext == NULL || positions == NULL)
+        return MIN_HEAP_NULL_POINTER;
+
+    ext->positions = positions;
+    ext->handle_offset = handle_offset;
+    ext->handle_count = handle_count;
+    min_heap_track_all(heap);
+    return MIN_HEAP_OK;
+}
+
+signed_size_t min_heap_api_position(const MinHeapHandler_t *heap, uint32_t handle) {
+    if (heap == NULL || heap->ext == NULL || heap->ext->positions == NULL || handle >= heap->ext->handle_count)
+        return -1;
+
+    // Positions are not cleared on removal, a stale one points to another item or past the end
+    const MinHeapExtension_t *ext = heap->ext;
+    size_t slot = ext->positions[handle];
+    uint32_t stored;
+    if (slot >= heap->size)
+        return -1;
+    memcpy(&stored, MIN_HEAP_ITEM(heap, slot) + ext->handle_offset, sizeof(stored));
+    return stored == handle ? (signed_size_t)slot : -1;
+}
+
+void *min_heap_api_at(const MinHeapHandler_t *heap, size_t index) {
+    if (heap == NULL || index >= heap->size)
+        return NULL;
+    return MIN_HEAP_ITEM(heap, index);
+}
+
+MinHeapReturnCode min_heap_api_update(MinHeapHandler_t *heap, size_t index) {
+    if (heap == NULL || !MIN_HEAP_HAS_COMPARE(heap))
+        return MIN_HEAP_NULL_POINTER;
+    if (index >= heap->size)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    if (MIN_HEAP_IN_TXN(heap))
+        return MIN_HEAP_INVALID_STATE;
+
+    // The item moves only in one direction
+    if (index > 0 && min_heap_compare_at(heap, index, MIN_HEAP_PARENT(index)) < 0)
+        min_heap_sift_up(heap, index, MIN_HEAP_ORDER_MIN);
+    else
+        min_heap_sift_down(heap, index, MIN_HEAP_ORDER_MIN);
+    return MIN_HEAP_OK;
+}
+
+/*!
+ * \brief Keep in the first k items of the heap buffer the k smallest items
+ *      of an array using a bounded max heap, then sort them in place
+ *
+ * \param heap A temporary handler whose buffer contains the first k items
+ * \param array The whole input array
+ * \param n The number of items of the array
+ */
+static void min_heap_select_sorted(MinHeapHandler_t *heap, uint8_t *array, size_t n) {
+    const size_t k = heap->size;
+
+    // Build a max heap with the first k items (Floyd's method)
+    for (size_t i = k / 2; i > 0; --i)
+        min_heap_sift_down(heap, i - 1, MIN_HEAP_ORDER_MAX);
+
+    // Replace the maximum with every smaller item
+    for (size_t i = k; i < n; ++i) {
+        uint8_t *item = array + i * heap->data_size;
+        if (min_heap_compare_items(heap, item, heap->data) >= 0)
+            continue;
+        if (array == heap->data) {
+            // In place the replaced item is moved to the discarded part of the array
+            uint8_t aux[heap->data_size];
+            memcpy(aux, item, heap->data_size);
+            memcpy(item, heap->data, heap->data_size);
+            memcpy(heap->data, aux, heap->data_size);
+        } else {
+            memcpy(heap->data, item, heap->data_size);
+        }
+        min_heap_sift_down(heap, 0, MIN_HEAP_ORDER_MAX);
+    }
+
+    // Heapsort, the maximum is moved after the end of the heap
+    while (heap->size > 1) {
+        min_heap_swap(heap, 0, heap->size - 1);
+        --heap->size;
+        min_heap_sift_down(heap, 0, MIN_HEAP_ORDER_MAX);
+    }
+}
+
+MinHeapReturnCode min_heap_api_select(
+    void *array,
+    size_t n,
+    size_t k,
+    size_t data_size,
+    int8_t (*compare)(void *, void *),
+    void *out) {
+    if ((array == NULL && n > 0) || compare == NULL || (out == NULL && k > 0))
+        return MIN_HEAP_NULL_POINTER;
+    if (k > n)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    if (k == 0)
+        return MIN_HEAP_OK;
+
+    MinHeapHandler_t heap = {
+        .data_size = data_size,
+        .size = k,
+        .capacity = k,
+        .compare = compare,
+        .data = out
+    };
+    memcpy(out, array, k * data_size);
+    min_heap_select_sorted(&heap, (uint8_t *)array, n);
+    return MIN_HEAP_OK;
+}
+
+MinHeapReturnCode min_heap_api_partial_sort(
+    void *array,
+    size_t n,
+    size_t k,
+    size_t data_size,
+    int8_t (*compare)(void *, void *)) {
+    if ((array == NULL && n > 0) || compare == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (k > n)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    if (k == 0)
+        return MIN_HEAP_OK;
+
+    MinHeapHandler_t heap = {
+        .data_size = data_size,
+        .size = k,
+        .capacity = k,
+        .compare = compare,
+        .data = array
+    };
+    min_heap_select_sorted(&heap, (uint8_t *)array, n);
+    return MIN_HEAP_OK;
+}
+
+/*!
+ * \brief State shared by the tasks of the parallel drain
+ *
+ * \var heap The drained heap, its buffer is split in 'parts' sorted chunks
+ * \var out The output buffer
+ * \var parts The number of chunks and of output partitions
+ */
+typedef struct {
+    MinHeapHandler_t *heap;
+    uint8_t *out;
+    size_t parts;
+} MinHeapDrain_t;
+
+/*!
+ * \brief Get the first index of a chunk (or of an output partition)
+ */
+static inline size_t min_heap_drain_bound(const MinHeapDrain_t *drain, size_t part) {
+    return part * drain->heap->size / drain->parts;
+}
+
+/*!
+ * \brief Strict total order of the items of the buffer, equal items are
+ *      ordered by their index
+ */
+static inline bool min_heap_drain_less(const MinHeapHandler_t *heap, size_t a, size_t b) {
+    int8_t cmp = min_heap_compare_at(heap, a, b);
+    return cmp < 0 || (cmp == 0 && a < b);
+}
+
+/*!
+ * \brief Sort a chunk of the buffer with heapsort
+ */
+static void min_heap_drain_sort_task(void *arg, size_t part) {
+    MinHeapDrain_t *drain = arg;
+    const size_t first = min_heap_drain_bound(drain, part);
+    const size_t last = min_heap_drain_bound(drain, part + 1);
+
+    // A view of the chunk with the same ordering of the heap
+    MinHeapHandler_t view = *drain->heap;
+    MinHeapExtension_t ext;
+    view.data = MIN_HEAP_ITEM(drain->heap, first);
+    view.size = last - first;
+    view.capacity = last - first;
+    if (view.ext != NULL) {
+        ext = *view.ext;
+        ext.seq = ext.seq != NULL ? ext.seq + first : NULL;
+        ext.bloom = NULL;
+        ext.positions = NULL;
+        ext.txn_active = false;
+        view.ext = &ext;
+    }
+    min_heap_select_sorted(&view, view.data, view.size);
+}
+
+/*!
+ * \brief Get the number of items of a sorted chunk lower than an item
+ */
+static size_t min_heap_drain_count_less(const MinHeapDrain_t *drain, size_t part, size_t item) {
+    size_t lo = min_heap_drain_bound(drain, part);
+    size_t hi = min_heap_drain_bound(drain, part + 1);
+    const size_t first = lo;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (min_heap_drain_less(drain->heap, mid, item))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo - first;
+}
+
+/*!
+ * \brief Find how many items of each chunk come before the item of a given
+ *      rank in the sorted output (multiway selection)
+ * \details The item of the given rank is searched with a binary search in
+ *      each chunk, its rank is the sum of the lower items of all the chunks
+ *
+ * \param drain The drain state
+ * \param rank The rank of the splitter
+ * \param splits The number of items of each chunk lower than the splitter
+ */
+static void min_heap_drain_split(const MinHeapDrain_t *drain, size_t rank, size_t *splits) {
+    const size_t n = drain->heap->size;
+    for (size_t k = 0; k < drain->parts; ++k)
+        splits[k] = min_heap_drain_bound(drain, rank == n ? k + 1 : k) - min_heap_drain_bound(drain, k);
+    if (rank == 0 || rank == n)
+        return;
+
+    for (size_t c = 0; c < drain->parts; ++c) {
+        size_t lo = min_heap_drain_bound(drain, c);
+        size_t hi = min_heap_drain_bound(drain, c + 1);
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            size_t r = 0;
+            for (size_t k = 0; k < drain->parts; ++k)
+                r += min_heap_drain_count_less(drain, k, mid);
+            if (r == rank) {
+                for (size_t k = 0; k < drain->parts; ++k)
+                    splits[k] = min_heap_drain_count_less(drain, k, mid);
+                return;
+            }
+            if (r < rank)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+    }
+}
+
+/*!
+ * \brief Merge the pieces of all the chunks that belong to an output partition
+ * \details The heads of the pieces are kept in a small binary heap of chunk indices
+ */
+static void min_heap_drain_merge_task(void *arg, size_t part) {
+    MinHeapDrain_t *drain = arg;
+    MinHeapHandler_t *heap = drain->heap;
+    const size_t parts = drain->parts;
+    size_t cur[parts];
+    size_t end[parts];
+    size_t order[parts];
+    size_t count = 0;
+
+    min_heap_drain_split(drain, min_heap_drain_bound(drain, part), cur);
+    min_heap_drain_split(drain, min_heap_drain_bound(drain, part + 1), end);
+    for (size_t k = 0; k < parts; ++k) {
+        cur[k] += min_heap_drain_bound(drain, k);
+        end[k] += min_heap_drain_bound(drain, k);
+        if (cur[k] < end[k])
+            order[count++] = k;
+    }
+
+    // Heap of the chunks ordered by their current item
+    for (size_t i = count; i > 0; --i) {
+        for (size_t j = i - 1, c = MIN_HEAP_CHILD_L(j); c < count; j = c, c = MIN_HEAP_CHILD_L(j)) {
+            if (c + 1 < count && min_heap_drain_less(heap, cur[order[c + 1]], cur[order[c]]))
+                ++c;
+            if (!min_heap_drain_less(heap, cur[order[c]], cur[order[j]]))
+                break;
+            size_t tmp = order[j];
+            order[j] = order[c];
+            order[c] = tmp;
+        }
+    }
+
+    uint8_t *dst = drain->out + min_heap_drain_bound(drain, part) * heap->data_size;
+    while (count > 0) {
+        size_t k = order[0];
+        memcpy(dst, MIN_HEAP_ITEM(heap, cur[k]), heap->data_size);
+        dst += heap->data_size;
+        if (++cur[k] == end[k])
+            order[0] = order[--count];
+        for (size_t j = 0, c = 1; c < count; j = c, c = MIN_HEAP_CHILD_L(j)) {
+            if (c + 1 < count && min_heap_drain_less(heap, cur[order[c + 1]], cur[order[c]]))
+                ++c;
+            if (!min_heap_drain_less(heap, cur[order[c]], cur[order[j]]))
+                break;
+            size_t tmp = order[j];
+            order[j] = order[c];
+            order[c] = tmp;
+        }
+    }
+}
+
+MinHeapReturnCode min_heap_api_drain_parallel(
+    MinHeapHandler_t *heap,
+    void *out,
+    size_t parts,
+    void (*run)(void (*task)(void *arg, size_t index), void *arg, size_t count, void *ctx),
+    void *ctx) {
+    if (heap == NULL || out == NULL || run == NULL || !MIN_HEAP_HAS_COMPARE(heap))
+        return MIN_HEAP_NULL_POINTER;
+    if (parts == 0 || parts > MIN_HEAP_DRAIN_MAX_PARTS)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    if (MIN_HEAP_IN_TXN(heap))
+        return MIN_HEAP_INVALID_STATE;
+
+    MinHeapDrain_t drain = { .heap = heap, .out = out, .parts = parts };
+    run(min_heap_drain_sort_task, &drain, parts, ctx);
+    run(min_heap_drain_merge_task, &drain, parts, ctx);
+
+    heap->size = 0;
+    min_heap_bloom_clear(heap);
+    return MIN_HEAP_OK;
+}
+
+MinHeapReturnCode min_heap_api_txn_init(MinHeapHandler_t *heap, ArenaAllocatorHandler_t *arena) {
+    if (heap == NULL || arena == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (MIN_HEAP_IN_TXN(heap))
+        return MIN_HEAP_INVALID_STATE;
+    MinHeapExtension_t *ext = min_heap_extension(heap, arena);
+    uint8_t *undo = arena_allocator_api_calloc(arena, MIN_HEAP_TXN_ENTRY_SIZE(heap), heap->capacity);
+    uint32_t *undo_mark = arena_allocator_api_calloc(arena, sizeof(uint32_t), heap->capacity);
+    if (ext == NULL || undo == NULL || undo_mark == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    ext->undo = undo;
+    ext->undo_mark = undo_mark;
+    ext->undo_size = 0;
+    ext->txn_epoch = 0;
+    return MIN_HEAP_OK;
+}
+
+MinHeapReturnCode min_heap_api_txn_begin(MinHeapHandler_t *heap) {
+    if (heap == NULL || heap->ext == NULL || heap->ext->undo == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    MinHeapExtension_t *ext = heap->ext;
+    if (ext->txn_active)
+        return MIN_HEAP_INVALID_STATE;
+
+    // A new epoch invalidates all the marks of the previous transaction
+    if (++ext->txn_epoch == 0) {
+        memset(ext->undo_mark, 0, heap->capacity * sizeof(uint32_t));
+        ext->txn_epoch = 1;
+    }
+    ext->undo_size = 0;
+    ext->txn_size = heap->size;
+    ext->txn_seq = ext->next_seq;
+    ext->txn_active = true;
+    return MIN_HEAP_OK;
+}
+
+MinHeapReturnCode min_heap_api_txn_commit(MinHeapHandler_t *heap) {
+    if (heap == NULL || heap->ext == NULL || heap->ext->undo == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (!heap->ext->txn_active)
+        return MIN_HEAP_INVALID_STATE;
+    heap->ext->txn_active = false;
+    return MIN_HEAP_OK;
+}
+
+MinHeapReturnCode min_heap_api_txn_rollback(MinHeapHandler_t *heap) {
+    if (heap == NULL || heap->ext == NULL || heap->ext->undo == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    MinHeapExtension_t *ext = heap->ext;
+    if (!ext->txn_active)
+        return MIN_HEAP_INVALID_STATE;
+    ext->txn_active = false;
+
+    if (ext->bloom != NULL) {
+        // Remove the current content of the modified slots from the filter
+        for (size_t e = 0; e < ext->undo_size; ++e) {
+            size_t slot;
+            memcpy(&slot, MIN_HEAP_TXN_ENTRY(heap, e), sizeof(size_t));
+            if (slot < heap->size)
+                min_heap_bloom_remove(heap, MIN_HEAP_ITEM(heap, slot));
+        }
+        // Slots removed from the end of the heap without being overwritten
+        for (size_t slot = heap->size; slot < ext->txn_size; ++slot) {
+            if (ext->undo_mark[slot] != ext->txn_epoch)
+                min_heap_bloom_add(heap, MIN_HEAP_ITEM(heap, slot));
+        }
+    }
+
+    // Restore the original content of the modified slots
+    for (size_t e = 0; e < ext->undo_size; ++e) {
+        size_t slot;
+        memcpy(&slot, MIN_HEAP_TXN_ENTRY(heap, e), sizeof(size_t));
+        memcpy(MIN_HEAP_ITEM(heap, slot), MIN_HEAP_TXN_ENTRY_DATA(heap, e), heap->data_size);
+        if (ext->seq != NULL)
+            memcpy(ext->seq + slot, MIN_HEAP_TXN_ENTRY_SEQ(heap, e), sizeof(uint32_t));
+        if (slot < ext->txn_size) {
+            min_heap_bloom_add(heap, MIN_HEAP_ITEM(heap, slot));
+            min_heap_track(heap, slot);
+        }
+    }
+    heap->size = ext->txn_size;
+    ext->next_seq = ext->txn_seq;
+    ext->undo_size = 0;
+    return MIN_HEAP_OK;
+}
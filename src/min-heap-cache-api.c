@@ -0,0 +1,258 @@
+/*!
+ * \file min-heap-cache-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that implements a cache with cost-aware eviction (LFU and
+ *      GreedyDual) backed by an addressable min heap
+ */
+
+#include "min-heap-cache-api.h"
+#include "min-heap-api.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*!
+ * \brief Macro to get the value of an entry given its index
+ *
+ * \param C The cache handler
+ * \param I The entry index
+ * \return The address of the value
+ */
+#define MIN_HEAP_CACHE_VALUE(C, I) ((C)->values + (size_t)(I) * (C)->value_size)
+
+const uint8_t min_heap_cache_hit = 0U;
+
+/*!
+ * \brief Item of the heap
+ *
+ * \var priority The priority of the entry (H)
+ * \var tick The time of the last access, the least recently used entry is evicted on ties
+ * \var entry The index of the entry, used as the handle of the item
+ */
+typedef struct {
+    uint64_t priority;
+    uint64_t tick;
+    uint32_t entry;
+} MinHeapCacheItem_t;
+
+/*!
+ * \brief Mix the bits of a key (finalizer of splitmix64)
+ */
+static size_t min_heap_cache_hash(uint64_t key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return (size_t)key;
+}
+
+/*!
+ * \brief Find the bucket of a key
+ *
+ * \return size_t The bucket that contains the key or the empty bucket where it would be inserted
+ */
+static size_t min_heap_cache_bucket(const MinHeapCacheHandler_t *cache, uint64_t key) {
+    size_t b = min_heap_cache_hash(key) & cache->table_mask;
+    while (cache->table[b] != MIN_HEAP_CACHE_EMPTY && cache->entries[cache->table[b]].key != key)
+        b = (b + 1) & cache->table_mask;
+    return b;
+}
+
+/*!
+ * \brief Empty a bucket and shift back the following entries of its cluster,
+ *      so that no tombstone is needed
+ */
+static void min_heap_cache_unlink(MinHeapCacheHandler_t *cache, size_t bucket) {
+    size_t hole = bucket;
+    size_t b = (bucket + 1) & cache->table_mask;
+    while (cache->table[b] != MIN_HEAP_CACHE_EMPTY) {
+        size_t home = min_heap_cache_hash(cache->entries[cache->table[b]].key) & cache->table_mask;
+        // Move the entry only if its home is not between the hole and its bucket
+        if (((b - home) & cache->table_mask) >= ((b - hole) & cache->table_mask)) {
+            cache->table[hole] = cache->table[b];
+            hole = b;
+        }
+        b = (b + 1) & cache->table_mask;
+    }
+    cache->table[hole] = MIN_HEAP_CACHE_EMPTY;
+}
+
+/*!
+ * \brief Compute the priority of an entry with the current inflation
+ */
+static uint64_t min_heap_cache_priority(const MinHeapCacheHandler_t *cache, const MinHeapCacheEntry_t *entry) {
+    switch (cache->policy) {
+        case MIN_HEAP_CACHE_LFU:
+            return cache->inflation + entry->frequency;
+        case MIN_HEAP_CACHE_GREEDY_DUAL:
+            return cache->inflation + entry->cost;
+        default:
+            return cache->inflation + (uint64_t)entry->frequency * entry->cost;
+    }
+}
+
+/*!
+ * \brief Restore the priority of an entry that is already in the heap
+ */
+static void min_heap_cache_touch(MinHeapCacheHandler_t *cache, uint32_t entry) {
+    signed_size_t index = min_heap_api_position(&cache->heap, entry);
+    if (index < 0)
+        return;
+    MinHeapCacheEntry_t *e = &cache->entries[entry];
+    if (e->frequency < UINT32_MAX)
+        ++e->frequency;
+    MinHeapCacheItem_t *item = min_heap_api_at(&cache->heap, (size_t)index);
+    item->priority = min_heap_cache_priority(cache, e);
+    item->tick = cache->clock++;
+    min_heap_api_update(&cache->heap, (size_t)index);
+}
+
+MinHeapReturnCode min_heap_cache_api_init(
+    MinHeapCacheHandler_t *cache,
+    MinHeapCachePolicy policy,
+    size_t capacity,
+    size_t value_size,
+    ArenaAllocatorHandler_t *arena) {
+    if (cache == NULL || arena == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if ((policy != MIN_HEAP_CACHE_LFU && policy != MIN_HEAP_CACHE_GREEDY_DUAL && policy != MIN_HEAP_CACHE_GREEDY_DUAL_FREQUENCY) ||
+        capacity == 0 || capacity > (UINT32_MAX >> 1))
+        return MIN_HEAP_OUT_OF_BOUNDS;
+
+    const MinHeapKeyField_t keys[] = {
+        { offsetof(MinHeapCacheItem_t, priority), MIN_HEAP_KEY_U64, MIN_HEAP_KEY_ASC },
+        { offsetof(MinHeapCacheItem_t, tick), MIN_HEAP_KEY_U64, MIN_HEAP_KEY_ASC },
+    };
+    MinHeapReturnCode res = min_heap_api_init_keys(&cache->heap, sizeof(MinHeapCacheItem_t), capacity, keys, 2, arena);
+    if (res != MIN_HEAP_OK)
+        return res;
+    res = min_heap_api_handles_init(&cache->heap, offsetof(MinHeapCacheItem_t, entry), capacity, arena);
+    if (res != MIN_HEAP_OK)
+        return res;
+
+    // At least twice the buckets of the entries to keep the clusters short
+    size_t buckets = 1;
+    while (buckets < capacity * 2)
+        buckets <<= 1;
+    cache->entries = arena_allocator_api_calloc(arena, sizeof(MinHeapCacheEntry_t), capacity);
+    cache->values = value_size > 0 ? arena_allocator_api_calloc(arena, value_size, capacity) : NULL;
+    cache->table = arena_allocator_api_calloc(arena, sizeof(uint32_t), buckets);
+    cache->free_slots = arena_allocator_api_calloc(arena, sizeof(uint32_t), capacity);
+    if (cache->entries == NULL || (value_size > 0 && cache->values == NULL) || cache->table == NULL || cache->free_slots == NULL)
+        return MIN_HEAP_NULL_POINTER;
+
+    for (size_t i = 0; i < buckets; ++i)
+        cache->table[i] = MIN_HEAP_CACHE_EMPTY;
+    // The lowest indices are used first
+    for (size_t i = 0; i < capacity; ++i)
+        cache->free_slots[i] = (uint32_t)(capacity - 1 - i);
+    cache->free_count = capacity;
+    cache->table_mask = buckets - 1;
+    cache->value_size = value_size;
+    cache->capacity = capacity;
+    cache->inflation = 0;
+    cache->clock = 0;
+    cache->policy = policy;
+    cache->hits = 0;
+    cache->misses = 0;
+    return MIN_HEAP_OK;
+}
+
+size_t min_heap_cache_api_size(const MinHeapCacheHandler_t *cache) {
+    return cache == NULL ? 0U : cache->heap.size;
+}
+
+void *min_heap_cache_api_get(MinHeapCacheHandler_t *cache, uint64_t key) {
+    if (cache == NULL || cache->table == NULL)
+        return NULL;
+    uint32_t entry = cache->table[min_heap_cache_bucket(cache, key)];
+    if (entry == MIN_HEAP_CACHE_EMPTY) {
+        ++cache->misses;
+        return NULL;
+    }
+    ++cache->hits;
+    min_heap_cache_touch(cache, entry);
+    return cache->value_size > 0 ? MIN_HEAP_CACHE_VALUE(cache, entry) : MIN_HEAP_CACHE_HIT;
+}
+
+MinHeapReturnCode min_heap_cache_api_put(
+    MinHeapCacheHandler_t *cache,
+    uint64_t key,
+    uint32_t cost,
+    const void *value,
+    bool *evicted,
+    uint64_t *evicted_key,
+    void *evicted_value) {
+    if (cache == NULL || cache->table == NULL || (value == NULL && cache->value_size > 0))
+        return MIN_HEAP_NULL_POINTER;
+    if (evicted != NULL)
+        *evicted = false;
+
+    size_t bucket = min_heap_cache_bucket(cache, key);
+    uint32_t entry = cache->table[bucket];
+    if (entry != MIN_HEAP_CACHE_EMPTY) {
+        cache->entries[entry].cost = cost;
+        if (cache->value_size > 0)
+            memcpy(MIN_HEAP_CACHE_VALUE(cache, entry), value, cache->value_size);
+        min_heap_cache_touch(cache, entry);
+        return MIN_HEAP_OK;
+    }
+
+    if (cache->free_count > 0) {
+        entry = cache->free_slots[--cache->free_count];
+        MinHeapCacheEntry_t *e = &cache->entries[entry];
+        e->key = key;
+        e->cost = cost;
+        e->frequency = 1;
+        cache->table[bucket] = entry;
+        if (cache->value_size > 0)
+            memcpy(MIN_HEAP_CACHE_VALUE(cache, entry), value, cache->value_size);
+        MinHeapCacheItem_t item = { .priority = min_heap_cache_priority(cache, e), .tick = cache->clock++, .entry = entry };
+        return min_heap_api_insert(&cache->heap, &item);
+    }
+
+    // Evict the root and reuse both its entry and its slot in the heap
+    MinHeapCacheItem_t *root = min_heap_api_peek(&cache->heap);
+    entry = root->entry;
+    MinHeapCacheEntry_t *e = &cache->entries[entry];
+    cache->inflation = root->priority;
+    if (evicted != NULL)
+        *evicted = true;
+    if (evicted_key != NULL)
+        *evicted_key = e->key;
+    if (evicted_value != NULL && cache->value_size > 0)
+        memcpy(evicted_value, MIN_HEAP_CACHE_VALUE(cache, entry), cache->value_size);
+    min_heap_cache_unlink(cache, min_heap_cache_bucket(cache, e->key));
+
+    e->key = key;
+    e->cost = cost;
+    e->frequency = 1;
+    cache->table[min_heap_cache_bucket(cache, key)] = entry;
+    if (cache->value_size > 0)
+        memcpy(MIN_HEAP_CACHE_VALUE(cache, entry), value, cache->value_size);
+    root->priority = min_heap_cache_priority(cache, e);
+    root->tick = cache->clock++;
+    return min_heap_api_update(&cache->heap, 0);
+}
+
+MinHeapReturnCode min_heap_cache_api_remove(MinHeapCacheHandler_t *cache, uint64_t key, void *value) {
+    if (cache == NULL || cache->table == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    size_t bucket = min_heap_cache_bucket(cache, key);
+    uint32_t entry = cache->table[bucket];
+    if (entry == MIN_HEAP_CACHE_EMPTY)
+        return MIN_HEAP_NOT_FOUND;
+
+    signed_size_t index = min_heap_api_position(&cache->heap, entry);
+    if (index < 0)
+        return MIN_HEAP_INVALID_STATE;
+    if (value != NULL && cache->value_size > 0)
+        memcpy(value, MIN_HEAP_CACHE_VALUE(cache, entry), cache->value_size);
+    min_heap_cache_unlink(cache, bucket);
+    cache->free_slots[cache->free_count++] = entry;
+    return min_heap_api_remove(&cache->heap, (size_t)index, NULL);
+}
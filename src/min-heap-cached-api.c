@@ -0,0 +1,128 @@
+/*!
+ * \file min-heap-cached-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that implements a min heap whose smallest items are kept
+ *      in a small sorted cache
+ */
+
+#include "min-heap-cached-api.h"
+#include "min-heap-api.h"
+
+#include <string.h>
+
+/*!
+ * \brief Macro to get the address of an item of the cache given its index
+ *
+ * \param C The cached heap handler
+ * \param I The item index
+ * \return The address of the item
+ */
+#define MIN_HEAP_CACHED_ITEM(C, I) ((uint8_t *)(C)->cache + (I) * (C)->heap.data_size)
+
+/*!
+ * \brief Refill the empty cache with the smallest items of the heap
+ * \details The items are removed in increasing order and then reversed,
+ *      so that the minimum is the last item of the cache
+ */
+static void min_heap_cached_refill(MinHeapCachedHandler_t *cached) {
+    const size_t size = cached->heap.data_size;
+    cached->cache_size = min_heap_api_pop_k(&cached->heap, cached->cache, cached->cache_capacity);
+    uint8_t aux[size]; //local buffer as a swapping area
+    for (size_t i = 0, j = cached->cache_size; i + 1 < j; ++i, --j) {
+        memcpy(aux, MIN_HEAP_CACHED_ITEM(cached, i), size);
+        memcpy(MIN_HEAP_CACHED_ITEM(cached, i), MIN_HEAP_CACHED_ITEM(cached, j - 1), size);
+        memcpy(MIN_HEAP_CACHED_ITEM(cached, j - 1), aux, size);
+    }
+}
+
+MinHeapReturnCode min_heap_cached_api_init(
+    MinHeapCachedHandler_t *cached,
+    size_t data_size,
+    size_t capacity,
+    size_t cache_capacity,
+    int8_t (*compare)(void *, void *),
+    ArenaAllocatorHandler_t *arena) {
+    if (cached == NULL || compare == NULL || arena == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (cache_capacity == 0)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    MinHeapReturnCode res = min_heap_api_init(&cached->heap, data_size, capacity, compare, arena);
+    if (res != MIN_HEAP_OK)
+        return res;
+    cached->cache = arena_allocator_api_calloc(arena, data_size, cache_capacity);
+    if (cached->cache == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    cached->cache_capacity = cache_capacity;
+    cached->cache_size = 0;
+    return MIN_HEAP_OK;
+}
+
+size_t min_heap_cached_api_size(const MinHeapCachedHandler_t *cached) {
+    return cached == NULL ? 0U : cached->cache_size + cached->heap.size;
+}
+
+MinHeapReturnCode min_heap_cached_api_clear(MinHeapCachedHandler_t *cached) {
+    if (cached == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    cached->cache_size = 0;
+    return min_heap_api_clear(&cached->heap);
+}
+
+MinHeapReturnCode min_heap_cached_api_insert(MinHeapCachedHandler_t *cached, void *item) {
+    if (cached == NULL || item == NULL || cached->cache == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    const size_t size = cached->heap.data_size;
+
+    // Items not lower than the maximum of the cache belong to the heap
+    if (cached->cache_size == 0 || min_heap_api_compare(&cached->heap, item, cached->cache) >= 0)
+        return min_heap_api_insert(&cached->heap, item);
+
+    // A full cache moves its maximum to the heap to make space
+    size_t first = 0;
+    if (cached->cache_size == cached->cache_capacity) {
+        MinHeapReturnCode res = min_heap_api_insert(&cached->heap, cached->cache);
+        if (res != MIN_HEAP_OK)
+            return res;
+        first = 1;
+    }
+
+    // Find the position in the decreasing order and shift the lower items
+    size_t pos = first;
+    while (pos < cached->cache_size && min_heap_api_compare(&cached->heap, item, MIN_HEAP_CACHED_ITEM(cached, pos)) < 0)
+        ++pos;
+    if (first == 0) {
+        memmove(MIN_HEAP_CACHED_ITEM(cached, pos + 1), MIN_HEAP_CACHED_ITEM(cached, pos), (cached->cache_size - pos) * size);
+        ++cached->cache_size;
+    } else {
+        // The maximum slot is reused, the greater items move towards it
+        memmove(cached->cache, MIN_HEAP_CACHED_ITEM(cached, 1), (pos - 1) * size);
+        --pos;
+    }
+    memcpy(MIN_HEAP_CACHED_ITEM(cached, pos), item, size);
+    return MIN_HEAP_OK;
+}
+
+void *min_heap_cached_api_peek(const MinHeapCachedHandler_t *cached) {
+    if (cached == NULL || cached->cache == NULL)
+        return NULL;
+    if (cached->cache_size == 0)
+        return min_heap_api_peek(&cached->heap);
+    return MIN_HEAP_CACHED_ITEM(cached, cached->cache_size - 1);
+}
+
+MinHeapReturnCode min_heap_cached_api_pop(MinHeapCachedHandler_t *cached, void *out) {
+    if (cached == NULL || cached->cache == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (cached->cache_size == 0) {
+        min_heap_cached_refill(cached);
+        if (cached->cache_size == 0)
+            return MIN_HEAP_EMPTY;
+    }
+    --cached->cache_size;
+    if (out != NULL)
+        memcpy(out, MIN_HEAP_CACHED_ITEM(cached, cached->cache_size), cached->heap.data_size);
+    return MIN_HEAP_OK;
+}
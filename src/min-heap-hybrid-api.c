@@ -0,0 +1,108 @@
+/*!
+ * \file min-heap-hybrid-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that implements a priority queue optimized for nearly
+ *      sorted input (e.g. timestamps)
+ */
+
+#include "min-heap-hybrid-api.h"
+#include "min-heap-api.h"
+
+#include <string.h>
+
+/*!
+ * \brief Macro to get the address of an item of the run given its position
+ *      from the first one
+ *
+ * \param H The hybrid queue handler
+ * \param I The position of the item in the run
+ * \return The address of the item
+ */
+#define MIN_HEAP_HYBRID_RUN_ITEM(H, I) \
+    ((uint8_t *)(H)->run + (((H)->run_head + (I)) % (H)->run_capacity) * (H)->heap.data_size)
+
+/*!
+ * \brief Check if the minimum is the first item of the run
+ * \details On ties the run wins since its removal is cheaper
+ */
+static inline bool min_heap_hybrid_top_in_run(const MinHeapHybridHandler_t *hybrid) {
+    if (hybrid->run_size == 0)
+        return false;
+    if (min_heap_api_is_empty(&hybrid->heap))
+        return true;
+    return min_heap_api_compare(&hybrid->heap, MIN_HEAP_HYBRID_RUN_ITEM(hybrid, 0), hybrid->heap.data) <= 0;
+}
+
+MinHeapReturnCode min_heap_hybrid_api_init(
+    MinHeapHybridHandler_t *hybrid,
+    size_t data_size,
+    size_t run_capacity,
+    size_t heap_capacity,
+    int8_t (*compare)(void *, void *),
+    ArenaAllocatorHandler_t *arena) {
+    if (hybrid == NULL || compare == NULL || arena == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (run_capacity == 0)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    MinHeapReturnCode res = min_heap_api_init(&hybrid->heap, data_size, heap_capacity, compare, arena);
+    if (res != MIN_HEAP_OK)
+        return res;
+    hybrid->run = arena_allocator_api_calloc(arena, data_size, run_capacity);
+    if (hybrid->run == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    hybrid->run_capacity = run_capacity;
+    hybrid->run_head = 0;
+    hybrid->run_size = 0;
+    return MIN_HEAP_OK;
+}
+
+size_t min_heap_hybrid_api_size(const MinHeapHybridHandler_t *hybrid) {
+    return hybrid == NULL ? 0U : hybrid->run_size + hybrid->heap.size;
+}
+
+MinHeapReturnCode min_heap_hybrid_api_clear(MinHeapHybridHandler_t *hybrid) {
+    if (hybrid == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    hybrid->run_head = 0;
+    hybrid->run_size = 0;
+    return min_heap_api_clear(&hybrid->heap);
+}
+
+MinHeapReturnCode min_heap_hybrid_api_insert(MinHeapHybridHandler_t *hybrid, void *item) {
+    if (hybrid == NULL || item == NULL || hybrid->run == NULL)
+        return MIN_HEAP_NULL_POINTER;
+
+    // In order items are appended to the run as long as there is space
+    if (hybrid->run_size < hybrid->run_capacity &&
+        (hybrid->run_size == 0 ||
+         min_heap_api_compare(&hybrid->heap, item, MIN_HEAP_HYBRID_RUN_ITEM(hybrid, hybrid->run_size - 1)) >= 0)) {
+        memcpy(MIN_HEAP_HYBRID_RUN_ITEM(hybrid, hybrid->run_size), item, hybrid->heap.data_size);
+        ++hybrid->run_size;
+        return MIN_HEAP_OK;
+    }
+    return min_heap_api_insert(&hybrid->heap, item);
+}
+
+void *min_heap_hybrid_api_peek(const MinHeapHybridHandler_t *hybrid) {
+    if (hybrid == NULL || hybrid->run == NULL)
+        return NULL;
+    if (min_heap_hybrid_top_in_run(hybrid))
+        return MIN_HEAP_HYBRID_RUN_ITEM(hybrid, 0);
+    return min_heap_api_peek(&hybrid->heap);
+}
+
+MinHeapReturnCode min_heap_hybrid_api_pop(MinHeapHybridHandler_t *hybrid, void *out) {
+    if (hybrid == NULL || hybrid->run == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (!min_heap_hybrid_top_in_run(hybrid))
+        return min_heap_api_remove(&hybrid->heap, 0, out);
+
+    if (out != NULL)
+        memcpy(out, MIN_HEAP_HYBRID_RUN_ITEM(hybrid, 0), hybrid->heap.data_size);
+    hybrid->run_head = (hybrid->run_head + 1) % hybrid->run_capacity;
+    --hybrid->run_size;
+    return MIN_HEAP_OK;
+}
@@ -0,0 +1,141 @@
+/*!
+ * \file min-heap-persistent-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that implements a persistent (immutable) min heap whose
+ *      nodes are allocated with an arena allocator
+ */
+
+#include "min-heap-persistent-api.h"
+
+#include <string.h>
+
+static inline size_t min_heap_persistent_rank(MinHeapPersistent_t node) {
+    return node == NULL ? 0U : node->rank;
+}
+
+static inline MinHeapPersistentNode_t *min_heap_persistent_new_node(const MinHeapPersistentHandler_t *heap) {
+    return arena_allocator_api_calloc(heap->arena, sizeof(MinHeapPersistentNode_t) + heap->data_size, 1U);
+}
+
+/*!
+ * \brief Merge two leftist trees copying only the nodes of the right spines
+ *
+ * \return MinHeapPersistent_t The merged tree, NULL if a node cannot be allocated
+ */
+static MinHeapPersistent_t min_heap_persistent_meld(const MinHeapPersistentHandler_t *heap,
+                                                    MinHeapPersistent_t a,
+                                                    MinHeapPersistent_t b) {
+    if (a == NULL)
+        return b;
+    if (b == NULL)
+        return a;
+    // The root with the minimum item is kept on top
+    if (heap->compare((void *)b->data, (void *)a->data) < 0) {
+        MinHeapPersistent_t aux = a;
+        a = b;
+        b = aux;
+    }
+
+    MinHeapPersistent_t merged = min_heap_persistent_meld(heap, a->right, b);
+    if (merged == NULL)
+        return NULL;
+    MinHeapPersistentNode_t *node = min_heap_persistent_new_node(heap);
+    if (node == NULL)
+        return NULL;
+    memcpy(node->data, a->data, heap->data_size);
+    node->size = a->size + b->size;
+
+    // Restore the leftist property
+    if (min_heap_persistent_rank(a->left) >= merged->rank) {
+        node->left = a->left;
+        node->right = merged;
+    } else {
+        node->left = merged;
+        node->right = a->left;
+    }
+    node->rank = min_heap_persistent_rank(node->right) + 1;
+    return node;
+}
+
+MinHeapReturnCode min_heap_persistent_api_init(
+    MinHeapPersistentHandler_t *heap,
+    size_t data_size,
+    int8_t (*compare)(void *, void *),
+    ArenaAllocatorHandler_t *arena) {
+    if (heap == NULL || compare == NULL || arena == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    heap->data_size = data_size;
+    heap->compare = compare;
+    heap->arena = arena;
+    return MIN_HEAP_OK;
+}
+
+size_t min_heap_persistent_api_size(MinHeapPersistent_t version) {
+    return version == NULL ? 0U : version->size;
+}
+
+const void *min_heap_persistent_api_peek(MinHeapPersistent_t version) {
+    return version == NULL ? NULL : version->data;
+}
+
+MinHeapReturnCode min_heap_persistent_api_insert(
+    const MinHeapPersistentHandler_t *heap,
+    MinHeapPersistent_t version,
+    void *item,
+    MinHeapPersistent_t *out) {
+    if (heap == NULL || heap->compare == NULL || item == NULL || out == NULL)
+        return MIN_HEAP_NULL_POINTER;
+
+    // A single node heap merged with the current version
+    MinHeapPersistentNode_t *node = min_heap_persistent_new_node(heap);
+    if (node == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    memcpy(node->data, item, heap->data_size);
+    node->rank = 1;
+    node->size = 1;
+
+    MinHeapPersistent_t res = min_heap_persistent_meld(heap, version, node);
+    if (res == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    *out = res;
+    return MIN_HEAP_OK;
+}
+
+MinHeapReturnCode min_heap_persistent_api_pop(
+    const MinHeapPersistentHandler_t *heap,
+    MinHeapPersistent_t version,
+    void *item,
+    MinHeapPersistent_t *out) {
+    if (heap == NULL || heap->compare == NULL || out == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (version == NULL)
+        return MIN_HEAP_EMPTY;
+
+    MinHeapPersistent_t res = NULL;
+    if (version->left != NULL || version->right != NULL) {
+        res = min_heap_persistent_meld(heap, version->left, version->right);
+        if (res == NULL)
+            return MIN_HEAP_NULL_POINTER;
+    }
+    if (item != NULL)
+        memcpy(item, version->data, heap->data_size);
+    *out = res;
+    return MIN_HEAP_OK;
+}
+
+MinHeapReturnCode min_heap_persistent_api_meld(
+    const MinHeapPersistentHandler_t *heap,
+    MinHeapPersistent_t a,
+    MinHeapPersistent_t b,
+    MinHeapPersistent_t *out) {
+    if (heap == NULL || heap->compare == NULL || out == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    MinHeapPersistent_t res = min_heap_persistent_meld(heap, a, b);
+    if (res == NULL && (a != NULL || b != NULL))
+        return MIN_HEAP_NULL_POINTER;
+    *out = res;
+    return MIN_HEAP_OK;
+}
@@ -0,0 +1,97 @@
+/*!
+ * \file min-heap-selector-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that implements a selector of the least loaded worker
+ */
+
+#include "min-heap-selector-api.h"
+#include "min-heap-api.h"
+
+#include <stddef.h>
+
+/*!
+ * \brief Item of the heap
+ *
+ * \var load The load of the worker
+ * \var worker The index of the worker, used as the handle of the item
+ */
+typedef struct {
+    uint64_t load;
+    uint32_t worker;
+} MinHeapSelectorItem_t;
+
+MinHeapReturnCode min_heap_selector_api_init(MinHeapSelectorHandler_t *selector, size_t worker_count, ArenaAllocatorHandler_t *arena) {
+    if (selector == NULL || arena == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (worker_count == 0 || worker_count > UINT32_MAX)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+
+    const MinHeapKeyField_t keys[] = {
+        { offsetof(MinHeapSelectorItem_t, load), MIN_HEAP_KEY_U64, MIN_HEAP_KEY_ASC },
+        { offsetof(MinHeapSelectorItem_t, worker), MIN_HEAP_KEY_U32, MIN_HEAP_KEY_ASC },
+    };
+    MinHeapReturnCode res = min_heap_api_init_keys(&selector->heap, sizeof(MinHeapSelectorItem_t), worker_count, keys, 2, arena);
+    if (res != MIN_HEAP_OK)
+        return res;
+    res = min_heap_api_handles_init(&selector->heap, offsetof(MinHeapSelectorItem_t, worker), worker_count, arena);
+    if (res != MIN_HEAP_OK)
+        return res;
+
+    // The workers in increasing order are already a valid heap
+    for (size_t i = 0; i < worker_count; ++i) {
+        MinHeapSelectorItem_t item = { .load = 0, .worker = (uint32_t)i };
+        res = min_heap_api_insert(&selector->heap, &item);
+        if (res != MIN_HEAP_OK)
+            return res;
+    }
+    selector->worker_count = worker_count;
+    return MIN_HEAP_OK;
+}
+
+MinHeapReturnCode min_heap_selector_api_acquire(MinHeapSelectorHandler_t *selector, uint32_t load, size_t *worker) {
+    if (selector == NULL || worker == NULL || selector->heap.data == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (selector->heap.size == 0)
+        return MIN_HEAP_EMPTY;
+
+    MinHeapSelectorItem_t *top = min_heap_api_peek(&selector->heap);
+    if (top->load > UINT64_MAX - load)
+        return MIN_HEAP_FULL;
+    *worker = top->worker;
+    // A greater key can only move the root down
+    top->load += load;
+    return min_heap_api_update(&selector->heap, 0);
+}
+
+MinHeapReturnCode min_heap_selector_api_release(MinHeapSelectorHandler_t *selector, size_t worker, uint32_t load) {
+    if (selector == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (worker >= selector->worker_count)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+
+    signed_size_t index = min_heap_api_position(&selector->heap, (uint32_t)worker);
+    if (index < 0)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    MinHeapSelectorItem_t *item = min_heap_api_at(&selector->heap, (size_t)index);
+    if (item->load < load)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    // A lower key can only move the item up
+    item->load -= load;
+    return min_heap_api_update(&selector->heap, (size_t)index);
+}
+
+MinHeapReturnCode min_heap_selector_api_load(const MinHeapSelectorHandler_t *selector, size_t worker, uint64_t *load) {
+    if (selector == NULL || load == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (worker >= selector->worker_count)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+
+    signed_size_t index = min_heap_api_position(&selector->heap, (uint32_t)worker);
+    if (index < 0)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    *load = ((const MinHeapSelectorItem_t *)min_heap_api_at(&selector->heap, (size_t)index))->load;
+    return MIN_HEAP_OK;
+}
@@ -0,0 +1,157 @@
+/*!
+ * \file min-heap-timer-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that implements a timer heap whose deadlines are stored as
+ *      16 or 32 bit offsets from a per-heap epoch
+ */
+
+#include "min-heap-timer-api.h"
+#include "min-heap-api.h"
+
+#include <string.h>
+
+/*!
+ * \brief Macro to get the address of a slot of the heap given its index
+ *
+ * \param T The timer heap handler
+ * \param I The slot index
+ * \return The address of the slot
+ */
+#define MIN_HEAP_TIMER_SLOT(T, I) ((uint8_t *)(T)->heap.data + (I) * (T)->heap.data_size)
+
+/*!
+ * \brief Read the offset at the start of a slot
+ */
+static inline uint64_t min_heap_timer_get_offset(const MinHeapTimerHandler_t *timer, const uint8_t *slot) {
+    if (timer->key_size == sizeof(uint16_t)) {
+        uint16_t offset;
+        memcpy(&offset, slot, sizeof(offset));
+        return offset;
+    }
+    uint32_t offset;
+    memcpy(&offset, slot, sizeof(offset));
+    return offset;
+}
+
+/*!
+ * \brief Write the offset at the start of a slot
+ */
+static inline void min_heap_timer_set_offset(const MinHeapTimerHandler_t *timer, uint8_t *slot, uint64_t value) {
+    if (timer->key_size == sizeof(uint16_t)) {
+        uint16_t offset = (uint16_t)value;
+        memcpy(slot, &offset, sizeof(offset));
+    } else {
+        uint32_t offset = (uint32_t)value;
+        memcpy(slot, &offset, sizeof(offset));
+    }
+}
+
+MinHeapReturnCode min_heap_timer_api_init(
+    MinHeapTimerHandler_t *timer,
+    MinHeapKeyType key_type,
+    size_t payload_size,
+    size_t capacity,
+    uint64_t epoch,
+    ArenaAllocatorHandler_t *arena) {
+    if (timer == NULL || arena == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (key_type == MIN_HEAP_KEY_U16) {
+        timer->key_size = sizeof(uint16_t);
+        timer->max_offset = UINT16_MAX;
+    } else if (key_type == MIN_HEAP_KEY_U32) {
+        timer->key_size = sizeof(uint32_t);
+        timer->max_offset = UINT32_MAX;
+    } else {
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    }
+    timer->payload_size = payload_size;
+    timer->epoch = epoch;
+
+    MinHeapKeyField_t key = { 0, key_type, MIN_HEAP_KEY_ASC };
+    return min_heap_api_init_keys(&timer->heap, timer->key_size + payload_size, capacity, &key, 1, arena);
+}
+
+size_t min_heap_timer_api_size(const MinHeapTimerHandler_t *timer) {
+    return timer == NULL ? 0U : timer->heap.size;
+}
+
+MinHeapReturnCode min_heap_timer_api_clear(MinHeapTimerHandler_t *timer) {
+    if (timer == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    return min_heap_api_clear(&timer->heap);
+}
+
+MinHeapReturnCode min_heap_timer_api_insert(MinHeapTimerHandler_t *timer, uint64_t deadline, const void *payload) {
+    if (timer == NULL || (payload == NULL && timer->payload_size > 0))
+        return MIN_HEAP_NULL_POINTER;
+    if (deadline < timer->epoch || deadline - timer->epoch > timer->max_offset)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+
+    uint8_t slot[timer->heap.data_size];
+    min_heap_timer_set_offset(timer, slot, deadline - timer->epoch);
+    if (timer->payload_size > 0)
+        memcpy(slot + timer->key_size, payload, timer->payload_size);
+    return min_heap_api_insert(&timer->heap, slot);
+}
+
+void *min_heap_timer_api_peek(const MinHeapTimerHandler_t *timer, uint64_t *deadline) {
+    if (timer == NULL)
+        return NULL;
+    uint8_t *slot = min_heap_api_peek(&timer->heap);
+    if (slot == NULL)
+        return NULL;
+    if (deadline != NULL)
+        *deadline = timer->epoch + min_heap_timer_get_offset(timer, slot);
+    return slot + timer->key_size;
+}
+
+MinHeapReturnCode min_heap_timer_api_pop(MinHeapTimerHandler_t *timer, uint64_t *deadline, void *payload) {
+    if (timer == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    uint8_t slot[timer->heap.data_size];
+    MinHeapReturnCode res = min_heap_api_remove(&timer->heap, 0, slot);
+    if (res != MIN_HEAP_OK)
+        return res;
+    if (deadline != NULL)
+        *deadline = timer->epoch + min_heap_timer_get_offset(timer, slot);
+    if (payload != NULL && timer->payload_size > 0)
+        memcpy(payload, slot + timer->key_size, timer->payload_size);
+    return MIN_HEAP_OK;
+}
+
+MinHeapReturnCode min_heap_timer_api_rebase(MinHeapTimerHandler_t *timer, uint64_t epoch) {
+    if (timer == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (timer->heap.ext != NULL && timer->heap.ext->txn_active)
+        return MIN_HEAP_INVALID_STATE;
+    const size_t size = timer->heap.size;
+
+    if (epoch >= timer->epoch) {
+        // The earliest deadline is the root
+        uint64_t shift = epoch - timer->epoch;
+        if (size > 0 && min_heap_timer_get_offset(timer, MIN_HEAP_TIMER_SLOT(timer, 0)) < shift)
+            return MIN_HEAP_OUT_OF_BOUNDS;
+        for (size_t i = 0; i < size; ++i) {
+            uint8_t *slot = MIN_HEAP_TIMER_SLOT(timer, i);
+            min_heap_timer_set_offset(timer, slot, min_heap_timer_get_offset(timer, slot) - shift);
+        }
+    } else {
+        // The latest deadline is one of the leaves
+        uint64_t shift = timer->epoch - epoch;
+        if (size > 0 && shift > timer->max_offset)
+            return MIN_HEAP_OUT_OF_BOUNDS;
+        for (size_t i = size / 2; i < size; ++i) {
+            if (min_heap_timer_get_offset(timer, MIN_HEAP_TIMER_SLOT(timer, i)) > timer->max_offset - shift)
+                return MIN_HEAP_OUT_OF_BOUNDS;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            uint8_t *slot = MIN_HEAP_TIMER_SLOT(timer, i);
+            min_heap_timer_set_offset(timer, slot, min_heap_timer_get_offset(timer, slot) + shift);
+        }
+    }
+    timer->epoch = epoch;
+    return MIN_HEAP_OK;
+}
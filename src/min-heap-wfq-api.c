@@ -0,0 +1,201 @@
+/*!
+ * \file min-heap-wfq-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Library that implements a weighted fair queuing packet scheduler
+ *      that shares a link between flows with different weights
+ */
+
+#include "min-heap-wfq-api.h"
+#include "min-heap-api.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*!
+ * \brief Macro to get a packet slot given its index
+ *
+ * \param W The scheduler handler
+ * \param I The slot index
+ * \return The address of the packet header
+ */
+#define MIN_HEAP_WFQ_PACKET(W, I) ((MinHeapWfqPacket_t *)((W)->packets + (size_t)(I) * (W)->slot_size))
+
+/*!
+ * \brief Item of the heaps, the first packet of a backlogged flow
+ *
+ * \var key The virtual finish time (eligible heap) or start time (pending heap)
+ * \var flow The index of the flow, used to break the ties
+ */
+typedef struct {
+    uint64_t key;
+    uint32_t flow;
+} MinHeapWfqEntry_t;
+
+/*!
+ * \brief Insert the first packet of a flow in the heap of its state
+ */
+static MinHeapReturnCode min_heap_wfq_schedule(MinHeapWfqHandler_t *wfq, size_t flow) {
+    const MinHeapWfqPacket_t *packet = MIN_HEAP_WFQ_PACKET(wfq, wfq->flows[flow].head);
+    if (wfq->mode == MIN_HEAP_WFQ_MODE_WF2Q && packet->start > wfq->vtime) {
+        MinHeapWfqEntry_t entry = { .key = packet->start, .flow = (uint32_t)flow };
+        return min_heap_api_insert(&wfq->pending, &entry);
+    }
+    MinHeapWfqEntry_t entry = { .key = packet->finish, .flow = (uint32_t)flow };
+    return min_heap_api_insert(&wfq->eligible, &entry);
+}
+
+MinHeapReturnCode min_heap_wfq_api_init(
+    MinHeapWfqHandler_t *wfq,
+    MinHeapWfqMode mode,
+    size_t flow_count,
+    size_t packet_capacity,
+    size_t payload_size,
+    ArenaAllocatorHandler_t *arena) {
+    if (wfq == NULL || arena == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if ((mode != MIN_HEAP_WFQ_MODE_WFQ && mode != MIN_HEAP_WFQ_MODE_WF2Q) || flow_count == 0 ||
+        flow_count > UINT32_MAX || packet_capacity == 0 || packet_capacity >= MIN_HEAP_WFQ_NONE)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+
+    // Each flow has at most one packet in one of the heaps
+    const MinHeapKeyField_t keys[] = {
+        { offsetof(MinHeapWfqEntry_t, key), MIN_HEAP_KEY_U64, MIN_HEAP_KEY_ASC },
+        { offsetof(MinHeapWfqEntry_t, flow), MIN_HEAP_KEY_U32, MIN_HEAP_KEY_ASC },
+    };
+    MinHeapReturnCode res = min_heap_api_init_keys(&wfq->eligible, sizeof(MinHeapWfqEntry_t), flow_count, keys, 2, arena);
+    if (res != MIN_HEAP_OK)
+        return res;
+    res = min_heap_api_init_keys(&wfq->pending, sizeof(MinHeapWfqEntry_t), mode == MIN_HEAP_WFQ_MODE_WF2Q ? flow_count : 1, keys, 2, arena);
+    if (res != MIN_HEAP_OK)
+        return res;
+
+    wfq->flows = arena_allocator_api_calloc(arena, sizeof(MinHeapWfqFlow_t), flow_count);
+    // The slots are aligned to 8 bytes for the header of the next packet
+    wfq->slot_size = (sizeof(MinHeapWfqPacket_t) + payload_size + 7U) & ~(size_t)7U;
+    wfq->packets = arena_allocator_api_calloc(arena, wfq->slot_size, packet_capacity);
+    if (wfq->flows == NULL || wfq->packets == NULL)
+        return MIN_HEAP_NULL_POINTER;
+
+    for (size_t i = 0; i < flow_count; ++i) {
+        wfq->flows[i].weight = 1;
+        wfq->flows[i].head = MIN_HEAP_WFQ_NONE;
+        wfq->flows[i].tail = MIN_HEAP_WFQ_NONE;
+    }
+    for (size_t i = 0; i < packet_capacity; ++i)
+        MIN_HEAP_WFQ_PACKET(wfq, i)->next = i + 1 < packet_capacity ? (uint32_t)(i + 1) : MIN_HEAP_WFQ_NONE;
+    wfq->flow_count = flow_count;
+    wfq->payload_size = payload_size;
+    wfq->free_head = 0;
+    wfq->size = 0;
+    wfq->vtime = 0;
+    wfq->active_weight = 0;
+    wfq->mode = mode;
+    return MIN_HEAP_OK;
+}
+
+MinHeapReturnCode min_heap_wfq_api_set_weight(MinHeapWfqHandler_t *wfq, size_t flow, uint32_t weight) {
+    if (wfq == NULL || wfq->flows == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (flow >= wfq->flow_count || weight == 0)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    MinHeapWfqFlow_t *f = &wfq->flows[flow];
+    if (f->backlog > 0)
+        wfq->active_weight = wfq->active_weight - f->weight + weight;
+    f->weight = weight;
+    return MIN_HEAP_OK;
+}
+
+size_t min_heap_wfq_api_size(const MinHeapWfqHandler_t *wfq) {
+    return wfq == NULL ? 0U : wfq->size;
+}
+
+MinHeapReturnCode min_heap_wfq_api_enqueue(MinHeapWfqHandler_t *wfq, size_t flow, uint32_t length, const void *payload) {
+    if (wfq == NULL || wfq->flows == NULL || (payload == NULL && wfq->payload_size > 0))
+        return MIN_HEAP_NULL_POINTER;
+    if (flow >= wfq->flow_count)
+        return MIN_HEAP_OUT_OF_BOUNDS;
+    if (wfq->free_head == MIN_HEAP_WFQ_NONE)
+        return MIN_HEAP_FULL;
+
+    const uint32_t index = wfq->free_head;
+    MinHeapWfqPacket_t *packet = MIN_HEAP_WFQ_PACKET(wfq, index);
+    MinHeapWfqFlow_t *f = &wfq->flows[flow];
+    wfq->free_head = packet->next;
+
+    // A flow that was idle cannot claim the service it did not use
+    packet->start = f->last_finish > wfq->vtime ? f->last_finish : wfq->vtime;
+    packet->finish = packet->start + (uint64_t)length * MIN_HEAP_WFQ_SCALE / f->weight;
+    packet->length = length;
+    packet->next = MIN_HEAP_WFQ_NONE;
+    if (wfq->payload_size > 0)
+        memcpy(packet + 1, payload, wfq->payload_size);
+    f->last_finish = packet->finish;
+
+    if (f->backlog == 0) {
+        f->head = index;
+        f->tail = index;
+        wfq->active_weight += f->weight;
+        min_heap_wfq_schedule(wfq, flow);
+    } else {
+        MIN_HEAP_WFQ_PACKET(wfq, f->tail)->next = index;
+        f->tail = index;
+    }
+    ++f->backlog;
+    ++wfq->size;
+    return MIN_HEAP_OK;
+}
+
+MinHeapReturnCode min_heap_wfq_api_dequeue(MinHeapWfqHandler_t *wfq, size_t *flow, uint32_t *length, void *payload) {
+    if (wfq == NULL || wfq->flows == NULL)
+        return MIN_HEAP_NULL_POINTER;
+    if (wfq->size == 0)
+        return MIN_HEAP_EMPTY;
+
+    MinHeapWfqEntry_t entry;
+    if (wfq->mode == MIN_HEAP_WFQ_MODE_WF2Q) {
+        // The virtual time is at least the earliest start time of the flows
+        if (min_heap_api_is_empty(&wfq->eligible)) {
+            const MinHeapWfqEntry_t *top = min_heap_api_peek(&wfq->pending);
+            wfq->vtime = top->key > wfq->vtime ? top->key : wfq->vtime;
+        }
+        // Move the packets that have started to the eligible heap
+        while (!min_heap_api_is_empty(&wfq->pending) && ((MinHeapWfqEntry_t *)min_heap_api_peek(&wfq->pending))->key <= wfq->vtime) {
+            min_heap_api_remove(&wfq->pending, 0, &entry);
+            entry.key = MIN_HEAP_WFQ_PACKET(wfq, wfq->flows[entry.flow].head)->finish;
+            min_heap_api_insert(&wfq->eligible, &entry);
+        }
+    }
+    min_heap_api_remove(&wfq->eligible, 0, &entry);
+
+    MinHeapWfqFlow_t *f = &wfq->flows[entry.flow];
+    const uint32_t index = f->head;
+    MinHeapWfqPacket_t *packet = MIN_HEAP_WFQ_PACKET(wfq, index);
+    if (flow != NULL)
+        *flow = entry.flow;
+    if (length != NULL)
+        *length = packet->length;
+    if (payload != NULL && wfq->payload_size > 0)
+        memcpy(payload, packet + 1, wfq->payload_size);
+
+    // Advance the virtual time by the service just given
+    if (wfq->mode == MIN_HEAP_WFQ_MODE_WF2Q)
+        wfq->vtime += (uint64_t)packet->length * MIN_HEAP_WFQ_SCALE / wfq->active_weight;
+    else
+        wfq->vtime = packet->finish;
+
+    f->head = packet->next;
+    --f->backlog;
+    --wfq->size;
+    packet->next = wfq->free_head;
+    wfq->free_head = index;
+    if (f->backlog == 0) {
+        f->tail = MIN_HEAP_WFQ_NONE;
+        wfq->active_weight -= f->weight;
+    } else {
+        min_heap_wfq_schedule(wfq, entry.flow);
+    }
+    return MIN_HEAP_OK;
+}
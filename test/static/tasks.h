@@ -0,0 +1,27 @@
+/*!
+ * \file tasks.h
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Item type of the example static heap (examples/min-heap-static.json)
+ *      used by the test of the generator
+ */
+
+#ifndef TASKS_H
+#define TASKS_H
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t deadline;
+    uint8_t priority;
+    void (*callback)(void);
+} Task;
+
+void task_can_send(void);
+void task_read_sensors(void);
+void task_watchdog(void);
+void task_telemetry(void);
+
+#endif
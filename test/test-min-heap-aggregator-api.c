@@ -0,0 +1,170 @@
+/*!
+ * \file test-min-heap-aggregator-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Tests of the aggregator of min heaps
+ */
+
+#include "unity.h"
+#include "min-heap-api.h"
+#include "min-heap-aggregator-api.h"
+
+#define HEAP_COUNT (5U)
+
+int8_t min_heap_compare_int(void *f, void *s) {
+    int a = *(int *)f;
+    int b = *(int *)s;
+    if (a < b)
+        return -1;
+    return a == b ? 0 : 1;
+}
+
+MinHeapHandler_t heaps[HEAP_COUNT];
+MinHeapHandler_t *members[HEAP_COUNT];
+MinHeapAggregatorHandler_t agg;
+ArenaAllocatorHandler_t arena;
+
+void setUp(void) {
+    arena_allocator_api_init(&arena);
+    for (size_t i = 0; i < HEAP_COUNT; ++i) {
+        min_heap_api_init(&heaps[i], sizeof(int), 32, min_heap_compare_int, &arena);
+        members[i] = &heaps[i];
+    }
+    min_heap_aggregator_api_init(&agg, members, HEAP_COUNT, &arena);
+}
+
+void tearDown(void) {
+    arena_allocator_api_free(&arena);
+}
+
+/*!
+ * \defgroup min_heap_aggregator_api_init Test aggregator initialization
+ * @{
+ */
+
+void check_min_heap_aggregator_api_init_with_null_handler(void) {
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_aggregator_api_init(NULL, members, HEAP_COUNT, &arena));
+}
+void check_min_heap_aggregator_api_init_with_null_heaps(void) {
+    MinHeapAggregatorHandler_t a;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_aggregator_api_init(&a, NULL, HEAP_COUNT, &arena));
+}
+void check_min_heap_aggregator_api_init_with_zero_heaps(void) {
+    MinHeapAggregatorHandler_t a;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_aggregator_api_init(&a, members, 0, &arena));
+}
+void check_min_heap_aggregator_api_init_with_items(void) {
+    int a = 7, b = 3;
+    MinHeapAggregatorHandler_t other;
+    min_heap_api_insert(&heaps[1], &a);
+    min_heap_api_insert(&heaps[4], &b);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_aggregator_api_init(&other, members, HEAP_COUNT, &arena));
+    TEST_ASSERT_EQUAL(4, min_heap_aggregator_api_top_member(&other));
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_aggregator_api_insert Test aggregator insert and peek
+ * @{
+ */
+
+void check_min_heap_aggregator_api_peek_when_empty(void) {
+    TEST_ASSERT_NULL(min_heap_aggregator_api_peek(&agg));
+    TEST_ASSERT_LESS_THAN_INT(0, min_heap_aggregator_api_top_member(&agg));
+}
+void check_min_heap_aggregator_api_insert_out_of_bounds(void) {
+    int a = 1;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_aggregator_api_insert(&agg, HEAP_COUNT, &a));
+}
+void check_min_heap_aggregator_api_insert_top(void) {
+    int a = 10, b = 5, c = 7;
+    min_heap_aggregator_api_insert(&agg, 0, &a);
+    TEST_ASSERT_EQUAL(0, min_heap_aggregator_api_top_member(&agg));
+    min_heap_aggregator_api_insert(&agg, 3, &b);
+    TEST_ASSERT_EQUAL(3, min_heap_aggregator_api_top_member(&agg));
+    min_heap_aggregator_api_insert(&agg, 0, &c);
+    TEST_ASSERT_EQUAL(3, min_heap_aggregator_api_top_member(&agg));
+    TEST_ASSERT_EQUAL_INT(5, *(int *)min_heap_aggregator_api_peek(&agg));
+}
+void check_min_heap_aggregator_api_update(void) {
+    int a = 10, b = 1;
+    min_heap_aggregator_api_insert(&agg, 0, &a);
+    // Direct modification of a member
+    min_heap_api_insert(&heaps[2], &b);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_aggregator_api_update(&agg, 2));
+    TEST_ASSERT_EQUAL(2, min_heap_aggregator_api_top_member(&agg));
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_aggregator_api_pop Test aggregator global pop
+ * @{
+ */
+
+void check_min_heap_aggregator_api_pop_when_empty(void) {
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_EMPTY, min_heap_aggregator_api_pop(&agg, NULL, NULL));
+}
+void check_min_heap_aggregator_api_pop_order(void) {
+    uint32_t seed = 7;
+    for (int i = 0; i < 100; ++i) {
+        seed = seed * 1664525U + 1013904223U;
+        int val = (int)(seed >> 20);
+        min_heap_aggregator_api_insert(&agg, (seed >> 8) % HEAP_COUNT, &val);
+    }
+    int prev = -1;
+    for (int i = 0; i < 100; ++i) {
+        int cur;
+        size_t member;
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_aggregator_api_pop(&agg, &cur, &member));
+        TEST_ASSERT_LESS_THAN_INT(HEAP_COUNT, member);
+        TEST_ASSERT_GREATER_OR_EQUAL_INT(prev, cur);
+        prev = cur;
+    }
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_EMPTY, min_heap_aggregator_api_pop(&agg, NULL, NULL));
+}
+
+/*! @} */
+
+int main() {
+    UNITY_BEGIN();
+
+    /*!
+     * \addtogroup min_heap_aggregator_api_init Run test for aggregator initialization
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_aggregator_api_init_with_null_handler);
+    RUN_TEST(check_min_heap_aggregator_api_init_with_null_heaps);
+    RUN_TEST(check_min_heap_aggregator_api_init_with_zero_heaps);
+    RUN_TEST(check_min_heap_aggregator_api_init_with_items);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_aggregator_api_insert Run test for aggregator insert and peek
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_aggregator_api_peek_when_empty);
+    RUN_TEST(check_min_heap_aggregator_api_insert_out_of_bounds);
+    RUN_TEST(check_min_heap_aggregator_api_insert_top);
+    RUN_TEST(check_min_heap_aggregator_api_update);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_aggregator_api_pop Run test for aggregator global pop
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_aggregator_api_pop_when_empty);
+    RUN_TEST(check_min_heap_aggregator_api_pop_order);
+
+    /*! @} */
+
+    UNITY_END();
+}
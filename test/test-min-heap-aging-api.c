@@ -0,0 +1,184 @@
+/*!
+ * \file test-min-heap-aging-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Tests of the priority queue with aging
+ */
+
+#include "unity.h"
+#include "min-heap-api.h"
+#include "min-heap-aging-api.h"
+
+MinHeapAgingHandler_t aging;
+ArenaAllocatorHandler_t arena;
+
+void setUp(void) {
+    arena_allocator_api_init(&arena);
+    min_heap_aging_api_init(&aging, sizeof(int), 64, 10, &arena);
+}
+
+void tearDown(void) {
+    arena_allocator_api_free(&arena);
+}
+
+/*!
+ * \defgroup min_heap_aging_api_init Test aging queue initialization
+ * @{
+ */
+
+void check_min_heap_aging_api_init_with_null_pointers(void) {
+    MinHeapAgingHandler_t a;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_aging_api_init(NULL, 0, 8, 1, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_aging_api_init(&a, 0, 8, 1, NULL));
+}
+void check_min_heap_aging_api_init_without_period(void) {
+    MinHeapAgingHandler_t a;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_aging_api_init(&a, 0, 8, 0, &arena));
+}
+void check_min_heap_aging_api_init_empty(void) {
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_aging_api_size(&aging));
+    TEST_ASSERT_NULL(min_heap_aging_api_peek(&aging, 0, NULL));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_EMPTY, min_heap_aging_api_pop(&aging, 0, NULL, NULL));
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_aging_api_pop Test aging queue insertion and removal
+ * @{
+ */
+
+void check_min_heap_aging_api_pop_by_priority(void) {
+    int prios[4] = { 3, 1, 2, 0 };
+    for (int i = 0; i < 4; ++i)
+        min_heap_aging_api_insert(&aging, prios[i], 100, &i);
+    int ids[4] = { 3, 1, 2, 0 };
+    for (int i = 0; i < 4; ++i) {
+        int id;
+        int32_t prio;
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_aging_api_pop(&aging, 100, &prio, &id));
+        TEST_ASSERT_EQUAL_INT(ids[i], id);
+        TEST_ASSERT_EQUAL_INT(i, prio);
+    }
+}
+void check_min_heap_aging_api_effective_priority(void) {
+    int id = 0;
+    min_heap_aging_api_insert(&aging, 5, 1000, &id);
+    int32_t prio;
+    min_heap_aging_api_peek(&aging, 1000, &prio);
+    TEST_ASSERT_EQUAL_INT(5, prio);
+    min_heap_aging_api_peek(&aging, 1009, &prio);
+    TEST_ASSERT_EQUAL_INT(4, prio);
+    min_heap_aging_api_peek(&aging, 1010, &prio);
+    TEST_ASSERT_EQUAL_INT(4, prio);
+    min_heap_aging_api_peek(&aging, 1071, &prio);
+    TEST_ASSERT_EQUAL_INT(-3, prio);
+}
+void check_min_heap_aging_api_no_starvation(void) {
+    // A low priority item is served before the items inserted after (7 - 0) * period
+    int low = -1;
+    min_heap_aging_api_insert(&aging, 7, 0, &low);
+    uint64_t now = 0;
+    for (int i = 0; i < 100; ++i, now += 5) {
+        min_heap_aging_api_insert(&aging, 0, now, &i);
+        int id;
+        min_heap_aging_api_pop(&aging, now, NULL, &id);
+        if (id == low)
+            break;
+    }
+    TEST_ASSERT_TRUE(now <= 75);
+    TEST_ASSERT_TRUE(now >= 70);
+}
+void check_min_heap_aging_api_insert_out_of_range(void) {
+    int id = 0;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_aging_api_insert(&aging, 0, (uint64_t)INT64_MAX + 1, &id));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_aging_api_insert(&aging, 1, (uint64_t)INT64_MAX - 5, &id));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_aging_api_insert(&aging, INT32_MIN, 0, &id));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_aging_api_insert(&aging, 0, 0, NULL));
+
+    // The effective priority saturates
+    int32_t prio;
+    min_heap_aging_api_peek(&aging, 1000, &prio);
+    TEST_ASSERT_EQUAL_INT(INT32_MIN, prio);
+}
+void check_min_heap_aging_api_like_rescan(void) {
+    // Compare with a linear scan of the effective priorities, equal ones in FIFO order
+    struct {
+        int32_t prio;
+        uint64_t enqueue;
+        int id;
+    } pending[64];
+    size_t count = 0;
+    uint64_t now = 0;
+    unsigned seed = 5;
+    min_heap_api_stable_init(&aging.heap, &arena);
+    for (int i = 0; i < 3000; ++i) {
+        seed = seed * 1103515245U + 12345U;
+        now += (seed >> 8) % 7;
+        if ((seed & 0x300) != 0 && count < 64) {
+            int32_t prio = (int32_t)((seed >> 16) % 20);
+            TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_aging_api_insert(&aging, prio, now, &i));
+            pending[count].prio = prio;
+            pending[count].enqueue = now;
+            pending[count].id = i;
+            ++count;
+        } else if (count > 0) {
+            size_t best = 0;
+            for (size_t j = 1; j < count; ++j) {
+                // Effective priorities scaled by the period to stay exact
+                int64_t a = (int64_t)pending[j].prio * 10 - (int64_t)(now - pending[j].enqueue);
+                int64_t b = (int64_t)pending[best].prio * 10 - (int64_t)(now - pending[best].enqueue);
+                if (a < b)
+                    best = j;
+            }
+            int id;
+            TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_aging_api_pop(&aging, now, NULL, &id));
+            TEST_ASSERT_EQUAL_INT(pending[best].id, id);
+            for (size_t j = best; j + 1 < count; ++j)
+                pending[j] = pending[j + 1];
+            --count;
+        }
+        TEST_ASSERT_EQUAL_size_t(count, min_heap_aging_api_size(&aging));
+    }
+}
+void check_min_heap_aging_api_clear(void) {
+    int id = 0;
+    min_heap_aging_api_insert(&aging, 0, 0, &id);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_aging_api_clear(&aging));
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_aging_api_size(&aging));
+}
+
+/*! @} */
+
+int main() {
+    UNITY_BEGIN();
+
+    /*!
+     * \addtogroup min_heap_aging_api_init Run test for aging queue initialization
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_aging_api_init_with_null_pointers);
+    RUN_TEST(check_min_heap_aging_api_init_without_period);
+    RUN_TEST(check_min_heap_aging_api_init_empty);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_aging_api_pop Run test for aging queue insertion and removal
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_aging_api_pop_by_priority);
+    RUN_TEST(check_min_heap_aging_api_effective_priority);
+    RUN_TEST(check_min_heap_aging_api_no_starvation);
+    RUN_TEST(check_min_heap_aging_api_insert_out_of_range);
+    RUN_TEST(check_min_heap_aging_api_like_rescan);
+    RUN_TEST(check_min_heap_aging_api_clear);
+
+    /*! @} */
+
+    UNITY_END();
+}
@@ -18,6 +18,9 @@
  *      by using the arena allocator.
  */
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "unity.h"
 #include "min-heap-api.h"
 
@@ -39,6 +42,14 @@ int8_t min_heap_compare_int(void *f, void *s) {
         return -1;
     return a == b ? 0 : 1;
 }
+typedef struct {
+    int priority;
+    int id;
+} Task;
+
+int8_t min_heap_compare_task(void *f, void *s) {
+    return min_heap_compare_int(&((Task *)f)->priority, &((Task *)s)->priority);
+}
 int8_t min_heap_compare_point(void *f, void *s) {
     Point *a = (Point *)f;
     Point *b = (Point *)s;
@@ -49,6 +60,10 @@ int8_t min_heap_compare_point(void *f, void *s) {
     return dist_a == dist_b ? 0 : 1;
 }
 
+uint32_t min_heap_hash_int(void *item) {
+    return (uint32_t)(*(int *)item) * 2654435761U;
+}
+
 MinHeapHandler_t int_heap;
 MinHeapHandler_t point_heap;
 ArenaAllocatorHandler_t arena;
@@ -84,6 +99,21 @@ void check_min_heap_api_init_with_null_callback(void) {
 void check_min_heap_api_init(void) {
     MinHeapHandler_t heap;
     TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_init(&heap, sizeof(float), 3, min_heap_compare_float, &arena));
+    TEST_ASSERT_NULL(heap.ext);
+}
+void check_min_heap_api_init_extension(void) {
+    // The extension is allocated by the first optional feature and shared by the others
+    TEST_ASSERT_NULL(int_heap.ext);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_stable_init(&int_heap, &arena));
+    MinHeapExtension_t *ext = int_heap.ext;
+    TEST_ASSERT_NOT_NULL(ext);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_bloom_init(&int_heap, 64, min_heap_hash_int, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_txn_init(&int_heap, &arena));
+    TEST_ASSERT_EQUAL_PTR(ext, int_heap.ext);
+    TEST_ASSERT_NOT_NULL(ext->seq);
+    TEST_ASSERT_NOT_NULL(ext->bloom);
+    TEST_ASSERT_NOT_NULL(ext->undo);
+    TEST_ASSERT_NULL(point_heap.ext);
 }
 
 /*! @} */
@@ -575,6 +605,1124 @@ void check_min_heap_api_find_when_null_data(void) {
 
 /*! @} */
 
+/*!
+ * \defgroup min_heap_api_complexity Test the number of comparisons done by the min heap functions
+ * @{
+ */
+
+#define COMPLEXITY_MAX_SIZE (4096U)
+#define COMPLEXITY_EXTRA_CMP (3U)
+
+static const size_t complexity_sizes[] = { 16U, 255U, 1024U, COMPLEXITY_MAX_SIZE };
+static size_t complexity_cmp_count = 0U;
+static uint32_t complexity_seed = 0U;
+
+int8_t min_heap_compare_int_counted(void *f, void *s) {
+    ++complexity_cmp_count;
+    return min_heap_compare_int(f, s);
+}
+
+static int complexity_rand(void) {
+    // Simple LCG so that the inputs are the same on every platform
+    complexity_seed = complexity_seed * 1664525U + 1013904223U;
+    return (int)(complexity_seed >> 8);
+}
+
+static size_t complexity_log2(size_t n) {
+    size_t res = 0;
+    while (n >>= 1)
+        ++res;
+    return res;
+}
+
+static void complexity_fill(MinHeapHandler_t *heap, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        int val = complexity_rand();
+        min_heap_api_insert(heap, &val);
+    }
+}
+
+void check_min_heap_api_insert_comparisons(void) {
+    for (size_t s = 0; s < sizeof(complexity_sizes) / sizeof(complexity_sizes[0]); ++s) {
+        MinHeapHandler_t heap;
+        complexity_seed = s + 1;
+        min_heap_api_init(&heap, sizeof(int), complexity_sizes[s], min_heap_compare_int_counted, &arena);
+
+        for (size_t i = 0; i < complexity_sizes[s]; ++i) {
+            int val = complexity_rand();
+            complexity_cmp_count = 0;
+            min_heap_api_insert(&heap, &val);
+            // At most one comparison for each level of the tree
+            TEST_ASSERT_LESS_OR_EQUAL_size_t_MESSAGE(complexity_log2(heap.size) + COMPLEXITY_EXTRA_CMP, complexity_cmp_count, "Too many comparisons during insertion");
+        }
+    }
+}
+void check_min_heap_api_insert_decreasing_comparisons(void) {
+    // Worst case, every item has to be moved up to the root
+    MinHeapHandler_t heap;
+    min_heap_api_init(&heap, sizeof(int), COMPLEXITY_MAX_SIZE, min_heap_compare_int_counted, &arena);
+    for (int i = COMPLEXITY_MAX_SIZE; i > 0; --i) {
+        complexity_cmp_count = 0;
+        min_heap_api_insert(&heap, &i);
+        TEST_ASSERT_LESS_OR_EQUAL_size_t_MESSAGE(complexity_log2(heap.size) + COMPLEXITY_EXTRA_CMP, complexity_cmp_count, "Too many comparisons during insertion");
+    }
+}
+void check_min_heap_api_remove_top_comparisons(void) {
+    for (size_t s = 0; s < sizeof(complexity_sizes) / sizeof(complexity_sizes[0]); ++s) {
+        MinHeapHandler_t heap;
+        complexity_seed = s + 11;
+        min_heap_api_init(&heap, sizeof(int), complexity_sizes[s], min_heap_compare_int_counted, &arena);
+        complexity_fill(&heap, complexity_sizes[s]);
+
+        while (heap.size > 0) {
+            size_t bound = 2 * complexity_log2(heap.size) + COMPLEXITY_EXTRA_CMP;
+            complexity_cmp_count = 0;
+            min_heap_api_remove(&heap, 0, NULL);
+            // At most two comparisons for each level of the tree
+            TEST_ASSERT_LESS_OR_EQUAL_size_t_MESSAGE(bound, complexity_cmp_count, "Too many comparisons during removal of the top");
+        }
+    }
+}
+void check_min_heap_api_remove_any_comparisons(void) {
+    for (size_t s = 0; s < sizeof(complexity_sizes) / sizeof(complexity_sizes[0]); ++s) {
+        MinHeapHandler_t heap;
+        complexity_seed = s + 21;
+        min_heap_api_init(&heap, sizeof(int), complexity_sizes[s], min_heap_compare_int_counted, &arena);
+        complexity_fill(&heap, complexity_sizes[s]);
+
+        while (heap.size > 0) {
+            size_t bound = 2 * complexity_log2(heap.size) + COMPLEXITY_EXTRA_CMP;
+            size_t index = (size_t)complexity_rand() % heap.size;
+            complexity_cmp_count = 0;
+            min_heap_api_remove(&heap, index, NULL);
+            TEST_ASSERT_LESS_OR_EQUAL_size_t_MESSAGE(bound, complexity_cmp_count, "Too many comparisons during removal");
+        }
+    }
+}
+void check_min_heap_api_remove_top_order(void) {
+    // The comparison bounds are meaningful only if the heap is still correct
+    MinHeapHandler_t heap;
+    complexity_seed = 31;
+    min_heap_api_init(&heap, sizeof(int), COMPLEXITY_MAX_SIZE, min_heap_compare_int, &arena);
+    complexity_fill(&heap, COMPLEXITY_MAX_SIZE);
+
+    int prev;
+    min_heap_api_remove(&heap, 0, &prev);
+    while (heap.size > 0) {
+        int cur;
+        min_heap_api_remove(&heap, 0, &cur);
+        TEST_ASSERT_LESS_OR_EQUAL_INT(cur, prev);
+        prev = cur;
+    }
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_api_remove_by_value Test min heap remove by value function
+ * @{
+ */
+
+void check_min_heap_api_remove_by_value_with_null_heap(void) {
+    int a = 0;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_remove_by_value(NULL, &a, NULL));
+}
+void check_min_heap_api_remove_by_value_with_null_item(void) {
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_remove_by_value(&int_heap, NULL, NULL));
+}
+void check_min_heap_api_remove_by_value_not_found(void) {
+    int_heap.size = 3;
+    ((int *)int_heap.data)[0] = 3;
+    ((int *)int_heap.data)[1] = 7;
+    ((int *)int_heap.data)[2] = 6;
+    int a = 2;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NOT_FOUND, min_heap_api_remove_by_value(&int_heap, &a, NULL));
+}
+void check_min_heap_api_remove_by_value_data(void) {
+    int_heap.size = 3;
+    ((int *)int_heap.data)[0] = 3;
+    ((int *)int_heap.data)[1] = 7;
+    ((int *)int_heap.data)[2] = 6;
+    int a = 7;
+    int removed = 0;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_remove_by_value(&int_heap, &a, &removed));
+    TEST_ASSERT_EQUAL_INT(7, removed);
+    TEST_ASSERT_EQUAL_size_t(2U, int_heap.size);
+    TEST_ASSERT_LESS_THAN_INT(0, min_heap_api_find(&int_heap, &a));
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_api_bloom_init Test min heap Bloom filter
+ * @{
+ */
+
+void check_min_heap_api_bloom_init_with_null_heap(void) {
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_bloom_init(NULL, 64, min_heap_hash_int, &arena));
+}
+void check_min_heap_api_bloom_init_with_null_hash(void) {
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_bloom_init(&int_heap, 64, NULL, &arena));
+}
+void check_min_heap_api_bloom_init_with_zero_counters(void) {
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_api_bloom_init(&int_heap, 0, min_heap_hash_int, &arena));
+}
+void check_min_heap_api_bloom_init_existing_items(void) {
+    int a = 4, b = 2;
+    min_heap_api_insert(&int_heap, &a);
+    min_heap_api_insert(&int_heap, &b);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_bloom_init(&int_heap, 64, min_heap_hash_int, &arena));
+    TEST_ASSERT_EQUAL(1, min_heap_api_find(&int_heap, &a));
+    TEST_ASSERT_EQUAL(0, min_heap_api_find(&int_heap, &b));
+}
+void check_min_heap_api_bloom_find_after_remove(void) {
+    min_heap_api_bloom_init(&int_heap, 64, min_heap_hash_int, &arena);
+    for (int i = 0; i < 10; ++i)
+        min_heap_api_insert(&int_heap, &i);
+    for (int i = 0; i < 10; i += 2)
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_remove_by_value(&int_heap, &i, NULL));
+    for (int i = 0; i < 10; ++i) {
+        if (i % 2)
+            TEST_ASSERT_GREATER_OR_EQUAL_INT(0, min_heap_api_find(&int_heap, &i));
+        else
+            TEST_ASSERT_LESS_THAN_INT(0, min_heap_api_find(&int_heap, &i));
+    }
+}
+void check_min_heap_api_bloom_skip_scan(void) {
+    // Missing items must be rejected without calling the compare callback
+    MinHeapHandler_t heap;
+    min_heap_api_init(&heap, sizeof(int), 16, min_heap_compare_int_counted, &arena);
+    min_heap_api_bloom_init(&heap, 1024, min_heap_hash_int, &arena);
+    for (int i = 0; i < 16; ++i)
+        min_heap_api_insert(&heap, &i);
+
+    size_t skipped = 0;
+    for (int i = 100; i < 200; ++i) {
+        complexity_cmp_count = 0;
+        TEST_ASSERT_LESS_THAN_INT(0, min_heap_api_find(&heap, &i));
+        if (complexity_cmp_count == 0)
+            ++skipped;
+    }
+    TEST_ASSERT_GREATER_OR_EQUAL_INT(90, skipped);
+}
+void check_min_heap_api_bloom_clear(void) {
+    int a = 5;
+    min_heap_api_bloom_init(&int_heap, 64, min_heap_hash_int, &arena);
+    min_heap_api_insert(&int_heap, &a);
+    min_heap_api_clear(&int_heap);
+    ((int *)int_heap.data)[0] = a;
+    int_heap.size = 1;
+    // The item is not known by the filter anymore
+    TEST_ASSERT_LESS_THAN_INT(0, min_heap_api_find(&int_heap, &a));
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_api_stable_init Test min heap stable mode
+ * @{
+ */
+
+void check_min_heap_api_stable_init_with_null_heap(void) {
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_stable_init(NULL, &arena));
+}
+void check_min_heap_api_stable_init_with_null_arena(void) {
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_stable_init(&int_heap, NULL));
+}
+void check_min_heap_api_stable_fifo_order(void) {
+    MinHeapHandler_t heap;
+    min_heap_api_init(&heap, sizeof(Task), 64, min_heap_compare_task, &arena);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_stable_init(&heap, &arena));
+
+    // Three priorities interleaved
+    for (int i = 0; i < 60; ++i) {
+        Task t = { .priority = (i * 7) % 3, .id = i };
+        min_heap_api_insert(&heap, &t);
+    }
+    Task prev;
+    min_heap_api_remove(&heap, 0, &prev);
+    while (!min_heap_api_is_empty(&heap)) {
+        Task cur;
+        min_heap_api_remove(&heap, 0, &cur);
+        TEST_ASSERT_LESS_OR_EQUAL_INT(cur.priority, prev.priority);
+        if (cur.priority == prev.priority)
+            TEST_ASSERT_GREATER_THAN_INT(prev.id, cur.id);
+        prev = cur;
+    }
+}
+void check_min_heap_api_stable_fifo_after_remove(void) {
+    MinHeapHandler_t heap;
+    min_heap_api_init(&heap, sizeof(Task), 32, min_heap_compare_task, &arena);
+    min_heap_api_stable_init(&heap, &arena);
+    for (int i = 0; i < 32; ++i) {
+        Task t = { .priority = 1, .id = i };
+        min_heap_api_insert(&heap, &t);
+    }
+    // Remove some items in the middle of the heap
+    min_heap_api_remove(&heap, 20, NULL);
+    min_heap_api_remove(&heap, 5, NULL);
+    min_heap_api_remove(&heap, 11, NULL);
+
+    int prev = -1;
+    while (!min_heap_api_is_empty(&heap)) {
+        Task cur;
+        min_heap_api_remove(&heap, 0, &cur);
+        TEST_ASSERT_GREATER_THAN_INT(prev, cur.id);
+        prev = cur.id;
+    }
+}
+void check_min_heap_api_stable_sequence_wrap(void) {
+    MinHeapHandler_t heap;
+    min_heap_api_init(&heap, sizeof(Task), 16, min_heap_compare_task, &arena);
+    min_heap_api_stable_init(&heap, &arena);
+    heap.ext->next_seq = UINT32_MAX - 4;
+    for (int i = 0; i < 10; ++i) {
+        Task t = { .priority = 0, .id = i };
+        min_heap_api_insert(&heap, &t);
+    }
+    for (int i = 0; i < 10; ++i) {
+        Task cur;
+        min_heap_api_remove(&heap, 0, &cur);
+        TEST_ASSERT_EQUAL_INT(i, cur.id);
+    }
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_api_select Test select and partial sort functions
+ * @{
+ */
+
+static int select_compare_qsort(const void *a, const void *b) {
+    return min_heap_compare_int((void *)a, (void *)b);
+}
+
+void check_min_heap_api_select_with_null_array(void) {
+    int out[2];
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_select(NULL, 4, 2, sizeof(int), min_heap_compare_int, out));
+}
+void check_min_heap_api_select_with_null_out(void) {
+    int array[4] = { 4, 3, 2, 1 };
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_select(array, 4, 2, sizeof(int), min_heap_compare_int, NULL));
+}
+void check_min_heap_api_select_out_of_bounds(void) {
+    int array[4] = { 4, 3, 2, 1 };
+    int out[5];
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_api_select(array, 4, 5, sizeof(int), min_heap_compare_int, out));
+}
+void check_min_heap_api_select_data(void) {
+    int array[COMPLEXITY_MAX_SIZE];
+    int sorted[COMPLEXITY_MAX_SIZE];
+    int out[50];
+    complexity_seed = 41;
+    for (size_t i = 0; i < COMPLEXITY_MAX_SIZE; ++i)
+        sorted[i] = array[i] = complexity_rand() % 1000;
+    qsort(sorted, COMPLEXITY_MAX_SIZE, sizeof(int), select_compare_qsort);
+
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_select(array, COMPLEXITY_MAX_SIZE, 50, sizeof(int), min_heap_compare_int, out));
+    TEST_ASSERT_EQUAL_INT_ARRAY(sorted, out, 50);
+}
+void check_min_heap_api_select_all(void) {
+    int array[5] = { 5, 1, 4, 2, 3 };
+    int expected[5] = { 1, 2, 3, 4, 5 };
+    int out[5];
+    min_heap_api_select(array, 5, 5, sizeof(int), min_heap_compare_int, out);
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, out, 5);
+}
+void check_min_heap_api_select_comparisons(void) {
+    // With k much lower than n the number of comparisons is close to n
+    int array[COMPLEXITY_MAX_SIZE];
+    int out[8];
+    complexity_seed = 43;
+    for (size_t i = 0; i < COMPLEXITY_MAX_SIZE; ++i)
+        array[i] = complexity_rand();
+    complexity_cmp_count = 0;
+    min_heap_api_select(array, COMPLEXITY_MAX_SIZE, 8, sizeof(int), min_heap_compare_int_counted, out);
+    TEST_ASSERT_LESS_OR_EQUAL_size_t(2 * COMPLEXITY_MAX_SIZE, complexity_cmp_count);
+}
+void check_min_heap_api_partial_sort_data(void) {
+    int array[COMPLEXITY_MAX_SIZE];
+    int sorted[COMPLEXITY_MAX_SIZE];
+    complexity_seed = 47;
+    for (size_t i = 0; i < COMPLEXITY_MAX_SIZE; ++i)
+        sorted[i] = array[i] = complexity_rand() % 1000;
+    qsort(sorted, COMPLEXITY_MAX_SIZE, sizeof(int), select_compare_qsort);
+
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_partial_sort(array, COMPLEXITY_MAX_SIZE, 100, sizeof(int), min_heap_compare_int));
+    TEST_ASSERT_EQUAL_INT_ARRAY(sorted, array, 100);
+
+    // The other items are still in the array
+    qsort(array, COMPLEXITY_MAX_SIZE, sizeof(int), select_compare_qsort);
+    TEST_ASSERT_EQUAL_INT_ARRAY(sorted, array, COMPLEXITY_MAX_SIZE);
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_api_collect_below Test min heap collect below function
+ * @{
+ */
+
+void check_min_heap_api_collect_below_with_null_heap(void) {
+    int bound = 5;
+    int out[4];
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_api_collect_below(NULL, &bound, out, 4));
+}
+void check_min_heap_api_collect_below_when_empty(void) {
+    int bound = 5;
+    int out[4];
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_api_collect_below(&int_heap, &bound, out, 4));
+}
+void check_min_heap_api_collect_below_none(void) {
+    int bound = 0;
+    int out[10];
+    for (int i = 1; i <= 10; ++i)
+        min_heap_api_insert(&int_heap, &i);
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_api_collect_below(&int_heap, &bound, out, 10));
+}
+void check_min_heap_api_collect_below_data(void) {
+    MinHeapHandler_t heap;
+    int out[COMPLEXITY_MAX_SIZE];
+    int bound = 1000;
+    size_t expected = 0;
+    complexity_seed = 53;
+    min_heap_api_init(&heap, sizeof(int), COMPLEXITY_MAX_SIZE, min_heap_compare_int_counted, &arena);
+    for (size_t i = 0; i < COMPLEXITY_MAX_SIZE; ++i) {
+        int val = complexity_rand() % 100000;
+        if (val <= bound)
+            ++expected;
+        min_heap_api_insert(&heap, &val);
+    }
+
+    complexity_cmp_count = 0;
+    size_t count = min_heap_api_collect_below(&heap, &bound, out, COMPLEXITY_MAX_SIZE);
+    TEST_ASSERT_EQUAL_size_t(expected, count);
+    // At most the root and two children of every item in range are compared
+    TEST_ASSERT_LESS_OR_EQUAL_size_t(2 * count + 1, complexity_cmp_count);
+    for (size_t i = 0; i < count; ++i)
+        TEST_ASSERT_LESS_OR_EQUAL_INT(bound, out[i]);
+}
+void check_min_heap_api_collect_below_max(void) {
+    int bound = 100;
+    int out[3];
+    for (int i = 0; i < 10; ++i)
+        min_heap_api_insert(&int_heap, &i);
+    TEST_ASSERT_EQUAL_size_t(3U, min_heap_api_collect_below(&int_heap, &bound, out, 3));
+    TEST_ASSERT_EQUAL_size_t(10U, int_heap.size);
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_api_txn Test min heap transactions
+ * @{
+ */
+
+void check_min_heap_api_txn_begin_not_enabled(void) {
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_txn_begin(&int_heap));
+}
+void check_min_heap_api_txn_begin_twice(void) {
+    min_heap_api_txn_init(&int_heap, &arena);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_txn_begin(&int_heap));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_INVALID_STATE, min_heap_api_txn_begin(&int_heap));
+}
+void check_min_heap_api_txn_commit_without_begin(void) {
+    min_heap_api_txn_init(&int_heap, &arena);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_INVALID_STATE, min_heap_api_txn_commit(&int_heap));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_INVALID_STATE, min_heap_api_txn_rollback(&int_heap));
+}
+void check_min_heap_api_txn_commit_data(void) {
+    int a = 5, b = 3;
+    min_heap_api_txn_init(&int_heap, &arena);
+    min_heap_api_insert(&int_heap, &a);
+    min_heap_api_txn_begin(&int_heap);
+    min_heap_api_insert(&int_heap, &b);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_txn_commit(&int_heap));
+    TEST_ASSERT_EQUAL_size_t(2U, int_heap.size);
+    TEST_ASSERT_EQUAL_INT(3, *(int *)min_heap_api_peek(&int_heap));
+}
+void check_min_heap_api_txn_rollback_data(void) {
+    MinHeapHandler_t heap;
+    int before[64];
+    complexity_seed = 61;
+    min_heap_api_init(&heap, sizeof(int), 64, min_heap_compare_int, &arena);
+    min_heap_api_txn_init(&heap, &arena);
+    complexity_fill(&heap, 40);
+    memcpy(before, heap.data, 40 * sizeof(int));
+
+    for (int round = 0; round < 3; ++round) {
+        min_heap_api_txn_begin(&heap);
+        for (int i = 0; i < 10; ++i) {
+            int val = complexity_rand();
+            min_heap_api_insert(&heap, &val);
+            min_heap_api_remove(&heap, (size_t)complexity_rand() % heap.size, NULL);
+            min_heap_api_remove(&heap, 0, NULL);
+        }
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_txn_rollback(&heap));
+        TEST_ASSERT_EQUAL_size_t(40U, heap.size);
+        TEST_ASSERT_EQUAL_INT_ARRAY(before, heap.data, 40);
+    }
+}
+void check_min_heap_api_txn_rollback_clear(void) {
+    int before[10];
+    for (int i = 10; i > 0; --i)
+        min_heap_api_insert(&int_heap, &i);
+    memcpy(before, int_heap.data, sizeof(before));
+    min_heap_api_txn_init(&int_heap, &arena);
+    min_heap_api_txn_begin(&int_heap);
+    min_heap_api_clear(&int_heap);
+    int a = 42;
+    min_heap_api_insert(&int_heap, &a);
+    min_heap_api_txn_rollback(&int_heap);
+    TEST_ASSERT_EQUAL_size_t(10U, int_heap.size);
+    TEST_ASSERT_EQUAL_INT_ARRAY(before, int_heap.data, 10);
+}
+void check_min_heap_api_txn_rollback_bloom(void) {
+    min_heap_api_bloom_init(&int_heap, 128, min_heap_hash_int, &arena);
+    min_heap_api_txn_init(&int_heap, &arena);
+    for (int i = 0; i < 6; ++i)
+        min_heap_api_insert(&int_heap, &i);
+    min_heap_api_txn_begin(&int_heap);
+    int a = 100, b = 3, c = 5;
+    min_heap_api_insert(&int_heap, &a);
+    min_heap_api_remove_by_value(&int_heap, &b, NULL);
+    min_heap_api_remove_by_value(&int_heap, &c, NULL);
+    min_heap_api_txn_rollback(&int_heap);
+
+    TEST_ASSERT_LESS_THAN_INT(0, min_heap_api_find(&int_heap, &a));
+    for (int i = 0; i < 6; ++i)
+        TEST_ASSERT_GREATER_OR_EQUAL_INT(0, min_heap_api_find(&int_heap, &i));
+}
+void check_min_heap_api_txn_rollback_stable(void) {
+    MinHeapHandler_t heap;
+    min_heap_api_init(&heap, sizeof(Task), 16, min_heap_compare_task, &arena);
+    min_heap_api_stable_init(&heap, &arena);
+    min_heap_api_txn_init(&heap, &arena);
+    for (int i = 0; i < 8; ++i) {
+        Task t = { .priority = i % 2, .id = i };
+        min_heap_api_insert(&heap, &t);
+    }
+    min_heap_api_txn_begin(&heap);
+    for (int i = 0; i < 4; ++i)
+        min_heap_api_remove(&heap, 0, NULL);
+    min_heap_api_txn_rollback(&heap);
+
+    // The FIFO order of equal items is preserved
+    int expected[8] = { 0, 2, 4, 6, 1, 3, 5, 7 };
+    for (int i = 0; i < 8; ++i) {
+        Task t;
+        min_heap_api_remove(&heap, 0, &t);
+        TEST_ASSERT_EQUAL_INT(expected[i], t.id);
+    }
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_api_init_keys Test min heap lexicographic key specification
+ * @{
+ */
+
+void check_min_heap_api_init_keys_with_null_pointers(void) {
+    MinHeapHandler_t heap;
+    MinHeapKeyField_t keys[] = { { offsetof(Task, priority), MIN_HEAP_KEY_I32, MIN_HEAP_KEY_ASC } };
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_init_keys(NULL, sizeof(Task), 8, keys, 1, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_init_keys(&heap, sizeof(Task), 8, NULL, 1, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_init_keys(&heap, sizeof(Task), 8, keys, 1, NULL));
+}
+void check_min_heap_api_init_keys_invalid(void) {
+    MinHeapHandler_t heap;
+    MinHeapKeyField_t keys[] = { { offsetof(Task, priority), MIN_HEAP_KEY_I32, (MinHeapKeyOrder)0 } };
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_api_init_keys(&heap, sizeof(Task), 8, keys, 0, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_api_init_keys(&heap, sizeof(Task), 8, keys, 1, &arena));
+}
+void check_min_heap_api_init_keys_out_of_item(void) {
+    MinHeapHandler_t heap;
+    MinHeapKeyField_t past[] = { { sizeof(Task), MIN_HEAP_KEY_U8, MIN_HEAP_KEY_ASC } };
+    MinHeapKeyField_t wide[] = { { sizeof(Task) - sizeof(uint32_t), MIN_HEAP_KEY_U64, MIN_HEAP_KEY_ASC } };
+    MinHeapKeyField_t last[] = {
+        { offsetof(Task, priority), MIN_HEAP_KEY_I32, MIN_HEAP_KEY_ASC },
+        { sizeof(Task) - sizeof(uint32_t), MIN_HEAP_KEY_U32, MIN_HEAP_KEY_ASC }
+    };
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_api_init_keys(&heap, sizeof(Task), 8, past, 1, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_api_init_keys(&heap, sizeof(Task), 8, wide, 1, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_init_keys(&heap, sizeof(Task), 8, last, 2, &arena));
+}
+void check_min_heap_api_init_keys_ok(void) {
+    MinHeapHandler_t heap;
+    MinHeapKeyField_t keys[] = { { offsetof(Task, priority), MIN_HEAP_KEY_I32, MIN_HEAP_KEY_ASC } };
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_init_keys(&heap, sizeof(Task), 8, keys, 1, &arena));
+    TEST_ASSERT_NULL(heap.compare);
+    TEST_ASSERT_EQUAL_size_t(1U, heap.ext->key_count);
+    TEST_ASSERT_NOT_EQUAL(keys, heap.ext->keys);
+    TEST_ASSERT_EQUAL_size_t(0U, heap.size);
+}
+void check_min_heap_api_init_keys_order(void) {
+    MinHeapHandler_t heap;
+    MinHeapKeyField_t keys[] = {
+        { offsetof(Task, priority), MIN_HEAP_KEY_I32, MIN_HEAP_KEY_ASC },
+        { offsetof(Task, id), MIN_HEAP_KEY_I32, MIN_HEAP_KEY_DESC },
+    };
+    min_heap_api_init_keys(&heap, sizeof(Task), 16, keys, 2, &arena);
+    for (int i = 0; i < 12; ++i) {
+        Task t = { .priority = i % 3, .id = i };
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_insert(&heap, &t));
+    }
+
+    // Increasing priority, then decreasing id
+    int expected[12] = { 9, 6, 3, 0, 10, 7, 4, 1, 11, 8, 5, 2 };
+    for (int i = 0; i < 12; ++i) {
+        Task t;
+        min_heap_api_remove(&heap, 0, &t);
+        TEST_ASSERT_EQUAL_INT(expected[i], t.id);
+    }
+}
+void check_min_heap_api_init_keys_single_field(void) {
+    MinHeapHandler_t heap;
+    MinHeapKeyField_t keys[] = { { offsetof(Task, id), MIN_HEAP_KEY_I32, MIN_HEAP_KEY_DESC } };
+    min_heap_api_init_keys(&heap, sizeof(Task), 16, keys, 1, &arena);
+    for (int i = 0; i < 16; ++i) {
+        Task t = { .priority = 0, .id = (i * 7) % 16 };
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_insert(&heap, &t));
+    }
+
+    // The field is not at the beginning of the item
+    for (int i = 15; i >= 0; --i) {
+        Task t;
+        min_heap_api_remove(&heap, 0, &t);
+        TEST_ASSERT_EQUAL_INT(i, t.id);
+    }
+}
+void check_min_heap_api_init_keys_types(void) {
+    typedef struct {
+        uint8_t u8;
+        int64_t i64;
+        double d;
+    } Item;
+    MinHeapHandler_t heap;
+    MinHeapKeyField_t keys[] = {
+        { offsetof(Item, u8), MIN_HEAP_KEY_U8, MIN_HEAP_KEY_DESC },
+        { offsetof(Item, i64), MIN_HEAP_KEY_I64, MIN_HEAP_KEY_ASC },
+        { offsetof(Item, d), MIN_HEAP_KEY_DOUBLE, MIN_HEAP_KEY_ASC },
+    };
+    Item items[] = {
+        { 1, -5, 0.5 },
+        { 200, 3, 1.5 },
+        { 200, -7, 2.5 },
+        { 1, -5, -0.5 },
+        { 200, 3, 0.25 },
+    };
+    min_heap_api_init_keys(&heap, sizeof(Item), 8, keys, 3, &arena);
+    for (size_t i = 0; i < 5; ++i)
+        min_heap_api_insert(&heap, &items[i]);
+    TEST_ASSERT_GREATER_OR_EQUAL_INT(0, min_heap_api_find(&heap, &items[4]));
+
+    double expected[5] = { 2.5, 0.25, 1.5, -0.5, 0.5 };
+    for (size_t i = 0; i < 5; ++i) {
+        Item it;
+        min_heap_api_remove(&heap, 0, &it);
+        TEST_ASSERT_EQUAL_FLOAT((float)expected[i], (float)it.d);
+    }
+}
+void check_min_heap_api_init_keys_compare(void) {
+    MinHeapHandler_t heap;
+    MinHeapKeyField_t keys[] = { { 0, MIN_HEAP_KEY_I32, MIN_HEAP_KEY_DESC } };
+    int a = 1, b = 2;
+    min_heap_api_init_keys(&heap, sizeof(int), 4, keys, 1, &arena);
+    TEST_ASSERT_GREATER_THAN_INT(0, min_heap_api_compare(&heap, &a, &b));
+    TEST_ASSERT_LESS_THAN_INT(0, min_heap_api_compare(&int_heap, &a, &b));
+    TEST_ASSERT_EQUAL_INT(0, min_heap_api_compare(&heap, &a, &a));
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_api_build Test min heap bulk build function
+ * @{
+ */
+
+void check_min_heap_api_build_with_null_pointers(void) {
+    int items[2] = { 1, 2 };
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_build(NULL, items, 2));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_build(&int_heap, NULL, 2));
+}
+void check_min_heap_api_build_too_many(void) {
+    int items[11] = { 0 };
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_FULL, min_heap_api_build(&int_heap, items, 11));
+}
+void check_min_heap_api_build_data(void) {
+    int items[10] = { 7, 3, 9, 1, 8, 2, 6, 0, 5, 4 };
+    int a = 42;
+    min_heap_api_insert(&int_heap, &a);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_build(&int_heap, items, 10));
+    TEST_ASSERT_EQUAL_size_t(10U, int_heap.size);
+    for (int i = 0; i < 10; ++i) {
+        int out;
+        min_heap_api_remove(&int_heap, 0, &out);
+        TEST_ASSERT_EQUAL_INT(i, out);
+    }
+}
+void check_min_heap_api_build_in_place(void) {
+    int items[5] = { 4, 3, 2, 1, 0 };
+    memcpy(int_heap.data, items, sizeof(items));
+    min_heap_api_build(&int_heap, int_heap.data, 5);
+    TEST_ASSERT_EQUAL_INT(0, *(int *)min_heap_api_peek(&int_heap));
+}
+void check_min_heap_api_build_keys(void) {
+    // Compare the key specification build with the callback one
+    static int items[1000];
+    MinHeapHandler_t callback;
+    MinHeapHandler_t keyed;
+    MinHeapKeyField_t keys[] = { { 0, MIN_HEAP_KEY_I32, MIN_HEAP_KEY_ASC } };
+    complexity_seed = 17;
+    for (size_t i = 0; i < 1000; ++i)
+        items[i] = complexity_rand() % 200 - 100;
+    min_heap_api_init(&callback, sizeof(int), 1000, min_heap_compare_int, &arena);
+    min_heap_api_init_keys(&keyed, sizeof(int), 1000, keys, 1, &arena);
+    for (size_t n = 0; n <= 1000; n += 37) {
+        min_heap_api_build(&callback, items, n);
+        min_heap_api_build(&keyed, items, n);
+        TEST_ASSERT_EQUAL_size_t(n, keyed.size);
+        if (n > 0)
+            TEST_ASSERT_EQUAL_INT_ARRAY(callback.data, keyed.data, n);
+    }
+}
+void check_min_heap_api_build_simd_scalar(void) {
+    // The vectorized build gives the same layout of the scalar one for every tail of count % 8
+    static uint32_t items[1200];
+    const MinHeapKeyField_t keys[][1] = {
+        { { 0, MIN_HEAP_KEY_I32, MIN_HEAP_KEY_ASC } },
+        { { 0, MIN_HEAP_KEY_U32, MIN_HEAP_KEY_ASC } },
+        { { 0, MIN_HEAP_KEY_I32, MIN_HEAP_KEY_DESC } },
+        { { 0, MIN_HEAP_KEY_U32, MIN_HEAP_KEY_DESC } },
+    };
+    complexity_seed = 29;
+    for (size_t i = 0; i < 1200; ++i) {
+        // Few distinct values for the ties, both signs and the extremes
+        uint32_t r = (uint32_t)complexity_rand();
+        items[i] = (r & 3) == 0 ? (r & 4 ? UINT32_MAX : 0x80000000U) : (r % 64) * 0x04000001U;
+    }
+    for (size_t k = 0; k < 4; ++k) {
+        MinHeapHandler_t simd;
+        MinHeapHandler_t scalar;
+        min_heap_api_init_keys(&simd, sizeof(uint32_t), 1200, keys[k], 1, &arena);
+        min_heap_api_init_keys(&scalar, sizeof(uint32_t), 1200, keys[k], 1, &arena);
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_set_simd(&scalar, false));
+        for (size_t n = 0; n <= 1200; n += n < 80 ? 1 : 97) {
+            min_heap_api_build(&simd, items, n);
+            min_heap_api_build(&scalar, items, n);
+            TEST_ASSERT_EQUAL_size_t(n, simd.size);
+            if (n > 0)
+                TEST_ASSERT_EQUAL_INT_ARRAY(scalar.data, simd.data, n);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_set_simd(NULL, false));
+}
+void check_min_heap_api_build_keys_desc_unsigned(void) {
+    static uint32_t items[500];
+    MinHeapHandler_t heap;
+    MinHeapKeyField_t keys[] = { { 0, MIN_HEAP_KEY_U32, MIN_HEAP_KEY_DESC } };
+    complexity_seed = 23;
+    for (size_t i = 0; i < 500; ++i)
+        items[i] = (uint32_t)complexity_rand() * 2654435761U;
+    min_heap_api_init_keys(&heap, sizeof(uint32_t), 500, keys, 1, &arena);
+    min_heap_api_build(&heap, items, 500);
+
+    uint32_t prev = UINT32_MAX;
+    for (size_t i = 0; i < 500; ++i) {
+        uint32_t out;
+        min_heap_api_remove(&heap, 0, &out);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(prev, out);
+        prev = out;
+    }
+}
+void check_min_heap_api_build_rollback(void) {
+    int items[4] = { 9, 8, 7, 6 };
+    int before[3];
+    for (int i = 3; i > 0; --i)
+        min_heap_api_insert(&int_heap, &i);
+    memcpy(before, int_heap.data, sizeof(before));
+    min_heap_api_txn_init(&int_heap, &arena);
+    min_heap_api_txn_begin(&int_heap);
+    min_heap_api_build(&int_heap, items, 4);
+    min_heap_api_txn_rollback(&int_heap);
+    TEST_ASSERT_EQUAL_size_t(3U, int_heap.size);
+    TEST_ASSERT_EQUAL_INT_ARRAY(before, int_heap.data, 3);
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_api_build_radix Test min heap radix sort bulk build function
+ * @{
+ */
+
+void check_min_heap_api_build_radix_with_null_pointers(void) {
+    int items[2] = { 1, 2 };
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_build_radix(NULL, items, 2, items));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_build_radix(&int_heap, NULL, 2, items));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_build_radix(&int_heap, items, 2, NULL));
+}
+void check_min_heap_api_build_radix_without_keys(void) {
+    int items[2] = { 1, 2 };
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_INVALID_STATE, min_heap_api_build_radix(&int_heap, items, 2, items));
+}
+void check_min_heap_api_build_radix_too_many(void) {
+    MinHeapHandler_t heap;
+    MinHeapKeyField_t keys[] = { { 0, MIN_HEAP_KEY_I32, MIN_HEAP_KEY_ASC } };
+    int items[5] = { 0 };
+    min_heap_api_init_keys(&heap, sizeof(int), 4, keys, 1, &arena);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_FULL, min_heap_api_build_radix(&heap, items, 5, items));
+}
+void check_min_heap_api_build_radix_sorted(void) {
+    static int items[1000];
+    static int expected[1000];
+    MinHeapHandler_t heap;
+    MinHeapKeyField_t keys[] = { { 0, MIN_HEAP_KEY_I32, MIN_HEAP_KEY_ASC } };
+    complexity_seed = 29;
+    for (size_t i = 0; i < 1000; ++i)
+        items[i] = (int)((unsigned)complexity_rand() * 7919U);
+    memcpy(expected, items, sizeof(items));
+    min_heap_api_partial_sort(expected, 1000, 1000, sizeof(int), min_heap_compare_int);
+
+    // The scratch buffer is the input array itself
+    min_heap_api_init_keys(&heap, sizeof(int), 1000, keys, 1, &arena);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_build_radix(&heap, items, 1000, items));
+    TEST_ASSERT_EQUAL_size_t(1000U, heap.size);
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, heap.data, 1000);
+}
+void check_min_heap_api_build_radix_fields(void) {
+    typedef struct {
+        float f;
+        int16_t i16;
+        uint8_t u8;
+    } Item;
+    MinHeapHandler_t heap;
+    MinHeapKeyField_t keys[] = {
+        { offsetof(Item, f), MIN_HEAP_KEY_FLOAT, MIN_HEAP_KEY_ASC },
+        { offsetof(Item, i16), MIN_HEAP_KEY_I16, MIN_HEAP_KEY_DESC },
+        { offsetof(Item, u8), MIN_HEAP_KEY_U8, MIN_HEAP_KEY_ASC },
+    };
+    Item items[] = {
+        { 1.5f, -3, 7 },
+        { -2.25f, 100, 1 },
+        { 1.5f, 40, 9 },
+        { 0.0f, 0, 0 },
+        { -2.25f, 100, 0 },
+        { -100.0f, -1, 5 },
+        { 1.5f, -3, 2 },
+    };
+    Item scratch[7];
+    uint8_t expected[7] = { 5, 0, 1, 0, 9, 2, 7 };
+    min_heap_api_init_keys(&heap, sizeof(Item), 8, keys, 3, &arena);
+    min_heap_api_build_radix(&heap, items, 7, scratch);
+    for (size_t i = 0; i < 7; ++i)
+        TEST_ASSERT_EQUAL_UINT8(expected[i], ((Item *)heap.data)[i].u8);
+}
+void check_min_heap_api_build_radix_stable(void) {
+    MinHeapHandler_t heap;
+    MinHeapKeyField_t keys[] = { { offsetof(Task, priority), MIN_HEAP_KEY_I32, MIN_HEAP_KEY_ASC } };
+    Task items[8];
+    Task scratch[8];
+    for (int i = 0; i < 8; ++i)
+        items[i] = (Task){ .priority = 1 - i % 2, .id = i };
+    min_heap_api_init_keys(&heap, sizeof(Task), 8, keys, 1, &arena);
+    min_heap_api_stable_init(&heap, &arena);
+    min_heap_api_build_radix(&heap, items, 8, scratch);
+
+    // Equal items keep the order of the array even after more insertions
+    Task t = { .priority = 0, .id = 8 };
+    min_heap_api_remove(&heap, 0, NULL);
+    min_heap_api_insert(&heap, &t);
+    int expected[8] = { 3, 5, 7, 8, 0, 2, 4, 6 };
+    for (int i = 0; i < 8; ++i) {
+        min_heap_api_remove(&heap, 0, &t);
+        TEST_ASSERT_EQUAL_INT(expected[i], t.id);
+    }
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_api_pop_k Test min heap pop k function
+ * @{
+ */
+
+void check_min_heap_api_pop_k_with_null_heap(void) {
+    int out[2];
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_api_pop_k(NULL, out, 2));
+}
+void check_min_heap_api_pop_k_data(void) {
+    int items[8] = { 5, 1, 7, 3, 0, 6, 2, 4 };
+    int out[3];
+    for (int i = 0; i < 8; ++i)
+        min_heap_api_insert(&int_heap, &items[i]);
+    TEST_ASSERT_EQUAL_size_t(3U, min_heap_api_pop_k(&int_heap, out, 3));
+    TEST_ASSERT_EQUAL_INT(0, out[0]);
+    TEST_ASSERT_EQUAL_INT(1, out[1]);
+    TEST_ASSERT_EQUAL_INT(2, out[2]);
+    TEST_ASSERT_EQUAL_size_t(5U, int_heap.size);
+}
+void check_min_heap_api_pop_k_more_than_size(void) {
+    int items[3] = { 9, 8, 7 };
+    int out[5];
+    for (int i = 0; i < 3; ++i)
+        min_heap_api_insert(&int_heap, &items[i]);
+    TEST_ASSERT_EQUAL_size_t(3U, min_heap_api_pop_k(&int_heap, out, 5));
+    TEST_ASSERT_EQUAL_INT(9, out[2]);
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_api_pop_k(&int_heap, NULL, 5));
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_api_pop_with Test min heap zero-copy removal functions
+ * @{
+ */
+
+static void pop_with_collect(void *item, void *ctx) {
+    int **cursor = (int **)ctx;
+    **cursor = *(int *)item;
+    ++*cursor;
+}
+
+void check_min_heap_api_pop_with_null_pointers(void) {
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_pop_with(NULL, pop_with_collect, NULL));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_pop_with(&int_heap, NULL, NULL));
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_api_pop_k_with(&int_heap, NULL, NULL, 2));
+}
+void check_min_heap_api_pop_with_when_empty(void) {
+    int out[1];
+    int *cursor = out;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_EMPTY, min_heap_api_pop_with(&int_heap, pop_with_collect, &cursor));
+    TEST_ASSERT_EQUAL_PTR(out, cursor);
+}
+void check_min_heap_api_pop_with_data(void) {
+    int items[5] = { 4, 2, 3, 0, 1 };
+    int out[5];
+    int *cursor = out;
+    for (int i = 0; i < 5; ++i)
+        min_heap_api_insert(&int_heap, &items[i]);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_pop_with(&int_heap, pop_with_collect, &cursor));
+    TEST_ASSERT_EQUAL_INT(0, out[0]);
+    TEST_ASSERT_EQUAL_size_t(4U, int_heap.size);
+    TEST_ASSERT_EQUAL_INT(1, *(int *)min_heap_api_peek(&int_heap));
+}
+void check_min_heap_api_pop_k_with_data(void) {
+    int items[6] = { 5, 1, 4, 0, 3, 2 };
+    int out[6];
+    int *cursor = out;
+    for (int i = 0; i < 6; ++i)
+        min_heap_api_insert(&int_heap, &items[i]);
+    TEST_ASSERT_EQUAL_size_t(4U, min_heap_api_pop_k_with(&int_heap, pop_with_collect, &cursor, 4));
+    for (int i = 0; i < 4; ++i)
+        TEST_ASSERT_EQUAL_INT(i, out[i]);
+    TEST_ASSERT_EQUAL_size_t(2U, min_heap_api_pop_k_with(&int_heap, pop_with_collect, &cursor, 4));
+    TEST_ASSERT_EQUAL_INT(5, out[5]);
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_api_drain_parallel Test min heap parallel drain function
+ * @{
+ */
+
+static void drain_run_serial(void (*task)(void *arg, size_t index), void *arg, size_t count, void *ctx) {
+    size_t *calls = ctx;
+    if (calls != NULL)
+        ++*calls;
+    // The tasks run in reverse order to catch dependencies between them
+    for (size_t i = count; i > 0; --i)
+        task(arg, i - 1);
+}
+
+void check_min_heap_api_drain_parallel_with_null_pointers(void) {
+    int out[1];
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_drain_parallel(NULL, out, 2, drain_run_serial, NULL));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_drain_parallel(&int_heap, NULL, 2, drain_run_serial, NULL));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_drain_parallel(&int_heap, out, 2, NULL, NULL));
+}
+void check_min_heap_api_drain_parallel_out_of_bounds(void) {
+    int out[1];
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_api_drain_parallel(&int_heap, out, 0, drain_run_serial, NULL));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_api_drain_parallel(&int_heap, out, MIN_HEAP_DRAIN_MAX_PARTS + 1, drain_run_serial, NULL));
+}
+void check_min_heap_api_drain_parallel_like_serial(void) {
+    // Same result of the serial removal for every number of parts, with duplicates
+    const size_t n = 500;
+    MinHeapHandler_t heap, reference;
+    int expected[500], out[500];
+    size_t parts[] = { 1, 2, 3, 7, 16, 64 };
+    for (size_t p = 0; p < sizeof(parts) / sizeof(parts[0]); ++p) {
+        unsigned seed = 11;
+        size_t calls = 0;
+        min_heap_api_init(&heap, sizeof(int), n, min_heap_compare_int, &arena);
+        min_heap_api_init(&reference, sizeof(int), n, min_heap_compare_int, &arena);
+        for (size_t i = 0; i < n; ++i) {
+            seed = seed * 1103515245U + 12345U;
+            int val = (int)((seed >> 16) % 50);
+            min_heap_api_insert(&heap, &val);
+            min_heap_api_insert(&reference, &val);
+        }
+        min_heap_api_pop_k(&reference, expected, n);
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_drain_parallel(&heap, out, parts[p], drain_run_serial, &calls));
+        TEST_ASSERT_EQUAL_size_t(2U, calls);
+        TEST_ASSERT_EQUAL_INT_ARRAY(expected, out, n);
+        TEST_ASSERT_TRUE(min_heap_api_is_empty(&heap));
+    }
+}
+void check_min_heap_api_drain_parallel_more_parts_than_items(void) {
+    int items[3] = { 2, 0, 1 };
+    int out[3];
+    for (int i = 0; i < 3; ++i)
+        min_heap_api_insert(&int_heap, &items[i]);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_drain_parallel(&int_heap, out, 8, drain_run_serial, NULL));
+    for (int i = 0; i < 3; ++i)
+        TEST_ASSERT_EQUAL_INT(i, out[i]);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_drain_parallel(&int_heap, out, 8, drain_run_serial, NULL));
+}
+void check_min_heap_api_drain_parallel_stable(void) {
+    MinHeapHandler_t heap;
+    Task out[40];
+    min_heap_api_init(&heap, sizeof(Task), 40, min_heap_compare_task, &arena);
+    min_heap_api_stable_init(&heap, &arena);
+    for (int i = 0; i < 40; ++i) {
+        Task t = { .priority = (i * 7) % 3, .id = i };
+        min_heap_api_insert(&heap, &t);
+    }
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_drain_parallel(&heap, out, 5, drain_run_serial, NULL));
+
+    // Equal items keep the insertion order
+    for (int i = 1; i < 40; ++i) {
+        TEST_ASSERT_TRUE(out[i - 1].priority <= out[i].priority);
+        if (out[i - 1].priority == out[i].priority)
+            TEST_ASSERT_TRUE(out[i - 1].id < out[i].id);
+    }
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_api_handles Test min heap addressable items
+ * @{
+ */
+
+/*!
+ * \brief Check that the position of every handle points to its item
+ */
+static void handles_check(const MinHeapHandler_t *heap, int handles) {
+    for (int h = 0; h < handles; ++h) {
+        signed_size_t pos = min_heap_api_position(heap, (uint32_t)h);
+        if (pos >= 0)
+            TEST_ASSERT_EQUAL_INT(h, ((Task *)min_heap_api_at(heap, (size_t)pos))->id);
+    }
+    for (size_t i = 0; i < heap->size; ++i)
+        TEST_ASSERT_EQUAL_INT((int)i, (int)min_heap_api_position(heap, (uint32_t)((Task *)min_heap_api_at(heap, i))->id));
+}
+
+void check_min_heap_api_handles_init_errors(void) {
+    MinHeapHandler_t heap;
+    min_heap_api_init(&heap, sizeof(Task), 8, min_heap_compare_task, &arena);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_handles_init(NULL, offsetof(Task, id), 8, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_handles_init(&heap, offsetof(Task, id), 8, NULL));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_api_handles_init(&heap, offsetof(Task, id), 0, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_api_handles_init(&heap, sizeof(Task) - 2, 8, &arena));
+    TEST_ASSERT_EQUAL_INT(-1, (int)min_heap_api_position(&heap, 0));
+    TEST_ASSERT_NULL(min_heap_api_at(&heap, 0));
+}
+void check_min_heap_api_handles_positions(void) {
+    MinHeapHandler_t heap;
+    min_heap_api_init(&heap, sizeof(Task), 32, min_heap_compare_task, &arena);
+    Task items[4] = { { 5, 0 }, { 3, 1 }, { 9, 2 }, { 1, 3 } };
+    min_heap_api_insert(&heap, &items[0]);
+
+    // The items already in the heap are tracked
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_handles_init(&heap, offsetof(Task, id), 32, &arena));
+    for (int i = 1; i < 4; ++i)
+        min_heap_api_insert(&heap, &items[i]);
+    handles_check(&heap, 32);
+
+    unsigned seed = 17;
+    for (int i = 0; i < 2000; ++i) {
+        seed = seed * 1103515245U + 12345U;
+        int h = (int)((seed >> 16) % 32);
+        signed_size_t pos = min_heap_api_position(&heap, (uint32_t)h);
+        if (pos < 0) {
+            Task t = { (int)((seed >> 8) % 100), h };
+            TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_insert(&heap, &t));
+        } else if (seed & 0x400) {
+            Task t;
+            min_heap_api_remove(&heap, (size_t)pos, &t);
+            TEST_ASSERT_EQUAL_INT(h, t.id);
+            TEST_ASSERT_EQUAL_INT(-1, (int)min_heap_api_position(&heap, (uint32_t)h));
+        } else {
+            ((Task *)min_heap_api_at(&heap, (size_t)pos))->priority = (int)((seed >> 8) % 100);
+            TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_update(&heap, (size_t)pos));
+        }
+        handles_check(&heap, 32);
+    }
+
+    // The items are still in order
+    Task prev, cur;
+    min_heap_api_remove(&heap, 0, &prev);
+    while (min_heap_api_remove(&heap, 0, &cur) == MIN_HEAP_OK) {
+        TEST_ASSERT_TRUE(prev.priority <= cur.priority);
+        prev = cur;
+    }
+}
+void check_min_heap_api_handles_build(void) {
+    MinHeapHandler_t heap;
+    Task items[6] = { { 6, 0 }, { 2, 1 }, { 4, 2 }, { 1, 3 }, { 5, 4 }, { 3, 5 } };
+    min_heap_api_init(&heap, sizeof(Task), 8, min_heap_compare_task, &arena);
+    min_heap_api_handles_init(&heap, offsetof(Task, id), 8, &arena);
+    min_heap_api_build(&heap, items, 6);
+    handles_check(&heap, 8);
+    TEST_ASSERT_EQUAL_INT(0, (int)min_heap_api_position(&heap, 3));
+}
+void check_min_heap_api_update_errors(void) {
+    int a = 1;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_api_update(NULL, 0));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_api_update(&int_heap, 0));
+    min_heap_api_insert(&int_heap, &a);
+    min_heap_api_txn_init(&int_heap, &arena);
+    min_heap_api_txn_begin(&int_heap);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_INVALID_STATE, min_heap_api_update(&int_heap, 0));
+}
+void check_min_heap_api_update_increase_top(void) {
+    int items[7] = { 1, 2, 3, 4, 5, 6, 7 };
+    for (int i = 0; i < 7; ++i)
+        min_heap_api_insert(&int_heap, &items[i]);
+    *(int *)min_heap_api_peek(&int_heap) = 10;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_update(&int_heap, 0));
+    TEST_ASSERT_EQUAL_INT(2, *(int *)min_heap_api_peek(&int_heap));
+    *(int *)min_heap_api_at(&int_heap, int_heap.size - 1) = 0;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_update(&int_heap, int_heap.size - 1));
+    TEST_ASSERT_EQUAL_INT(0, *(int *)min_heap_api_peek(&int_heap));
+}
+void check_min_heap_api_handles_rollback(void) {
+    MinHeapHandler_t heap;
+    min_heap_api_init(&heap, sizeof(Task), 16, min_heap_compare_task, &arena);
+    min_heap_api_handles_init(&heap, offsetof(Task, id), 16, &arena);
+    min_heap_api_txn_init(&heap, &arena);
+    for (int i = 0; i < 8; ++i) {
+        Task t = { 8 - i, i };
+        min_heap_api_insert(&heap, &t);
+    }
+    min_heap_api_txn_begin(&heap);
+    min_heap_api_remove(&heap, 0, NULL);
+    min_heap_api_remove(&heap, 3, NULL);
+    Task t = { 0, 12 };
+    min_heap_api_insert(&heap, &t);
+    min_heap_api_txn_rollback(&heap);
+    handles_check(&heap, 16);
+    TEST_ASSERT_EQUAL_INT(-1, (int)min_heap_api_position(&heap, 12));
+    TEST_ASSERT_EQUAL_INT(0, (int)min_heap_api_position(&heap, 7));
+}
+
+/*! @} */
+
 int main() {
     UNITY_BEGIN();
 
@@ -587,6 +1735,7 @@ int main() {
     RUN_TEST(check_min_heap_api_init_with_null_arena);
     RUN_TEST(check_min_heap_api_init_with_null_callback);
     RUN_TEST(check_min_heap_api_init);
+    RUN_TEST(check_min_heap_api_init_extension);
 
     /*! @} */
 
@@ -714,5 +1863,198 @@ int main() {
 
     /*! @} */
 
+    /*!
+     * \addtogroup min_heap_api_complexity Run test for the number of comparisons of the min heap functions
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_api_insert_comparisons);
+    RUN_TEST(check_min_heap_api_insert_decreasing_comparisons);
+    RUN_TEST(check_min_heap_api_remove_top_comparisons);
+    RUN_TEST(check_min_heap_api_remove_any_comparisons);
+    RUN_TEST(check_min_heap_api_remove_top_order);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_api_remove_by_value Run test for min heap remove by value function
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_api_remove_by_value_with_null_heap);
+    RUN_TEST(check_min_heap_api_remove_by_value_with_null_item);
+    RUN_TEST(check_min_heap_api_remove_by_value_not_found);
+    RUN_TEST(check_min_heap_api_remove_by_value_data);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_api_bloom_init Run test for min heap Bloom filter
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_api_bloom_init_with_null_heap);
+    RUN_TEST(check_min_heap_api_bloom_init_with_null_hash);
+    RUN_TEST(check_min_heap_api_bloom_init_with_zero_counters);
+    RUN_TEST(check_min_heap_api_bloom_init_existing_items);
+    RUN_TEST(check_min_heap_api_bloom_find_after_remove);
+    RUN_TEST(check_min_heap_api_bloom_skip_scan);
+    RUN_TEST(check_min_heap_api_bloom_clear);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_api_stable_init Run test for min heap stable mode
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_api_stable_init_with_null_heap);
+    RUN_TEST(check_min_heap_api_stable_init_with_null_arena);
+    RUN_TEST(check_min_heap_api_stable_fifo_order);
+    RUN_TEST(check_min_heap_api_stable_fifo_after_remove);
+    RUN_TEST(check_min_heap_api_stable_sequence_wrap);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_api_select Run test for select and partial sort functions
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_api_select_with_null_array);
+    RUN_TEST(check_min_heap_api_select_with_null_out);
+    RUN_TEST(check_min_heap_api_select_out_of_bounds);
+    RUN_TEST(check_min_heap_api_select_data);
+    RUN_TEST(check_min_heap_api_select_all);
+    RUN_TEST(check_min_heap_api_select_comparisons);
+    RUN_TEST(check_min_heap_api_partial_sort_data);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_api_collect_below Run test for min heap collect below function
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_api_collect_below_with_null_heap);
+    RUN_TEST(check_min_heap_api_collect_below_when_empty);
+    RUN_TEST(check_min_heap_api_collect_below_none);
+    RUN_TEST(check_min_heap_api_collect_below_data);
+    RUN_TEST(check_min_heap_api_collect_below_max);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_api_txn Run test for min heap transactions
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_api_txn_begin_not_enabled);
+    RUN_TEST(check_min_heap_api_txn_begin_twice);
+    RUN_TEST(check_min_heap_api_txn_commit_without_begin);
+    RUN_TEST(check_min_heap_api_txn_commit_data);
+    RUN_TEST(check_min_heap_api_txn_rollback_data);
+    RUN_TEST(check_min_heap_api_txn_rollback_clear);
+    RUN_TEST(check_min_heap_api_txn_rollback_bloom);
+    RUN_TEST(check_min_heap_api_txn_rollback_stable);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_api_init_keys Run test for min heap lexicographic key specification
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_api_init_keys_with_null_pointers);
+    RUN_TEST(check_min_heap_api_init_keys_invalid);
+    RUN_TEST(check_min_heap_api_init_keys_out_of_item);
+    RUN_TEST(check_min_heap_api_init_keys_ok);
+    RUN_TEST(check_min_heap_api_init_keys_order);
+    RUN_TEST(check_min_heap_api_init_keys_single_field);
+    RUN_TEST(check_min_heap_api_init_keys_types);
+    RUN_TEST(check_min_heap_api_init_keys_compare);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_api_build Run test for min heap bulk build function
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_api_build_with_null_pointers);
+    RUN_TEST(check_min_heap_api_build_too_many);
+    RUN_TEST(check_min_heap_api_build_data);
+    RUN_TEST(check_min_heap_api_build_in_place);
+    RUN_TEST(check_min_heap_api_build_keys);
+    RUN_TEST(check_min_heap_api_build_simd_scalar);
+    RUN_TEST(check_min_heap_api_build_keys_desc_unsigned);
+    RUN_TEST(check_min_heap_api_build_rollback);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_api_build_radix Run test for min heap radix sort bulk build function
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_api_build_radix_with_null_pointers);
+    RUN_TEST(check_min_heap_api_build_radix_without_keys);
+    RUN_TEST(check_min_heap_api_build_radix_too_many);
+    RUN_TEST(check_min_heap_api_build_radix_sorted);
+    RUN_TEST(check_min_heap_api_build_radix_fields);
+    RUN_TEST(check_min_heap_api_build_radix_stable);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_api_pop_k Run test for min heap pop k function
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_api_pop_k_with_null_heap);
+    RUN_TEST(check_min_heap_api_pop_k_data);
+    RUN_TEST(check_min_heap_api_pop_k_more_than_size);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_api_pop_with Run test for min heap zero-copy removal functions
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_api_pop_with_null_pointers);
+    RUN_TEST(check_min_heap_api_pop_with_when_empty);
+    RUN_TEST(check_min_heap_api_pop_with_data);
+    RUN_TEST(check_min_heap_api_pop_k_with_data);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_api_drain_parallel Run test for min heap parallel drain function
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_api_drain_parallel_with_null_pointers);
+    RUN_TEST(check_min_heap_api_drain_parallel_out_of_bounds);
+    RUN_TEST(check_min_heap_api_drain_parallel_like_serial);
+    RUN_TEST(check_min_heap_api_drain_parallel_more_parts_than_items);
+    RUN_TEST(check_min_heap_api_drain_parallel_stable);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_api_handles Run test for min heap addressable items
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_api_handles_init_errors);
+    RUN_TEST(check_min_heap_api_handles_positions);
+    RUN_TEST(check_min_heap_api_handles_build);
+    RUN_TEST(check_min_heap_api_update_errors);
+    RUN_TEST(check_min_heap_api_update_increase_top);
+    RUN_TEST(check_min_heap_api_handles_rollback);
+
+    /*! @} */
+
     UNITY_END();
 }
@@ -0,0 +1,227 @@
+/*!
+ * \file test-min-heap-cache-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Tests of the cache with cost-aware eviction
+ */
+
+#include "unity.h"
+#include "min-heap-cache-api.h"
+
+MinHeapCacheHandler_t lfu;
+MinHeapCacheHandler_t gd;
+ArenaAllocatorHandler_t arena;
+
+void setUp(void) {
+    arena_allocator_api_init(&arena);
+    min_heap_cache_api_init(&lfu, MIN_HEAP_CACHE_LFU, 4, sizeof(int), &arena);
+    min_heap_cache_api_init(&gd, MIN_HEAP_CACHE_GREEDY_DUAL, 4, sizeof(int), &arena);
+}
+
+void tearDown(void) {
+    arena_allocator_api_free(&arena);
+}
+
+/*!
+ * \brief Insert an entry whose value is the key and return the evicted key or -1
+ */
+static int put_key(MinHeapCacheHandler_t *cache, int key, uint32_t cost) {
+    bool evicted;
+    uint64_t evicted_key;
+    int evicted_value = -1;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_cache_api_put(cache, (uint64_t)key, cost, &key, &evicted, &evicted_key, &evicted_value));
+    if (!evicted)
+        return -1;
+    TEST_ASSERT_EQUAL_INT((int)evicted_key, evicted_value);
+    return evicted_value;
+}
+
+/*!
+ * \defgroup min_heap_cache_api_init Test cache initialization
+ * @{
+ */
+
+void check_min_heap_cache_api_init_with_null_pointers(void) {
+    MinHeapCacheHandler_t c;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_cache_api_init(NULL, MIN_HEAP_CACHE_LFU, 4, 0, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_cache_api_init(&c, MIN_HEAP_CACHE_LFU, 4, 0, NULL));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_cache_api_put(&lfu, 1, 1, NULL, NULL, NULL, NULL));
+}
+void check_min_heap_cache_api_init_out_of_bounds(void) {
+    MinHeapCacheHandler_t c;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_cache_api_init(&c, MIN_HEAP_CACHE_LFU, 0, 0, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_cache_api_init(&c, (MinHeapCachePolicy)7, 4, 0, &arena));
+}
+void check_min_heap_cache_api_init_empty(void) {
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_cache_api_size(&lfu));
+    TEST_ASSERT_NULL(min_heap_cache_api_get(&lfu, 3));
+    TEST_ASSERT_EQUAL_size_t(1U, lfu.misses);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NOT_FOUND, min_heap_cache_api_remove(&lfu, 3, NULL));
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_cache_api_put Test cache lookup, insertion and eviction
+ * @{
+ */
+
+void check_min_heap_cache_api_get_put(void) {
+    for (int i = 0; i < 4; ++i)
+        TEST_ASSERT_EQUAL_INT(-1, put_key(&lfu, i, 1));
+    TEST_ASSERT_EQUAL_size_t(4U, min_heap_cache_api_size(&lfu));
+    for (int i = 0; i < 4; ++i) {
+        int *value = min_heap_cache_api_get(&lfu, (uint64_t)i);
+        TEST_ASSERT_NOT_NULL(value);
+        TEST_ASSERT_EQUAL_INT(i, *value);
+    }
+    TEST_ASSERT_EQUAL_size_t(4U, lfu.hits);
+
+    // Replacing the value of an entry does not insert it again
+    int value = 42;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_cache_api_put(&lfu, 2, 1, &value, NULL, NULL, NULL));
+    TEST_ASSERT_EQUAL_size_t(4U, min_heap_cache_api_size(&lfu));
+    TEST_ASSERT_EQUAL_INT(42, *(int *)min_heap_cache_api_get(&lfu, 2));
+}
+void check_min_heap_cache_api_lfu_eviction(void) {
+    for (int i = 0; i < 4; ++i)
+        put_key(&lfu, i, 1);
+    // Key 2 is the least frequently used one
+    for (int r = 0; r < 3; ++r) {
+        min_heap_cache_api_get(&lfu, 0);
+        min_heap_cache_api_get(&lfu, 1);
+        min_heap_cache_api_get(&lfu, 3);
+    }
+    TEST_ASSERT_EQUAL_INT(2, put_key(&lfu, 4, 1));
+    TEST_ASSERT_NULL(min_heap_cache_api_get(&lfu, 2));
+    TEST_ASSERT_EQUAL_size_t(4U, min_heap_cache_api_size(&lfu));
+}
+void check_min_heap_cache_api_lru_ties(void) {
+    // Among the entries with the same priority the least recently used one is evicted
+    for (int i = 0; i < 4; ++i)
+        put_key(&gd, i, 5);
+    min_heap_cache_api_get(&gd, 0);
+    min_heap_cache_api_get(&gd, 1);
+    TEST_ASSERT_EQUAL_INT(2, put_key(&gd, 4, 5));
+    TEST_ASSERT_EQUAL_INT(3, put_key(&gd, 5, 5));
+    TEST_ASSERT_EQUAL_INT(0, put_key(&gd, 6, 5));
+}
+void check_min_heap_cache_api_greedy_dual_cost(void) {
+    // The cheap entries are evicted first
+    put_key(&gd, 0, 100);
+    put_key(&gd, 1, 1);
+    put_key(&gd, 2, 50);
+    put_key(&gd, 3, 2);
+    TEST_ASSERT_EQUAL_INT(1, put_key(&gd, 4, 10));
+    TEST_ASSERT_EQUAL_UINT64(1U, gd.inflation);
+    TEST_ASSERT_EQUAL_INT(3, put_key(&gd, 5, 10));
+    TEST_ASSERT_EQUAL_INT(4, put_key(&gd, 6, 10));
+}
+void check_min_heap_cache_api_greedy_dual_aging(void) {
+    // An expensive entry that is not used anymore is evicted once the inflation reaches it
+    put_key(&gd, 0, 30);
+    int evicted_expensive = -1;
+    for (int i = 1; i < 40 && evicted_expensive < 0; ++i) {
+        if (put_key(&gd, i, 10) == 0)
+            evicted_expensive = i;
+    }
+    TEST_ASSERT_TRUE(evicted_expensive > 0);
+    TEST_ASSERT_NULL(min_heap_cache_api_get(&gd, 0));
+}
+void check_min_heap_cache_api_get_empty_value(void) {
+    MinHeapCacheHandler_t keys;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_cache_api_init(&keys, MIN_HEAP_CACHE_LFU, 4, 0, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_cache_api_put(&keys, 5, 1, NULL, NULL, NULL, NULL));
+
+    // A hit returns the sentinel instead of a pointer inside the cache
+    TEST_ASSERT_EQUAL_PTR(MIN_HEAP_CACHE_HIT, min_heap_cache_api_get(&keys, 5));
+    TEST_ASSERT_NULL(min_heap_cache_api_get(&keys, 6));
+    TEST_ASSERT_EQUAL_size_t(1U, keys.hits);
+    TEST_ASSERT_EQUAL_size_t(1U, keys.misses);
+}
+void check_min_heap_cache_api_remove(void) {
+    for (int i = 0; i < 4; ++i)
+        put_key(&lfu, i, 1);
+    int value = -1;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_cache_api_remove(&lfu, 1, &value));
+    TEST_ASSERT_EQUAL_INT(1, value);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NOT_FOUND, min_heap_cache_api_remove(&lfu, 1, &value));
+    TEST_ASSERT_EQUAL_size_t(3U, min_heap_cache_api_size(&lfu));
+
+    // The free entry is reused before anything is evicted
+    TEST_ASSERT_EQUAL_INT(-1, put_key(&lfu, 9, 1));
+    TEST_ASSERT_NOT_NULL(min_heap_cache_api_get(&lfu, 9));
+    TEST_ASSERT_NULL(min_heap_cache_api_get(&lfu, 1));
+    TEST_ASSERT_EQUAL_size_t(4U, min_heap_cache_api_size(&lfu));
+}
+void check_min_heap_cache_api_random_model(void) {
+    // The cache always contains the keys that were inserted and not evicted or removed
+    MinHeapCacheHandler_t c;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_cache_api_init(&c, MIN_HEAP_CACHE_GREEDY_DUAL_FREQUENCY, 32, sizeof(int), &arena));
+    bool present[128] = { false };
+    size_t count = 0;
+    unsigned seed = 5;
+    for (int i = 0; i < 20000; ++i) {
+        seed = seed * 1103515245U + 12345U;
+        int key = (int)((seed >> 16) % 128);
+        unsigned op = (seed >> 8) % 8;
+        if (op == 0) {
+            MinHeapReturnCode res = min_heap_cache_api_remove(&c, (uint64_t)key, NULL);
+            TEST_ASSERT_EQUAL_INT(present[key] ? MIN_HEAP_OK : MIN_HEAP_NOT_FOUND, res);
+            count -= present[key] ? 1 : 0;
+            present[key] = false;
+        } else if (op < 4) {
+            int evicted = put_key(&c, key, 1 + (seed >> 24) % 16);
+            if (evicted >= 0) {
+                TEST_ASSERT_TRUE(present[evicted]);
+                present[evicted] = false;
+                --count;
+            }
+            count += present[key] ? 0 : 1;
+            present[key] = true;
+        } else {
+            int *value = min_heap_cache_api_get(&c, (uint64_t)key);
+            TEST_ASSERT_EQUAL_INT(present[key], value != NULL);
+            if (value != NULL)
+                TEST_ASSERT_EQUAL_INT(key, *value);
+        }
+        TEST_ASSERT_EQUAL_size_t(count, min_heap_cache_api_size(&c));
+    }
+}
+
+/*! @} */
+
+int main() {
+    UNITY_BEGIN();
+
+    /*!
+     * \addtogroup min_heap_cache_api_init Run test for cache initialization
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_cache_api_init_with_null_pointers);
+    RUN_TEST(check_min_heap_cache_api_init_out_of_bounds);
+    RUN_TEST(check_min_heap_cache_api_init_empty);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_cache_api_put Run test for cache lookup, insertion and eviction
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_cache_api_get_put);
+    RUN_TEST(check_min_heap_cache_api_lfu_eviction);
+    RUN_TEST(check_min_heap_cache_api_lru_ties);
+    RUN_TEST(check_min_heap_cache_api_greedy_dual_cost);
+    RUN_TEST(check_min_heap_cache_api_greedy_dual_aging);
+    RUN_TEST(check_min_heap_cache_api_get_empty_value);
+    RUN_TEST(check_min_heap_cache_api_remove);
+    RUN_TEST(check_min_heap_cache_api_random_model);
+
+    /*! @} */
+
+    UNITY_END();
+}
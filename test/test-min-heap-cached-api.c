@@ -0,0 +1,164 @@
+/*!
+ * \file test-min-heap-cached-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Tests of the min heap with a cache of its smallest items
+ */
+
+#include "unity.h"
+#include "min-heap-api.h"
+#include "min-heap-cached-api.h"
+
+int8_t min_heap_compare_int(void *f, void *s) {
+    int a = *(int *)f;
+    int b = *(int *)s;
+    if (a < b)
+        return -1;
+    return a == b ? 0 : 1;
+}
+
+MinHeapCachedHandler_t cached;
+ArenaAllocatorHandler_t arena;
+
+void setUp(void) {
+    arena_allocator_api_init(&arena);
+    min_heap_cached_api_init(&cached, sizeof(int), 64, 4, min_heap_compare_int, &arena);
+}
+
+void tearDown(void) {
+    arena_allocator_api_free(&arena);
+}
+
+/*!
+ * \defgroup min_heap_cached_api_init Test cached heap initialization
+ * @{
+ */
+
+void check_min_heap_cached_api_init_with_null_pointers(void) {
+    MinHeapCachedHandler_t c;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_cached_api_init(NULL, sizeof(int), 8, 4, min_heap_compare_int, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_cached_api_init(&c, sizeof(int), 8, 4, NULL, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_cached_api_init(&c, sizeof(int), 8, 4, min_heap_compare_int, NULL));
+}
+void check_min_heap_cached_api_init_without_cache(void) {
+    MinHeapCachedHandler_t c;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_cached_api_init(&c, sizeof(int), 8, 0, min_heap_compare_int, &arena));
+}
+void check_min_heap_cached_api_init_empty(void) {
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_cached_api_size(&cached));
+    TEST_ASSERT_NULL(min_heap_cached_api_peek(&cached));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_EMPTY, min_heap_cached_api_pop(&cached, NULL));
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_cached_api_pop Test cached heap insertion and removal
+ * @{
+ */
+
+void check_min_heap_cached_api_pop_refill(void) {
+    for (int i = 9; i >= 0; --i)
+        min_heap_cached_api_insert(&cached, &i);
+    int out;
+    min_heap_cached_api_pop(&cached, &out);
+    TEST_ASSERT_EQUAL_INT(0, out);
+    TEST_ASSERT_EQUAL_size_t(3U, cached.cache_size);
+    TEST_ASSERT_EQUAL_size_t(6U, cached.heap.size);
+    TEST_ASSERT_EQUAL_INT(1, *(int *)min_heap_cached_api_peek(&cached));
+}
+void check_min_heap_cached_api_insert_in_cache(void) {
+    for (int i = 10; i < 20; ++i)
+        min_heap_cached_api_insert(&cached, &i);
+    min_heap_cached_api_pop(&cached, NULL);
+
+    // Lower than the maximum of the cache (13)
+    int a = 5;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_cached_api_insert(&cached, &a));
+    TEST_ASSERT_EQUAL_size_t(4U, cached.cache_size);
+    TEST_ASSERT_EQUAL_INT(5, *(int *)min_heap_cached_api_peek(&cached));
+
+    // The cache is full, its maximum moves to the heap
+    int b = 12;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_cached_api_insert(&cached, &b));
+    TEST_ASSERT_EQUAL_size_t(4U, cached.cache_size);
+    TEST_ASSERT_EQUAL_INT(13, *(int *)min_heap_api_peek(&cached.heap));
+    TEST_ASSERT_EQUAL_size_t(11U, min_heap_cached_api_size(&cached));
+}
+void check_min_heap_cached_api_pop_random(void) {
+    // Compare a random sequence of operations with a plain heap
+    MinHeapHandler_t reference;
+    unsigned seed = 7;
+    min_heap_api_init(&reference, sizeof(int), 64, min_heap_compare_int, &arena);
+    for (int i = 0; i < 2000; ++i) {
+        seed = seed * 1103515245U + 12345U;
+        int val = (int)((seed >> 16) % 100);
+        if ((seed & 0x300) != 0 && reference.size < 64) {
+            TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_cached_api_insert(&cached, &val));
+            min_heap_api_insert(&reference, &val);
+        } else if (reference.size > 0) {
+            int expected, out;
+            min_heap_api_remove(&reference, 0, &expected);
+            TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_cached_api_pop(&cached, &out));
+            TEST_ASSERT_EQUAL_INT(expected, out);
+        }
+        TEST_ASSERT_EQUAL_size_t(reference.size, min_heap_cached_api_size(&cached));
+    }
+}
+void check_min_heap_cached_api_insert_full(void) {
+    for (int i = 0; i < 64; ++i)
+        min_heap_cached_api_insert(&cached, &i);
+    min_heap_cached_api_pop(&cached, NULL);
+
+    for (int i = 64; i < 68; ++i)
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_cached_api_insert(&cached, &i));
+    int a = 0;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_cached_api_insert(&cached, &a));
+
+    // The cache is full and its maximum cannot be moved to the full heap
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_FULL, min_heap_cached_api_insert(&cached, &a));
+    TEST_ASSERT_EQUAL_size_t(68U, min_heap_cached_api_size(&cached));
+    TEST_ASSERT_EQUAL_INT(0, *(int *)min_heap_cached_api_peek(&cached));
+}
+void check_min_heap_cached_api_clear(void) {
+    int a = 3;
+    min_heap_cached_api_insert(&cached, &a);
+    min_heap_cached_api_pop(&cached, NULL);
+    min_heap_cached_api_insert(&cached, &a);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_cached_api_clear(&cached));
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_cached_api_size(&cached));
+}
+
+/*! @} */
+
+int main() {
+    UNITY_BEGIN();
+
+    /*!
+     * \addtogroup min_heap_cached_api_init Run test for cached heap initialization
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_cached_api_init_with_null_pointers);
+    RUN_TEST(check_min_heap_cached_api_init_without_cache);
+    RUN_TEST(check_min_heap_cached_api_init_empty);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_cached_api_pop Run test for cached heap insertion and removal
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_cached_api_pop_refill);
+    RUN_TEST(check_min_heap_cached_api_insert_in_cache);
+    RUN_TEST(check_min_heap_cached_api_pop_random);
+    RUN_TEST(check_min_heap_cached_api_insert_full);
+    RUN_TEST(check_min_heap_cached_api_clear);
+
+    /*! @} */
+
+    UNITY_END();
+}
@@ -0,0 +1,172 @@
+/*!
+ * \file test-min-heap-hybrid-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Tests of the priority queue for nearly sorted input
+ */
+
+#include "unity.h"
+#include "min-heap-api.h"
+#include "min-heap-hybrid-api.h"
+
+int8_t min_heap_compare_int(void *f, void *s) {
+    int a = *(int *)f;
+    int b = *(int *)s;
+    if (a < b)
+        return -1;
+    return a == b ? 0 : 1;
+}
+
+MinHeapHybridHandler_t hybrid;
+ArenaAllocatorHandler_t arena;
+
+void setUp(void) {
+    arena_allocator_api_init(&arena);
+    min_heap_hybrid_api_init(&hybrid, sizeof(int), 8, 8, min_heap_compare_int, &arena);
+}
+
+void tearDown(void) {
+    arena_allocator_api_free(&arena);
+}
+
+/*!
+ * \defgroup min_heap_hybrid_api_init Test hybrid queue initialization
+ * @{
+ */
+
+void check_min_heap_hybrid_api_init_with_null_pointers(void) {
+    MinHeapHybridHandler_t h;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_hybrid_api_init(NULL, sizeof(int), 8, 8, min_heap_compare_int, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_hybrid_api_init(&h, sizeof(int), 8, 8, NULL, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_hybrid_api_init(&h, sizeof(int), 8, 8, min_heap_compare_int, NULL));
+}
+void check_min_heap_hybrid_api_init_without_run(void) {
+    MinHeapHybridHandler_t h;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_hybrid_api_init(&h, sizeof(int), 0, 8, min_heap_compare_int, &arena));
+}
+void check_min_heap_hybrid_api_init_empty(void) {
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_hybrid_api_size(&hybrid));
+    TEST_ASSERT_NULL(min_heap_hybrid_api_peek(&hybrid));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_EMPTY, min_heap_hybrid_api_pop(&hybrid, NULL));
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_hybrid_api_insert Test hybrid queue insertion
+ * @{
+ */
+
+void check_min_heap_hybrid_api_insert_in_order(void) {
+    for (int i = 0; i < 8; ++i)
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_hybrid_api_insert(&hybrid, &i));
+    TEST_ASSERT_EQUAL_size_t(8U, hybrid.run_size);
+    TEST_ASSERT_EQUAL_size_t(0U, hybrid.heap.size);
+}
+void check_min_heap_hybrid_api_insert_straggler(void) {
+    int a = 10, b = 20, c = 15;
+    min_heap_hybrid_api_insert(&hybrid, &a);
+    min_heap_hybrid_api_insert(&hybrid, &b);
+    min_heap_hybrid_api_insert(&hybrid, &c);
+    TEST_ASSERT_EQUAL_size_t(2U, hybrid.run_size);
+    TEST_ASSERT_EQUAL_size_t(1U, hybrid.heap.size);
+    TEST_ASSERT_EQUAL_size_t(3U, min_heap_hybrid_api_size(&hybrid));
+}
+void check_min_heap_hybrid_api_insert_full(void) {
+    // The last 8 items are all stragglers
+    for (int i = 100; i < 108; ++i)
+        min_heap_hybrid_api_insert(&hybrid, &i);
+    for (int i = 0; i < 8; ++i)
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_hybrid_api_insert(&hybrid, &i));
+    int a = 1000;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_FULL, min_heap_hybrid_api_insert(&hybrid, &a));
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_hybrid_api_pop Test hybrid queue removal
+ * @{
+ */
+
+void check_min_heap_hybrid_api_pop_order(void) {
+    int input[14] = { 1, 2, 4, 3, 5, 7, 6, 8, 9, 0, 10, 12, 11, 13 };
+    for (int i = 0; i < 14; ++i)
+        min_heap_hybrid_api_insert(&hybrid, &input[i]);
+    for (int i = 0; i < 14; ++i) {
+        int out;
+        TEST_ASSERT_EQUAL_INT(i, *(int *)min_heap_hybrid_api_peek(&hybrid));
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_hybrid_api_pop(&hybrid, &out));
+        TEST_ASSERT_EQUAL_INT(i, out);
+    }
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_hybrid_api_size(&hybrid));
+}
+void check_min_heap_hybrid_api_pop_interleaved(void) {
+    // The ring buffer wraps around while items are inserted and removed
+    int next = 0;
+    for (int round = 0; round < 12; ++round) {
+        for (int i = 0; i < 5; ++i, ++next) {
+            int val = (next % 7 == 3) ? next - 2 : next;
+            TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_hybrid_api_insert(&hybrid, &val));
+        }
+        int prev = -1;
+        for (int i = 0; i < 4; ++i) {
+            int out;
+            min_heap_hybrid_api_pop(&hybrid, &out);
+            TEST_ASSERT_GREATER_OR_EQUAL_INT(prev, out);
+            prev = out;
+        }
+    }
+    TEST_ASSERT_EQUAL_size_t(12U, min_heap_hybrid_api_size(&hybrid));
+}
+void check_min_heap_hybrid_api_clear(void) {
+    int a = 3, b = 1;
+    min_heap_hybrid_api_insert(&hybrid, &a);
+    min_heap_hybrid_api_insert(&hybrid, &b);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_hybrid_api_clear(&hybrid));
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_hybrid_api_size(&hybrid));
+    TEST_ASSERT_NULL(min_heap_hybrid_api_peek(&hybrid));
+}
+
+/*! @} */
+
+int main() {
+    UNITY_BEGIN();
+
+    /*!
+     * \addtogroup min_heap_hybrid_api_init Run test for hybrid queue initialization
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_hybrid_api_init_with_null_pointers);
+    RUN_TEST(check_min_heap_hybrid_api_init_without_run);
+    RUN_TEST(check_min_heap_hybrid_api_init_empty);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_hybrid_api_insert Run test for hybrid queue insertion
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_hybrid_api_insert_in_order);
+    RUN_TEST(check_min_heap_hybrid_api_insert_straggler);
+    RUN_TEST(check_min_heap_hybrid_api_insert_full);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_hybrid_api_pop Run test for hybrid queue removal
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_hybrid_api_pop_order);
+    RUN_TEST(check_min_heap_hybrid_api_pop_interleaved);
+    RUN_TEST(check_min_heap_hybrid_api_clear);
+
+    /*! @} */
+
+    UNITY_END();
+}
@@ -0,0 +1,193 @@
+/*!
+ * \file test-min-heap-persistent-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Tests of the persistent min heap
+ */
+
+#include "unity.h"
+#include "min-heap-persistent-api.h"
+
+int8_t min_heap_compare_int(void *f, void *s) {
+    int a = *(int *)f;
+    int b = *(int *)s;
+    if (a < b)
+        return -1;
+    return a == b ? 0 : 1;
+}
+
+MinHeapPersistentHandler_t heap;
+ArenaAllocatorHandler_t arena;
+
+void setUp(void) {
+    arena_allocator_api_init(&arena);
+    min_heap_persistent_api_init(&heap, sizeof(int), min_heap_compare_int, &arena);
+}
+
+void tearDown(void) {
+    arena_allocator_api_free(&arena);
+}
+
+static MinHeapPersistent_t build(const int *items, size_t count) {
+    MinHeapPersistent_t version = NULL;
+    for (size_t i = 0; i < count; ++i)
+        min_heap_persistent_api_insert(&heap, version, (void *)&items[i], &version);
+    return version;
+}
+
+static void assert_sorted(MinHeapPersistent_t version, const int *expected, size_t count) {
+    TEST_ASSERT_EQUAL_size_t(count, min_heap_persistent_api_size(version));
+    for (size_t i = 0; i < count; ++i) {
+        int val;
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_persistent_api_pop(&heap, version, &val, &version));
+        TEST_ASSERT_EQUAL_INT(expected[i], val);
+    }
+    TEST_ASSERT_NULL(version);
+}
+
+/*!
+ * \defgroup min_heap_persistent_api_init Test persistent heap initialization
+ * @{
+ */
+
+void check_min_heap_persistent_api_init_with_null_handler(void) {
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_persistent_api_init(NULL, sizeof(int), min_heap_compare_int, &arena));
+}
+void check_min_heap_persistent_api_init_with_null_callback(void) {
+    MinHeapPersistentHandler_t h;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_persistent_api_init(&h, sizeof(int), NULL, &arena));
+}
+void check_min_heap_persistent_api_init_with_null_arena(void) {
+    MinHeapPersistentHandler_t h;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_persistent_api_init(&h, sizeof(int), min_heap_compare_int, NULL));
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_persistent_api_insert Test persistent heap insert and pop
+ * @{
+ */
+
+void check_min_heap_persistent_api_empty(void) {
+    MinHeapPersistent_t out;
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_persistent_api_size(NULL));
+    TEST_ASSERT_NULL(min_heap_persistent_api_peek(NULL));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_EMPTY, min_heap_persistent_api_pop(&heap, NULL, NULL, &out));
+}
+void check_min_heap_persistent_api_insert_with_null_item(void) {
+    MinHeapPersistent_t out;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_persistent_api_insert(&heap, NULL, NULL, &out));
+}
+void check_min_heap_persistent_api_insert_peek(void) {
+    int items[5] = { 7, 3, 9, 1, 5 };
+    MinHeapPersistent_t version = build(items, 5);
+    TEST_ASSERT_EQUAL_INT(1, *(const int *)min_heap_persistent_api_peek(version));
+    TEST_ASSERT_EQUAL_size_t(5U, min_heap_persistent_api_size(version));
+}
+void check_min_heap_persistent_api_pop_order(void) {
+    int items[8] = { 4, 8, 1, 6, 3, 7, 2, 5 };
+    int expected[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    assert_sorted(build(items, 8), expected, 8);
+}
+void check_min_heap_persistent_api_versions_are_immutable(void) {
+    int items[4] = { 4, 2, 6, 8 };
+    MinHeapPersistent_t base = build(items, 4);
+    MinHeapPersistent_t branch_a, branch_b;
+    int a = 1, b = 5;
+    min_heap_persistent_api_insert(&heap, base, &a, &branch_a);
+    min_heap_persistent_api_insert(&heap, base, &b, &branch_b);
+    MinHeapPersistent_t popped;
+    min_heap_persistent_api_pop(&heap, base, NULL, &popped);
+
+    int expected_base[4] = { 2, 4, 6, 8 };
+    int expected_a[5] = { 1, 2, 4, 6, 8 };
+    int expected_b[5] = { 2, 4, 5, 6, 8 };
+    int expected_popped[3] = { 4, 6, 8 };
+    assert_sorted(branch_a, expected_a, 5);
+    assert_sorted(branch_b, expected_b, 5);
+    assert_sorted(popped, expected_popped, 3);
+    assert_sorted(base, expected_base, 4);
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_persistent_api_meld Test persistent heap meld
+ * @{
+ */
+
+void check_min_heap_persistent_api_meld_with_empty(void) {
+    int items[3] = { 3, 1, 2 };
+    MinHeapPersistent_t version = build(items, 3);
+    MinHeapPersistent_t out;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_persistent_api_meld(&heap, version, NULL, &out));
+    TEST_ASSERT_EQUAL_PTR(version, out);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_persistent_api_meld(&heap, NULL, NULL, &out));
+    TEST_ASSERT_NULL(out);
+}
+void check_min_heap_persistent_api_meld_data(void) {
+    int items_a[4] = { 10, 4, 6, 2 };
+    int items_b[4] = { 5, 1, 9, 3 };
+    MinHeapPersistent_t a = build(items_a, 4);
+    MinHeapPersistent_t b = build(items_b, 4);
+    MinHeapPersistent_t out;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_persistent_api_meld(&heap, a, b, &out));
+
+    int expected[8] = { 1, 2, 3, 4, 5, 6, 9, 10 };
+    int expected_a[4] = { 2, 4, 6, 10 };
+    assert_sorted(out, expected, 8);
+    assert_sorted(a, expected_a, 4);
+}
+void check_min_heap_persistent_api_rank(void) {
+    // The right spine of a leftist heap is at most log2(n + 1) long
+    MinHeapPersistent_t version = NULL;
+    for (int i = 1000; i > 0; --i)
+        min_heap_persistent_api_insert(&heap, version, &i, &version);
+    TEST_ASSERT_LESS_OR_EQUAL_size_t(9U, version->rank);
+}
+
+/*! @} */
+
+int main() {
+    UNITY_BEGIN();
+
+    /*!
+     * \addtogroup min_heap_persistent_api_init Run test for persistent heap initialization
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_persistent_api_init_with_null_handler);
+    RUN_TEST(check_min_heap_persistent_api_init_with_null_callback);
+    RUN_TEST(check_min_heap_persistent_api_init_with_null_arena);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_persistent_api_insert Run test for persistent heap insert and pop
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_persistent_api_empty);
+    RUN_TEST(check_min_heap_persistent_api_insert_with_null_item);
+    RUN_TEST(check_min_heap_persistent_api_insert_peek);
+    RUN_TEST(check_min_heap_persistent_api_pop_order);
+    RUN_TEST(check_min_heap_persistent_api_versions_are_immutable);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_persistent_api_meld Run test for persistent heap meld
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_persistent_api_meld_with_empty);
+    RUN_TEST(check_min_heap_persistent_api_meld_data);
+    RUN_TEST(check_min_heap_persistent_api_rank);
+
+    /*! @} */
+
+    UNITY_END();
+}
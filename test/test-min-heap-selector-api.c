@@ -0,0 +1,180 @@
+/*!
+ * \file test-min-heap-selector-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Tests of the selector of the least loaded worker
+ */
+
+#include "unity.h"
+#include "min-heap-selector-api.h"
+
+MinHeapSelectorHandler_t selector;
+ArenaAllocatorHandler_t arena;
+
+void setUp(void) {
+    arena_allocator_api_init(&arena);
+    min_heap_selector_api_init(&selector, 4, &arena);
+}
+
+void tearDown(void) {
+    arena_allocator_api_free(&arena);
+}
+
+/*!
+ * \defgroup min_heap_selector_api_init Test selector initialization
+ * @{
+ */
+
+void check_min_heap_selector_api_init_with_null_pointers(void) {
+    MinHeapSelectorHandler_t s;
+    size_t worker;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_selector_api_init(NULL, 4, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_selector_api_init(&s, 4, NULL));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_selector_api_acquire(NULL, 1, &worker));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_selector_api_acquire(&selector, 1, NULL));
+
+    // A selector that was never initialized has no buffer
+    MinHeapSelectorHandler_t uninitialized = { 0 };
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_selector_api_acquire(&uninitialized, 1, &worker));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_selector_api_release(NULL, 0, 1));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_selector_api_load(&selector, 0, NULL));
+}
+void check_min_heap_selector_api_init_out_of_bounds(void) {
+    MinHeapSelectorHandler_t s;
+    uint64_t load;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_selector_api_init(&s, 0, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_selector_api_load(&selector, 4, &load));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_selector_api_release(&selector, 4, 0));
+}
+void check_min_heap_selector_api_acquire_empty(void) {
+    size_t worker;
+    selector.heap.size = 0;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_EMPTY, min_heap_selector_api_acquire(&selector, 1, &worker));
+}
+void check_min_heap_selector_api_init_unloaded(void) {
+    for (size_t i = 0; i < 4; ++i) {
+        uint64_t load = 1;
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_selector_api_load(&selector, i, &load));
+        TEST_ASSERT_EQUAL_UINT64(0U, load);
+    }
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_selector_api_acquire Test selector acquisition and release
+ * @{
+ */
+
+void check_min_heap_selector_api_acquire_round_robin(void) {
+    // With equal loads the workers are selected in order
+    for (size_t i = 0; i < 12; ++i) {
+        size_t worker;
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_selector_api_acquire(&selector, 1, &worker));
+        TEST_ASSERT_EQUAL_size_t(i % 4, worker);
+    }
+    uint64_t load;
+    min_heap_selector_api_load(&selector, 2, &load);
+    TEST_ASSERT_EQUAL_UINT64(3U, load);
+}
+void check_min_heap_selector_api_acquire_weighted(void) {
+    size_t worker;
+    min_heap_selector_api_acquire(&selector, 10, &worker);
+    TEST_ASSERT_EQUAL_size_t(0U, worker);
+    // Worker 0 is skipped until the others reach its load
+    for (size_t i = 0; i < 12; ++i) {
+        min_heap_selector_api_acquire(&selector, 3, &worker);
+        TEST_ASSERT_NOT_EQUAL(0, worker);
+    }
+    min_heap_selector_api_acquire(&selector, 3, &worker);
+    TEST_ASSERT_EQUAL_size_t(0U, worker);
+}
+void check_min_heap_selector_api_acquire_overflow(void) {
+    size_t worker;
+    MinHeapSelectorHandler_t s;
+    min_heap_selector_api_init(&s, 1, &arena);
+    ((uint64_t *)s.heap.data)[0] = UINT64_MAX - 1;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_FULL, min_heap_selector_api_acquire(&s, 2, &worker));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_selector_api_acquire(&s, 1, &worker));
+}
+void check_min_heap_selector_api_release(void) {
+    size_t worker;
+    for (size_t i = 0; i < 8; ++i)
+        min_heap_selector_api_acquire(&selector, 1, &worker);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_selector_api_release(&selector, 3, 3));
+    // The released worker is the next one selected
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_selector_api_release(&selector, 3, 2));
+    min_heap_selector_api_acquire(&selector, 1, &worker);
+    TEST_ASSERT_EQUAL_size_t(3U, worker);
+    min_heap_selector_api_acquire(&selector, 1, &worker);
+    TEST_ASSERT_EQUAL_size_t(3U, worker);
+}
+void check_min_heap_selector_api_random_model(void) {
+    // The selected worker always has the minimum load
+    MinHeapSelectorHandler_t s;
+    uint64_t loads[37] = { 0 };
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_selector_api_init(&s, 37, &arena));
+    unsigned seed = 3;
+    for (int i = 0; i < 20000; ++i) {
+        seed = seed * 1103515245U + 12345U;
+        uint32_t amount = 1 + (seed >> 24) % 8;
+        size_t w = (seed >> 16) % 37;
+        if ((seed & 0x300) != 0) {
+            size_t worker;
+            uint64_t min = UINT64_MAX;
+            size_t expected = 0;
+            for (size_t j = 0; j < 37; ++j) {
+                if (loads[j] < min) {
+                    min = loads[j];
+                    expected = j;
+                }
+            }
+            TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_selector_api_acquire(&s, amount, &worker));
+            TEST_ASSERT_EQUAL_size_t(expected, worker);
+            loads[worker] += amount;
+        } else if (loads[w] >= amount) {
+            TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_selector_api_release(&s, w, amount));
+            loads[w] -= amount;
+        }
+    }
+    for (size_t j = 0; j < 37; ++j) {
+        uint64_t load;
+        min_heap_selector_api_load(&s, j, &load);
+        TEST_ASSERT_EQUAL_UINT64(loads[j], load);
+    }
+}
+
+/*! @} */
+
+int main() {
+    UNITY_BEGIN();
+
+    /*!
+     * \addtogroup min_heap_selector_api_init Run test for selector initialization
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_selector_api_init_with_null_pointers);
+    RUN_TEST(check_min_heap_selector_api_init_out_of_bounds);
+    RUN_TEST(check_min_heap_selector_api_acquire_empty);
+    RUN_TEST(check_min_heap_selector_api_init_unloaded);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_selector_api_acquire Run test for selector acquisition and release
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_selector_api_acquire_round_robin);
+    RUN_TEST(check_min_heap_selector_api_acquire_weighted);
+    RUN_TEST(check_min_heap_selector_api_acquire_overflow);
+    RUN_TEST(check_min_heap_selector_api_release);
+    RUN_TEST(check_min_heap_selector_api_random_model);
+
+    /*! @} */
+
+    UNITY_END();
+}
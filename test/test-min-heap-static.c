@@ -0,0 +1,114 @@
+/*!
+ * \file test-min-heap-static.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Tests of the static heap generated by tools/min-heap-gen.py from
+ *      examples/min-heap-static.json
+ *
+ * \details The heap has to be generated before the build, see
+ *      tools/test-min-heap-gen.sh
+ */
+
+#include <stddef.h>
+
+#include "unity.h"
+#include "min-heap-api.h"
+#include "periodic-tasks.h"
+#include "tasks.h"
+
+void task_can_send(void) {}
+void task_read_sensors(void) {}
+void task_watchdog(void) {}
+void task_telemetry(void) {}
+
+/*!
+ * \brief Compare function named in the JSON file, deadline ascending then priority descending
+ */
+int8_t task_compare(void *a, void *b) {
+    const Task *f = a;
+    const Task *s = b;
+    if (f->deadline != s->deadline)
+        return f->deadline < s->deadline ? -1 : 1;
+    if (f->priority != s->priority)
+        return f->priority > s->priority ? -1 : 1;
+    return 0;
+}
+
+/*! \brief Key specification of the JSON file */
+static const MinHeapKeyField_t task_keys[] = {
+    { offsetof(Task, deadline), MIN_HEAP_KEY_U32, MIN_HEAP_KEY_ASC },
+    { offsetof(Task, priority), MIN_HEAP_KEY_U8, MIN_HEAP_KEY_DESC },
+};
+
+ArenaAllocatorHandler_t arena;
+MinHeapHandler_t keyed;
+
+void setUp(void) {
+    arena_allocator_api_init(&arena);
+    min_heap_api_init_keys(&keyed, sizeof(Task), 4, task_keys, 2, &arena);
+}
+
+void tearDown(void) {
+    arena_allocator_api_free(&arena);
+}
+
+/*!
+ * \defgroup min_heap_static Test the generated static heap
+ * @{
+ */
+
+void check_min_heap_static_handler(void) {
+    TEST_ASSERT_EQUAL_size_t(sizeof(Task), periodic_tasks.data_size);
+    TEST_ASSERT_EQUAL_size_t(4U, periodic_tasks.size);
+    TEST_ASSERT_EQUAL_size_t(16U, periodic_tasks.capacity);
+    TEST_ASSERT_NOT_NULL(periodic_tasks.data);
+}
+void check_min_heap_static_heap_property(void) {
+    // Every parent comes first both with the compare function and with the key specification
+    Task *items = periodic_tasks.data;
+    for (size_t i = 1; i < periodic_tasks.size; ++i) {
+        Task *parent = &items[(i - 1) / 2];
+        TEST_ASSERT_TRUE(min_heap_api_compare(&periodic_tasks, parent, &items[i]) <= 0);
+        TEST_ASSERT_TRUE(min_heap_api_compare(&keyed, parent, &items[i]) <= 0);
+        TEST_ASSERT_EQUAL_INT(min_heap_api_compare(&keyed, parent, &items[i]), min_heap_api_compare(&periodic_tasks, parent, &items[i]));
+    }
+}
+void check_min_heap_static_pop_order(void) {
+    void (*const expected[])(void) = { task_watchdog, task_read_sensors, task_telemetry, task_can_send };
+    Task prev;
+    for (size_t i = 0; i < 4; ++i) {
+        Task task;
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_remove(&periodic_tasks, 0, &task));
+        TEST_ASSERT_TRUE(task.callback == expected[i]);
+        if (i > 0)
+            TEST_ASSERT_TRUE(min_heap_api_compare(&keyed, &prev, &task) <= 0);
+        prev = task;
+    }
+    TEST_ASSERT_TRUE(min_heap_api_is_empty(&periodic_tasks));
+
+    // The generated heap keeps working as a normal one
+    Task late = { 5, 0, task_can_send };
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_api_insert(&periodic_tasks, &late));
+    TEST_ASSERT_EQUAL_size_t(1U, periodic_tasks.size);
+}
+
+/*! @} */
+
+int main() {
+    UNITY_BEGIN();
+
+    /*!
+     * \addtogroup min_heap_static Run test for the generated static heap
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_static_handler);
+    RUN_TEST(check_min_heap_static_heap_property);
+    RUN_TEST(check_min_heap_static_pop_order);
+
+    /*! @} */
+
+    return UNITY_END();
+}
@@ -0,0 +1,203 @@
+/*!
+ * \file test-min-heap-timer-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Tests of the timer heap with compact keys relative to an epoch
+ */
+
+#include <string.h>
+
+#include "unity.h"
+#include "min-heap-api.h"
+#include "min-heap-timer-api.h"
+
+MinHeapTimerHandler_t timer;
+ArenaAllocatorHandler_t arena;
+
+void setUp(void) {
+    arena_allocator_api_init(&arena);
+    min_heap_timer_api_init(&timer, MIN_HEAP_KEY_U16, sizeof(int), 16, 1000, &arena);
+}
+
+void tearDown(void) {
+    arena_allocator_api_free(&arena);
+}
+
+/*!
+ * \defgroup min_heap_timer_api_init Test timer heap initialization
+ * @{
+ */
+
+void check_min_heap_timer_api_init_with_null_pointers(void) {
+    MinHeapTimerHandler_t t;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_timer_api_init(NULL, MIN_HEAP_KEY_U32, 0, 8, 0, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_timer_api_init(&t, MIN_HEAP_KEY_U32, 0, 8, 0, NULL));
+}
+void check_min_heap_timer_api_init_with_invalid_key(void) {
+    MinHeapTimerHandler_t t;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_timer_api_init(&t, MIN_HEAP_KEY_U64, 0, 8, 0, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_timer_api_init(&t, MIN_HEAP_KEY_I32, 0, 8, 0, &arena));
+}
+void check_min_heap_timer_api_init_slot_size(void) {
+    MinHeapTimerHandler_t t;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_timer_api_init(&t, MIN_HEAP_KEY_U32, 0, 8, 0, &arena));
+    TEST_ASSERT_EQUAL_size_t(4U, t.heap.data_size);
+    TEST_ASSERT_EQUAL_size_t(2U + sizeof(int), timer.heap.data_size);
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_timer_api_size(&timer));
+    TEST_ASSERT_NULL(min_heap_timer_api_peek(&timer, NULL));
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_timer_api_insert Test timer heap insertion and removal
+ * @{
+ */
+
+void check_min_heap_timer_api_insert_out_of_range(void) {
+    int id = 0;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_timer_api_insert(&timer, 999, &id));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_timer_api_insert(&timer, 1000 + UINT16_MAX + 1, &id));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_timer_api_insert(&timer, 1000 + UINT16_MAX, &id));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_timer_api_insert(&timer, 1000, NULL));
+}
+void check_min_heap_timer_api_pop_in_order(void) {
+    uint64_t deadlines[6] = { 1500, 1000, 40000, 1200, 1001, 66535 };
+    for (int i = 0; i < 6; ++i)
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_timer_api_insert(&timer, deadlines[i], &i));
+
+    uint64_t deadline;
+    int top;
+    memcpy(&top, min_heap_timer_api_peek(&timer, &deadline), sizeof(top));
+    TEST_ASSERT_EQUAL_INT(1, top);
+    TEST_ASSERT_EQUAL_UINT64(1000U, deadline);
+
+    uint64_t expected[6] = { 1000, 1001, 1200, 1500, 40000, 66535 };
+    int ids[6] = { 1, 4, 3, 0, 2, 5 };
+    for (int i = 0; i < 6; ++i) {
+        int id;
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_timer_api_pop(&timer, &deadline, &id));
+        TEST_ASSERT_EQUAL_UINT64(expected[i], deadline);
+        TEST_ASSERT_EQUAL_INT(ids[i], id);
+    }
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_EMPTY, min_heap_timer_api_pop(&timer, NULL, NULL));
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_timer_api_rebase Test timer heap epoch rebase
+ * @{
+ */
+
+void check_min_heap_timer_api_rebase_forward(void) {
+    uint64_t deadlines[5] = { 5000, 3000, 9000, 3000, 60000 };
+    for (int i = 0; i < 5; ++i)
+        min_heap_timer_api_insert(&timer, deadlines[i], &i);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_timer_api_rebase(&timer, 3001));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_timer_api_rebase(&timer, 3000));
+    TEST_ASSERT_EQUAL_UINT64(3000U, timer.epoch);
+
+    // Deadlines further than the old range fit after the rebase
+    int id = 9;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_timer_api_insert(&timer, 3000 + UINT16_MAX, &id));
+    uint64_t expected[6] = { 3000, 3000, 5000, 9000, 60000, 3000 + UINT16_MAX };
+    for (int i = 0; i < 6; ++i) {
+        uint64_t deadline;
+        min_heap_timer_api_pop(&timer, &deadline, NULL);
+        TEST_ASSERT_EQUAL_UINT64(expected[i], deadline);
+    }
+}
+void check_min_heap_timer_api_rebase_backward(void) {
+    int id = 0;
+    min_heap_timer_api_insert(&timer, 1100, &id);
+    min_heap_timer_api_insert(&timer, 1000 + UINT16_MAX - 10, &id);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_timer_api_rebase(&timer, 989));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_timer_api_rebase(&timer, 990));
+    uint64_t deadline;
+    min_heap_timer_api_peek(&timer, &deadline);
+    TEST_ASSERT_EQUAL_UINT64(1100U, deadline);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_timer_api_insert(&timer, 990, &id));
+}
+void check_min_heap_timer_api_rebase_empty(void) {
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_timer_api_rebase(&timer, 0));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_timer_api_rebase(&timer, UINT64_MAX - UINT16_MAX));
+    int id = 0;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_timer_api_insert(&timer, UINT64_MAX, &id));
+}
+void check_min_heap_timer_api_rebase_keeps_order(void) {
+    // Random deadlines with periodic rebases compared with a 64 bit heap
+    MinHeapHandler_t reference;
+    MinHeapKeyField_t key = { 0, MIN_HEAP_KEY_U64, MIN_HEAP_KEY_ASC };
+    MinHeapTimerHandler_t t;
+    min_heap_api_init_keys(&reference, sizeof(uint64_t), 256, &key, 1, &arena);
+    min_heap_timer_api_init(&t, MIN_HEAP_KEY_U32, 0, 256, 0, &arena);
+    uint64_t now = 0;
+    unsigned seed = 3;
+    for (int i = 0; i < 5000; ++i) {
+        seed = seed * 1103515245U + 12345U;
+        if ((seed & 0x100) != 0 && reference.size < 256) {
+            uint64_t deadline = now + (seed >> 12) % 100000;
+            TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_timer_api_insert(&t, deadline, NULL));
+            min_heap_api_insert(&reference, &deadline);
+        } else if (reference.size > 0) {
+            uint64_t expected, deadline;
+            min_heap_api_remove(&reference, 0, &expected);
+            TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_timer_api_pop(&t, &deadline, NULL));
+            TEST_ASSERT_EQUAL_UINT64(expected, deadline);
+            now = deadline;
+            TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_timer_api_rebase(&t, now));
+        }
+    }
+}
+void check_min_heap_timer_api_rebase_during_transaction(void) {
+    MinHeapTimerHandler_t t;
+    min_heap_timer_api_init(&t, MIN_HEAP_KEY_U32, 0, 8, 0, &arena);
+    min_heap_api_txn_init(&t.heap, &arena);
+    min_heap_api_txn_begin(&t.heap);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_INVALID_STATE, min_heap_timer_api_rebase(&t, 10));
+}
+
+/*! @} */
+
+int main() {
+    UNITY_BEGIN();
+
+    /*!
+     * \addtogroup min_heap_timer_api_init Run test for timer heap initialization
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_timer_api_init_with_null_pointers);
+    RUN_TEST(check_min_heap_timer_api_init_with_invalid_key);
+    RUN_TEST(check_min_heap_timer_api_init_slot_size);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_timer_api_insert Run test for timer heap insertion and removal
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_timer_api_insert_out_of_range);
+    RUN_TEST(check_min_heap_timer_api_pop_in_order);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_timer_api_rebase Run test for timer heap epoch rebase
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_timer_api_rebase_forward);
+    RUN_TEST(check_min_heap_timer_api_rebase_backward);
+    RUN_TEST(check_min_heap_timer_api_rebase_empty);
+    RUN_TEST(check_min_heap_timer_api_rebase_keeps_order);
+    RUN_TEST(check_min_heap_timer_api_rebase_during_transaction);
+
+    /*! @} */
+
+    UNITY_END();
+}
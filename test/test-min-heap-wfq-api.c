@@ -0,0 +1,218 @@
+/*!
+ * \file test-min-heap-wfq-api.c
+ * \date 2025-03-28
+ * \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+ * \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+ *
+ * \brief Tests of the weighted fair queuing packet scheduler
+ */
+
+#include "unity.h"
+#include "min-heap-wfq-api.h"
+
+MinHeapWfqHandler_t wfq;
+MinHeapWfqHandler_t wf2q;
+ArenaAllocatorHandler_t arena;
+
+void setUp(void) {
+    arena_allocator_api_init(&arena);
+    min_heap_wfq_api_init(&wfq, MIN_HEAP_WFQ_MODE_WFQ, 4, 64, sizeof(int), &arena);
+    min_heap_wfq_api_init(&wf2q, MIN_HEAP_WFQ_MODE_WF2Q, 4, 64, sizeof(int), &arena);
+}
+
+void tearDown(void) {
+    arena_allocator_api_free(&arena);
+}
+
+/*!
+ * \brief Send packets of the same length until the scheduler is empty and
+ *      count the packets of each flow among the first 'limit' ones
+ */
+static void drain_count(MinHeapWfqHandler_t *sched, size_t limit, size_t *counts) {
+    size_t sent = 0;
+    size_t flow;
+    while (min_heap_wfq_api_dequeue(sched, &flow, NULL, NULL) == MIN_HEAP_OK) {
+        if (sent++ < limit)
+            ++counts[flow];
+    }
+}
+
+/*!
+ * \defgroup min_heap_wfq_api_init Test scheduler initialization
+ * @{
+ */
+
+void check_min_heap_wfq_api_init_with_null_pointers(void) {
+    MinHeapWfqHandler_t w;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_wfq_api_init(NULL, MIN_HEAP_WFQ_MODE_WFQ, 4, 8, 0, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_wfq_api_init(&w, MIN_HEAP_WFQ_MODE_WFQ, 4, 8, 0, NULL));
+}
+void check_min_heap_wfq_api_init_out_of_bounds(void) {
+    MinHeapWfqHandler_t w;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_wfq_api_init(&w, MIN_HEAP_WFQ_MODE_WFQ, 0, 8, 0, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_wfq_api_init(&w, MIN_HEAP_WFQ_MODE_WFQ, 4, 0, 0, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_wfq_api_init(&w, (MinHeapWfqMode)7, 4, 8, 0, &arena));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_wfq_api_set_weight(&wfq, 4, 1));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_wfq_api_set_weight(&wfq, 0, 0));
+}
+void check_min_heap_wfq_api_init_empty(void) {
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_wfq_api_size(&wfq));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_EMPTY, min_heap_wfq_api_dequeue(&wfq, NULL, NULL, NULL));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_EMPTY, min_heap_wfq_api_dequeue(&wf2q, NULL, NULL, NULL));
+}
+
+/*! @} */
+
+/*!
+ * \defgroup min_heap_wfq_api_dequeue Test scheduler enqueue and dequeue
+ * @{
+ */
+
+void check_min_heap_wfq_api_flow_fifo(void) {
+    for (int i = 0; i < 5; ++i)
+        min_heap_wfq_api_enqueue(&wfq, 2, 100 + i, &i);
+    for (int i = 0; i < 5; ++i) {
+        size_t flow;
+        uint32_t length;
+        int id;
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_wfq_api_dequeue(&wfq, &flow, &length, &id));
+        TEST_ASSERT_EQUAL_size_t(2U, flow);
+        TEST_ASSERT_EQUAL_UINT32(100 + i, length);
+        TEST_ASSERT_EQUAL_INT(i, id);
+    }
+    TEST_ASSERT_EQUAL_size_t(0U, min_heap_wfq_api_size(&wfq));
+}
+void check_min_heap_wfq_api_enqueue_errors(void) {
+    int id = 0;
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OUT_OF_BOUNDS, min_heap_wfq_api_enqueue(&wfq, 4, 10, &id));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_NULL_POINTER, min_heap_wfq_api_enqueue(&wfq, 0, 10, NULL));
+    for (int i = 0; i < 64; ++i)
+        TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_wfq_api_enqueue(&wfq, (size_t)i % 4, 10, &id));
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_FULL, min_heap_wfq_api_enqueue(&wfq, 0, 10, &id));
+
+    // The slots are reused after a dequeue
+    min_heap_wfq_api_dequeue(&wfq, NULL, NULL, NULL);
+    TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_wfq_api_enqueue(&wfq, 0, 10, &id));
+}
+void check_min_heap_wfq_api_weighted_share(void) {
+    // Backlogged flows share the link proportionally to their weights
+    MinHeapWfqHandler_t *scheds[2] = { &wfq, &wf2q };
+    for (size_t s = 0; s < 2; ++s) {
+        int id = 0;
+        size_t counts[4] = { 0 };
+        min_heap_wfq_api_set_weight(scheds[s], 0, 1);
+        min_heap_wfq_api_set_weight(scheds[s], 1, 3);
+        for (int i = 0; i < 32; ++i) {
+            min_heap_wfq_api_enqueue(scheds[s], 0, 500, &id);
+            min_heap_wfq_api_enqueue(scheds[s], 1, 500, &id);
+        }
+        drain_count(scheds[s], 32, counts);
+        TEST_ASSERT_TRUE(counts[0] >= 7 && counts[0] <= 9);
+        TEST_ASSERT_TRUE(counts[1] >= 23 && counts[1] <= 25);
+    }
+}
+void check_min_heap_wfq_api_length_share(void) {
+    // With equal weights a flow of short packets sends more of them
+    int id = 0;
+    size_t counts[4] = { 0 };
+    for (int i = 0; i < 30; ++i)
+        min_heap_wfq_api_enqueue(&wfq, 0, 1000, &id);
+    for (int i = 0; i < 34; ++i)
+        min_heap_wfq_api_enqueue(&wfq, 1, 250, &id);
+    drain_count(&wfq, 20, counts);
+    TEST_ASSERT_TRUE(counts[0] >= 3 && counts[0] <= 5);
+    TEST_ASSERT_TRUE(counts[1] >= 15 && counts[1] <= 17);
+}
+void check_min_heap_wfq_api_idle_flow_no_credit(void) {
+    // A flow that was idle does not get a burst for the time it did not use
+    int id = 0;
+    size_t counts[4] = { 0 };
+    for (int i = 0; i < 20; ++i)
+        min_heap_wfq_api_enqueue(&wfq, 0, 100, &id);
+    for (int i = 0; i < 10; ++i)
+        min_heap_wfq_api_dequeue(&wfq, NULL, NULL, NULL);
+    for (int i = 0; i < 10; ++i)
+        min_heap_wfq_api_enqueue(&wfq, 1, 100, &id);
+    drain_count(&wfq, 10, counts);
+    TEST_ASSERT_TRUE(counts[0] >= 4 && counts[0] <= 6);
+}
+void check_min_heap_wfq_api_wf2q_smooth(void) {
+    // WF2Q does not let a heavy flow send all its packets in a burst
+    int id = 0;
+    min_heap_wfq_api_set_weight(&wf2q, 0, 10);
+    for (int i = 0; i < 10; ++i)
+        min_heap_wfq_api_enqueue(&wf2q, 0, 100, &id);
+    for (int i = 0; i < 10; ++i)
+        min_heap_wfq_api_enqueue(&wf2q, 1 + (size_t)i % 3, 100, &id);
+
+    // Flows 1-3 have weight 1 each: at most about 10 / 13 of the packets come from flow 0
+    size_t run = 0, longest = 0, flow;
+    while (min_heap_wfq_api_dequeue(&wf2q, &flow, NULL, NULL) == MIN_HEAP_OK) {
+        run = flow == 0 ? run + 1 : 0;
+        longest = run > longest ? run : longest;
+        if (min_heap_wfq_api_size(&wf2q) == 10)
+            break;
+    }
+    TEST_ASSERT_TRUE(longest <= 5);
+}
+void check_min_heap_wfq_api_random_conservation(void) {
+    // Every packet is sent once and in order within its flow
+    MinHeapWfqHandler_t *scheds[2] = { &wfq, &wf2q };
+    for (size_t s = 0; s < 2; ++s) {
+        int next_in[4] = { 0 }, next_out[4] = { 0 };
+        unsigned seed = 9;
+        for (size_t f = 0; f < 4; ++f)
+            min_heap_wfq_api_set_weight(scheds[s], f, (uint32_t)f + 1);
+        for (int i = 0; i < 4000; ++i) {
+            seed = seed * 1103515245U + 12345U;
+            size_t f = (seed >> 16) % 4;
+            if ((seed & 0x100) != 0 && min_heap_wfq_api_size(scheds[s]) < 64) {
+                int id = next_in[f]++;
+                TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_wfq_api_enqueue(scheds[s], f, 40 + (seed >> 20) % 1460, &id));
+            } else if (min_heap_wfq_api_size(scheds[s]) > 0) {
+                size_t flow;
+                int id;
+                TEST_ASSERT_EQUAL_INT(MIN_HEAP_OK, min_heap_wfq_api_dequeue(scheds[s], &flow, NULL, &id));
+                TEST_ASSERT_EQUAL_INT(next_out[flow]++, id);
+            }
+        }
+        while (min_heap_wfq_api_dequeue(scheds[s], NULL, NULL, NULL) == MIN_HEAP_OK)
+            ;
+        TEST_ASSERT_EQUAL_UINT64(0U, scheds[s]->active_weight);
+        TEST_ASSERT_EQUAL_size_t(0U, scheds[s]->eligible.size + scheds[s]->pending.size);
+    }
+}
+
+/*! @} */
+
+int main() {
+    UNITY_BEGIN();
+
+    /*!
+     * \addtogroup min_heap_wfq_api_init Run test for scheduler initialization
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_wfq_api_init_with_null_pointers);
+    RUN_TEST(check_min_heap_wfq_api_init_out_of_bounds);
+    RUN_TEST(check_min_heap_wfq_api_init_empty);
+
+    /*! @} */
+
+    /*!
+     * \addtogroup min_heap_wfq_api_dequeue Run test for scheduler enqueue and dequeue
+     * @{
+     */
+
+    RUN_TEST(check_min_heap_wfq_api_flow_fifo);
+    RUN_TEST(check_min_heap_wfq_api_enqueue_errors);
+    RUN_TEST(check_min_heap_wfq_api_weighted_share);
+    RUN_TEST(check_min_heap_wfq_api_length_share);
+    RUN_TEST(check_min_heap_wfq_api_idle_flow_no_credit);
+    RUN_TEST(check_min_heap_wfq_api_wf2q_smooth);
+    RUN_TEST(check_min_heap_wfq_api_random_conservation);
+
+    /*! @} */
+
+    UNITY_END();
+}
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""
+\\file min-heap-gen.py
+\\date 2025-03-28
+\\authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+\\authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+
+\\brief Generate a C source file with a min heap that is already initialized
+    with a static set of items
+
+\\details The items are sorted at build time according to the key specification
+    (a sorted array is always a valid min heap) and emitted as a static buffer
+    together with a MinHeapHandler_t initializer, so that no insertion is
+    needed at startup.
+    The key specification must order the items exactly like the compare
+    function of the heap.
+
+    The input is a JSON file with the following fields:
+    - name: name of the generated MinHeapHandler_t variable
+    - type: C type of the items (e.g. "int" or "Task")
+    - capacity: capacity of the heap (defaults to the number of items)
+    - compare: name of the compare function
+    - includes: list of headers to include (e.g. the one that defines the type)
+    - key: list of {"field": name, "order": "asc" | "desc"}, for scalar types
+      it can be omitted or contain a single entry without field
+    - items: list of items, numbers for scalar types or objects whose fields
+      are emitted as designated initializers (strings are copied verbatim)
+
+    Usage: min-heap-gen.py spec.json -o heap.c [--header heap.h]
+"""
+
+import argparse
+import functools
+import json
+import os
+import re
+import sys
+
+C_IDENTIFIER = re.compile(r"^[A-Za-z_][A-Za-z0-9_]*$")
+
+
+def fail(msg):
+    print(f"[ERROR]: {msg}", file=sys.stderr)
+    sys.exit(1)
+
+
+def key_of(item, key):
+    """Return the tuple of values used to order an item"""
+    values = []
+    for k in key:
+        field = k.get("field")
+        if field is None:
+            value = item
+        elif isinstance(item, dict) and field in item:
+            value = item[field]
+        else:
+            fail(f"item {item} has no key field '{field}'")
+        if not isinstance(value, (int, float)):
+            fail(f"key field '{field}' of item {item} is not a number")
+        values.append(value)
+    return values
+
+
+def compare(key, a, b):
+    for k, va, vb in zip(key, key_of(a, key), key_of(b, key)):
+        sign = -1 if k.get("order", "asc") == "desc" else 1
+        if va != vb:
+            return sign * (-1 if va < vb else 1)
+    return 0
+
+
+def c_value(value):
+    if isinstance(value, bool):
+        return "true" if value else "false"
+    if isinstance(value, (int, float)):
+        return repr(value)
+    if isinstance(value, str):
+        return value
+    if isinstance(value, dict):
+        return c_item(value)
+    if isinstance(value, list):
+        return "{ " + ", ".join(c_value(v) for v in value) + " }"
+    fail(f"unsupported value {value!r}")
+
+
+def c_item(item):
+    if not isinstance(item, dict):
+        return c_value(item)
+    for field in item:
+        if not C_IDENTIFIER.match(field):
+            fail(f"invalid field name '{field}'")
+    return "{ " + ", ".join(f".{f} = {c_value(v)}" for f, v in item.items()) + " }"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate a pre-heapified static min heap")
+    parser.add_argument("spec", help="JSON specification of the heap")
+    parser.add_argument("-o", "--output", required=True, help="generated C source file")
+    parser.add_argument("--header", help="generated C header with the extern declaration")
+    args = parser.parse_args()
+
+    try:
+        with open(args.spec) as f:
+            spec = json.load(f)
+    except (OSError, ValueError) as e:
+        fail(f"cannot load {args.spec}: {e}")
+
+    for field in ("name", "type", "compare", "items"):
+        if field not in spec:
+            fail(f"missing field '{field}'")
+    name, ctype, cmp = spec["name"], spec["type"], spec["compare"]
+    if not C_IDENTIFIER.match(name) or not C_IDENTIFIER.match(cmp):
+        fail("name and compare must be valid C identifiers")
+    items = spec["items"]
+    capacity = spec.get("capacity", len(items))
+    if capacity < len(items) or capacity == 0:
+        fail(f"capacity {capacity} is lower than the number of items {len(items)} or zero")
+    key = spec.get("key") or [{}]
+    for k in key:
+        if k.get("order", "asc") not in ("asc", "desc"):
+            fail(f"invalid order '{k.get('order')}'")
+
+    # A sorted array satisfies the heap property, sorted() is stable so equal
+    # items keep the order of the table
+    heap = sorted(items, key=functools.cmp_to_key(lambda a, b: compare(key, a, b)))
+
+    includes = ["min-heap.h"] + spec.get("includes", [])
+    header_guard = re.sub(r"[^A-Za-z0-9]", "_", os.path.basename(args.header or "")).upper()
+    lines = [
+        "/*!",
+        f" * \\file {os.path.basename(args.output)}",
+        f" * \\brief Min heap '{name}' generated by min-heap-gen.py from {os.path.basename(args.spec)}",
+        " * \\warning Do not edit, this file is generated automatically",
+        " */",
+        "",
+    ]
+    lines += [f'#include "{inc}"' for inc in includes]
+    lines += [
+        "",
+        f"int8_t {cmp}(void *, void *);",
+        "",
+        f"static {ctype} {name}_data[{capacity}] = {{",
+    ]
+    lines += [f"    {c_item(item)}," for item in heap]
+    lines += [
+        "};",
+        "",
+        f"MinHeapHandler_t {name} = {{",
+        f"    .data_size = sizeof({ctype}),",
+        f"    .size = {len(heap)},",
+        f"    .capacity = {capacity},",
+        f"    .compare = {cmp},",
+        f"    .data = {name}_data",
+        "};",
+        "",
+    ]
+    with open(args.output, "w") as f:
+        f.write("\n".join(lines))
+
+    if args.header:
+        with open(args.header, "w") as f:
+            f.write("\n".join([
+                "/*!",
+                f" * \\file {os.path.basename(args.header)}",
+                f" * \\brief Min heap '{name}' generated by min-heap-gen.py from {os.path.basename(args.spec)}",
+                " * \\warning Do not edit, this file is generated automatically",
+                " */",
+                "",
+                f"#ifndef {header_guard}",
+                f"#define {header_guard}",
+                "",
+                '#include "min-heap.h"',
+                "",
+                f"extern MinHeapHandler_t {name};",
+                "",
+                "#endif",
+                "",
+            ]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,34 @@
+#!/bin/sh
+#
+# \file test-min-heap-gen.sh
+# \date 2025-03-28
+# \authors Antonio Gelain [antonio.gelain@studenti.unitn.it]
+# \authors Dorijan Di Zepp [dorijan.dizepp@eagletrt.it]
+#
+# \brief Generate the static heap of examples/min-heap-static.json, build it
+#     with test/test-min-heap-static.c and the library and run the test
+#
+# \details The extra arguments are passed to the compiler and have to provide
+#     Unity and the arena allocator (include paths and sources), e.g.
+#
+#     tools/test-min-heap-gen.sh -I<unity>/src <unity>/src/unity.c \
+#         -I<arena-allocator>/include <arena-allocator>/src/*.c
+#
+#     The compiler can be changed with the CC environment variable.
+
+set -eu
+
+root=$(cd "$(dirname "$0")/.." && pwd)
+out=$(mktemp -d)
+trap 'rm -rf "$out"' EXIT
+
+python3 "$root/tools/min-heap-gen.py" "$root/examples/min-heap-static.json" \
+    -o "$out/periodic-tasks.c" --header "$out/periodic-tasks.h"
+
+${CC:-cc} -std=c11 -Wall -Wextra \
+    -I"$root/include" -I"$root/test/static" -I"$out" \
+    "$@" \
+    "$root/test/test-min-heap-static.c" "$out/periodic-tasks.c" "$root"/src/*.c \
+    -lm -o "$out/test-min-heap-static"
+
+"$out/test-min-heap-static"